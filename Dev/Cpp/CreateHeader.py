@@ -32,6 +32,7 @@ class CreateHeader:
 
 effekseerHeader = CreateHeader()
 effekseerHeader.readLines('Effekseer/Effekseer/Effekseer.Base.Pre.h')
+effekseerHeader.readLines('Effekseer/Effekseer/Utils/Effekseer.Hash.h')
 effekseerHeader.readLines('Effekseer/Effekseer/Utils/Effekseer.CustomAllocator.h')
 effekseerHeader.readLines('Effekseer/Effekseer/Effekseer.Vector2D.h')
 effekseerHeader.readLines('Effekseer/Effekseer/Effekseer.Vector3D.h')
@@ -102,6 +102,9 @@ public:
 
 		bool EnableViewOffset = false;
 
+		//! all corners of a sprite have the same color and positions of corners form an axis aligned rectangle
+		bool IsRectangleWithUniformColor = false;
+
 		RefPtr<RenderingUserData> UserData;
 	};
 
@@ -812,6 +815,16 @@ public:
 	virtual void Unload(TextureRef data)
 	{
 	}
+
+	/**
+		@brief
+		\~English	Get whether Load with data can be called from multiple threads at the same time. If it is true, EffectBatchLoader calls it on worker threads.
+		\~Japanese	データを引数とするLoadを複数のスレッドから同時に呼べるかどうかを取得する。trueの場合、EffectBatchLoaderはワーカースレッドで呼ぶ。
+	*/
+	virtual bool GetIsThreadSafe() const
+	{
+		return false;
+	}
 };
 
 class TextureLoaderHelper
@@ -835,6 +848,7 @@ public:
 #ifndef __EFFEKSEER_MODEL_H__
 #define __EFFEKSEER_MODEL_H__
 
+#include <mutex>
 
 namespace Effekseer
 {
@@ -881,20 +895,53 @@ public:
 	};
 
 protected:
-	struct InternalModel
+	struct InternalVertexes
 	{
 		CustomVector<Vertex> vertexes;
-		CustomVector<Face> faces;
 		RefPtr<Backend::VertexBuffer> vertexBuffer;
+	};
+
+	struct InternalFaces
+	{
+		CustomVector<Face> faces;
 		RefPtr<Backend::IndexBuffer> indexBuffer;
 		RefPtr<Backend::IndexBuffer> wireIndexBuffer;
 	};
 
+	//! a structure to sample points on faces in proportion to their areas with an alias table
+	struct InternalSampler
+	{
+		//! attributes of vertices of faces which are packed to avoid indirect accesses
+		CustomVector<std::array<Emitter, 3>> triangles;
+		CustomVector<float> probabilities;
+		CustomVector<int32_t> aliases;
+	};
+
+	//! a frame refers vertexes and faces which are shared with other frames if they are same
+	struct InternalModel
+	{
+		int32_t vertexesIndex = 0;
+		int32_t facesIndex = 0;
+		int32_t samplerIndex = 0;
+	};
+
 	int32_t version_ = 0;
+	CustomVector<InternalVertexes> vertexes_;
+	CustomVector<InternalFaces> faces_;
 	CustomVector<InternalModel> models_;
+	CustomVector<InternalSampler> samplers_;
 	bool isBufferStoredOnGPU_ = false;
 	bool isWireIndexBufferGenerated_ = false;
 
+	//! samplers are generated when emitters are required first because many models are only rendered
+	std::once_flag samplersGenerated_;
+
+	void GenerateSamplers();
+
+	void GenerateSamplersIfRequired();
+
+	Emitter SampleFace(const InternalSampler& sampler, IRandObject* g, CoordinateSystem coordinate, float magnification) const;
+
 public:
 	Model(const CustomVector<Vertex>& vertecies, const CustomVector<Face>& faces);
 
@@ -918,8 +965,35 @@ public:
 
 	int32_t GetFrameCount() const;
 
+	/**
+		@brief
+		\~English	Get the number of vertex arrays. Frames with same vertexes share an array and a vertex buffer.
+		\~Japanese	頂点配列の数を取得する。同じ頂点を持つフレームは配列と頂点バッファを共有する。
+	*/
+	int32_t GetUniqueVertexesCount() const;
+
+	/**
+		@brief
+		\~English	Get the number of face arrays. Frames with same faces share an array and index buffers.
+		\~Japanese	面配列の数を取得する。同じ面を持つフレームは配列とインデックスバッファを共有する。
+	*/
+	int32_t GetUniqueFacesCount() const;
+
 	Emitter GetEmitter(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification);
 
+	/**
+		@brief
+		\~English	Get emitters at random points on faces at once. Points are distributed uniformly by area as with GetEmitter.
+		\~Japanese	面上のランダムな点のエミッターをまとめて取得する。点はGetEmitterと同様に面積に対して均一に分布する。
+		@param	g
+		\~English	a random generator which is used for all emitters
+		\~Japanese	全てのエミッターに使用される乱数生成器
+		@param	emitters
+		\~English	an array which has count elements or more
+		\~Japanese	count以上の要素を持つ配列
+	*/
+	void GetEmitters(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification, Emitter* emitters, int32_t count);
+
 	Emitter GetEmitterFromVertex(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification);
 
 	Emitter GetEmitterFromVertex(int32_t index, int32_t time, CoordinateSystem coordinate, float magnification);
@@ -997,6 +1071,16 @@ public:
 		\~Japanese	読み込まれたモデルのポインタ
 	*/
 	virtual void Unload(ModelRef data);
+
+	/**
+		@brief
+		\~English	Get whether Load with data can be called from multiple threads at the same time. If it is true, EffectBatchLoader calls it on worker threads.
+		\~Japanese	データを引数とするLoadを複数のスレッドから同時に呼べるかどうかを取得する。trueの場合、EffectBatchLoaderはワーカースレッドで呼ぶ。
+	*/
+	virtual bool GetIsThreadSafe() const
+	{
+		return false;
+	}
 };
 
 //----------------------------------------------------------------------------------
@@ -1095,6 +1179,7 @@ public:
 #ifndef __EFFEKSEER_MODEL_H__
 #define __EFFEKSEER_MODEL_H__
 
+#include <mutex>
 
 namespace Effekseer
 {
@@ -1141,20 +1226,53 @@ public:
 	};
 
 protected:
-	struct InternalModel
+	struct InternalVertexes
 	{
 		CustomVector<Vertex> vertexes;
-		CustomVector<Face> faces;
 		RefPtr<Backend::VertexBuffer> vertexBuffer;
+	};
+
+	struct InternalFaces
+	{
+		CustomVector<Face> faces;
 		RefPtr<Backend::IndexBuffer> indexBuffer;
 		RefPtr<Backend::IndexBuffer> wireIndexBuffer;
 	};
 
+	//! a structure to sample points on faces in proportion to their areas with an alias table
+	struct InternalSampler
+	{
+		//! attributes of vertices of faces which are packed to avoid indirect accesses
+		CustomVector<std::array<Emitter, 3>> triangles;
+		CustomVector<float> probabilities;
+		CustomVector<int32_t> aliases;
+	};
+
+	//! a frame refers vertexes and faces which are shared with other frames if they are same
+	struct InternalModel
+	{
+		int32_t vertexesIndex = 0;
+		int32_t facesIndex = 0;
+		int32_t samplerIndex = 0;
+	};
+
 	int32_t version_ = 0;
+	CustomVector<InternalVertexes> vertexes_;
+	CustomVector<InternalFaces> faces_;
 	CustomVector<InternalModel> models_;
+	CustomVector<InternalSampler> samplers_;
 	bool isBufferStoredOnGPU_ = false;
 	bool isWireIndexBufferGenerated_ = false;
 
+	//! samplers are generated when emitters are required first because many models are only rendered
+	std::once_flag samplersGenerated_;
+
+	void GenerateSamplers();
+
+	void GenerateSamplersIfRequired();
+
+	Emitter SampleFace(const InternalSampler& sampler, IRandObject* g, CoordinateSystem coordinate, float magnification) const;
+
 public:
 	Model(const CustomVector<Vertex>& vertecies, const CustomVector<Face>& faces);
 
@@ -1178,8 +1296,35 @@ public:
 
 	int32_t GetFrameCount() const;
 
+	/**
+		@brief
+		\~English	Get the number of vertex arrays. Frames with same vertexes share an array and a vertex buffer.
+		\~Japanese	頂点配列の数を取得する。同じ頂点を持つフレームは配列と頂点バッファを共有する。
+	*/
+	int32_t GetUniqueVertexesCount() const;
+
+	/**
+		@brief
+		\~English	Get the number of face arrays. Frames with same faces share an array and index buffers.
+		\~Japanese	面配列の数を取得する。同じ面を持つフレームは配列とインデックスバッファを共有する。
+	*/
+	int32_t GetUniqueFacesCount() const;
+
 	Emitter GetEmitter(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification);
 
+	/**
+		@brief
+		\~English	Get emitters at random points on faces at once. Points are distributed uniformly by area as with GetEmitter.
+		\~Japanese	面上のランダムな点のエミッターをまとめて取得する。点はGetEmitterと同様に面積に対して均一に分布する。
+		@param	g
+		\~English	a random generator which is used for all emitters
+		\~Japanese	全てのエミッターに使用される乱数生成器
+		@param	emitters
+		\~English	an array which has count elements or more
+		\~Japanese	count以上の要素を持つ配列
+	*/
+	void GetEmitters(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification, Emitter* emitters, int32_t count);
+
 	Emitter GetEmitterFromVertex(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification);
 
 	Emitter GetEmitterFromVertex(int32_t index, int32_t time, CoordinateSystem coordinate, float magnification);
@@ -1537,6 +1682,19 @@ public:
 		\~Japanese	読み込まれたカーブのポインタ
 	*/
 	virtual void Unload(CurveRef data);
+
+	/**
+		@brief
+		\~English	Get whether Load with data can be called from multiple threads at the same time. If it is true, EffectBatchLoader calls it on worker threads.
+		\~Japanese	データを引数とするLoadを複数のスレッドから同時に呼べるかどうかを取得する。trueの場合、EffectBatchLoaderはワーカースレッドで呼ぶ。
+		@note
+		\~English	It returns true because the default Load only parses data. Override it if Load is overridden with a function which is not thread safe.
+		\~Japanese	デフォルトのLoadはデータを解析するだけのため、trueを返す。スレッドセーフでない関数でLoadをオーバーライドする場合、オーバーライドすること。
+	*/
+	virtual bool GetIsThreadSafe() const
+	{
+		return true;
+	}
 };
 
 //----------------------------------------------------------------------------------
@@ -1704,6 +1862,16 @@ public:
 	{
 		data.Reset();
 	}
+
+	/**
+		@brief
+		\~English	Get whether Load with data can be called from multiple threads at the same time. If it is true, EffectBatchLoader calls it on worker threads.
+		\~Japanese	データを引数とするLoadを複数のスレッドから同時に呼べるかどうかを取得する。trueの場合、EffectBatchLoaderはワーカースレッドで呼ぶ。
+	*/
+	virtual bool GetIsThreadSafe() const
+	{
+		return false;
+	}
 };
 
 //----------------------------------------------------------------------------------
@@ -1100,6 +1100,78 @@ public:
 //
 //----------------------------------------------------------------------------------
 #endif // __EFFEKSEER_BASE_PRE_H__
+#ifndef __EFFEKSEER_HASH_H__
+#define __EFFEKSEER_HASH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace Effekseer
+{
+
+/**
+	@brief
+	\~English	A builder of a 64bit FNV-1a hash. A hash is same between processes and platforms, so it can be used as a key of files.
+	\~Japanese	64bitのFNV-1aハッシュを構築するクラス。ハッシュはプロセスやプラットフォーム間で同じになるため、ファイルのキーとして使用できる。
+*/
+class HashBuilder
+{
+	uint64_t hash_;
+
+public:
+	static const uint64_t OffsetBasis = 14695981039346656037ULL;
+	static const uint64_t Prime = 1099511628211ULL;
+
+	explicit HashBuilder(uint64_t hash = OffsetBasis)
+		: hash_(hash)
+	{
+	}
+
+	//! combine bytes one by one
+	void AddBytes(const void* data, size_t size)
+	{
+		const auto bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash_ ^= bytes[i];
+			hash_ *= Prime;
+		}
+	}
+
+	//! combine a value at once
+	void AddValue(uint64_t value)
+	{
+		hash_ ^= value;
+		hash_ *= Prime;
+	}
+
+	//! combine a float. -0 is treated as 0.
+	void AddFloat(float value)
+	{
+		value += 0.0f;
+		uint32_t bits = 0;
+		memcpy(&bits, &value, sizeof(float));
+		AddValue(bits);
+	}
+
+	uint64_t Get() const
+	{
+		return hash_;
+	}
+};
+
+//! calculate a 64bit FNV-1a hash of bytes
+inline uint64_t CalculateHash(const void* data, size_t size)
+{
+	HashBuilder builder;
+	builder.AddBytes(data, size);
+	return builder.Get();
+}
+
+} // namespace Effekseer
+
+#endif
 
 #ifndef __EFFEKSEER_CUSTOM_ALLOCATOR_H__
 #define __EFFEKSEER_CUSTOM_ALLOCATOR_H__
@@ -1381,18 +1453,7 @@ public:
 	{
 		size_t operator()(const StringView<T>& key) const
 		{
-			constexpr size_t basis = (sizeof(size_t) == 8) ? 14695981039346656037ULL : 2166136261U;
-			constexpr size_t prime = (sizeof(size_t) == 8) ? 1099511628211ULL : 16777619U;
-
-			const uint8_t* data = reinterpret_cast<const uint8_t*>(key.data());
-			size_t count = key.size() * sizeof(T);
-			size_t val = basis;
-			for (size_t i = 0; i < count; i++)
-			{
-				val ^= static_cast<size_t>(data[i]);
-				val *= prime;
-			}
-			return val;
+			return static_cast<size_t>(CalculateHash(key.data(), key.size() * sizeof(T)));
 		}
 	};
 
@@ -2253,6 +2314,7 @@ class Texture;
 class RenderPass;
 class PipelineState;
 class UniformLayout;
+class Fence;
 
 using GraphicsDeviceRef = RefPtr<GraphicsDevice>;
 using VertexBufferRef = RefPtr<VertexBuffer>;
@@ -2265,6 +2327,7 @@ using TextureRef = RefPtr<Texture>;
 using RenderPassRef = RefPtr<RenderPass>;
 using PipelineStateRef = RefPtr<PipelineState>;
 using UniformLayoutRef = RefPtr<UniformLayout>;
+using FenceRef = RefPtr<Fence>;
 
 static const int32_t RenderTargetMax = 4;
 
@@ -2501,6 +2564,29 @@ public:
 	virtual ~RenderPass() = default;
 };
 
+/**
+	@brief	A fence which is signaled when GPU has completed commands issued before it
+*/
+class Fence
+	: public ReferenceObject
+{
+public:
+	Fence() = default;
+	virtual ~Fence() = default;
+
+	/**
+		@brief	Whether commands issued before the fence have been completed without waiting
+	*/
+	virtual bool IsCompleted() = 0;
+
+	/**
+		@brief	Wait until commands issued before the fence are completed
+		@param	timeoutNanoseconds	the maximum time to wait
+		@return	false if the timeout expired
+	*/
+	virtual bool Wait(uint64_t timeoutNanoseconds) = 0;
+};
+
 enum class TextureWrapType
 {
 	Clamp,
@@ -2543,6 +2629,8 @@ enum class VertexLayoutFormat
 	R32G32B32A32_FLOAT,
 	R8G8B8A8_UNORM,
 	R8G8B8A8_UINT,
+	R16G16_FLOAT,
+	R16G16B16A16_FLOAT,
 };
 
 struct VertexLayoutElement
@@ -2847,6 +2935,15 @@ public:
 	{
 		return "";
 	}
+
+	/**
+		@brief	Insert a fence after commands which have been issued
+		@return	a fence. It is null if fences are not supported.
+	*/
+	virtual FenceRef CreateFence()
+	{
+		return FenceRef{};
+	}
 };
 
 inline int32_t GetVertexLayoutFormatSize(VertexLayoutFormat format)
@@ -2872,6 +2969,14 @@ inline int32_t GetVertexLayoutFormatSize(VertexLayoutFormat format)
 	{
 		size = sizeof(float) * 4;
 	}
+	else if (format == Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT)
+	{
+		size = sizeof(uint16_t) * 2;
+	}
+	else if (format == Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT)
+	{
+		size = sizeof(uint16_t) * 4;
+	}
 	else
 	{
 		assert(0);
@@ -4675,6 +4780,44 @@ public:
 	*/
 	virtual Handle Play(const EffectRef& effect, const Vector3D& position, int32_t startFrame = 0) = 0;
 
+	/**
+		@brief
+		\~English	Play an effect which is not controlled after it is played.
+		\~Japanese	再生後に操作しないエフェクトを再生する。
+		@param	effect
+		\~English	Played effect
+		\~Japanese	再生されるエフェクト
+		@param	transform
+		\~English	A transform of the effect
+		\~Japanese	エフェクトの変換行列
+		@param	randomSeed
+		\~English	A seed of random numbers. If it is negative, a seed is decided in the same way as Play.
+		\~Japanese	乱数のシード。負の場合、Playと同じ方法でシードが決定される。
+		@note
+		\~English
+		It is suitable for short effects which are played many times, like hit sparks.
+		The effect has no handle and is removed automatically when it finishes.
+		Effects played with this function are updated, removed and drawn together for each Effect, so the cost per an effect is lower than Play.
+		They are always drawn on layer 0 after effects played with Play, and are not sorted even if IsSortingEffectsEnabled is true.
+		They are paused by SetPausedToAllEffects, but are not affected by functions for handles or groups, like SetSpeed, SetTimeScaleByGroup and SetLayer.
+		Instances of finished effects are kept for each Effect and reused by next effects until all effects of the Effect finish.
+		\~Japanese
+		ヒットエフェクトのように何度も再生される短いエフェクトに適している。
+		エフェクトはハンドルを持たず、終了した時に自動的に削除される。
+		この関数で再生されたエフェクトはEffectごとにまとめて更新、削除、描画されるため、エフェクトあたりの負荷がPlayより小さい。
+		これらは常にレイヤー0で、Playで再生されたエフェクトの後に描画され、IsSortingEffectsEnabledがtrueでもソートされない。
+		SetPausedToAllEffectsで一時停止されるが、SetSpeed、SetTimeScaleByGroup、SetLayerのようなハンドルやグループに対する関数の影響は受けない。
+		終了したエフェクトのインスタンスはEffectごとに保持され、そのEffectのエフェクトが全て終了するまで次のエフェクトで再利用される。
+	*/
+	virtual void PlayInstanced(const EffectRef& effect, const Matrix43& transform, int32_t randomSeed = -1) = 0;
+
+	/**
+		@brief
+		\~English	Get the number of effects which are played with PlayInstanced and still exist.
+		\~Japanese	PlayInstancedで再生され、まだ存在しているエフェクトの数を取得する。
+	*/
+	virtual int32_t GetInstancedEffectCount() const = 0;
+
 	/**
 		@brief
 		\~English	Get a camera's culling mask to show all effects
@@ -25,6 +25,7 @@ class Texture;
 class RenderPass;
 class PipelineState;
 class UniformLayout;
+class Fence;
 
 using GraphicsDeviceRef = RefPtr<GraphicsDevice>;
 using VertexBufferRef = RefPtr<VertexBuffer>;
@@ -37,6 +38,7 @@ using TextureRef = RefPtr<Texture>;
 using RenderPassRef = RefPtr<RenderPass>;
 using PipelineStateRef = RefPtr<PipelineState>;
 using UniformLayoutRef = RefPtr<UniformLayout>;
+using FenceRef = RefPtr<Fence>;
 
 static const int32_t RenderTargetMax = 4;
 
@@ -273,6 +275,29 @@ public:
 	virtual ~RenderPass() = default;
 };
 
+/**
+	@brief	A fence which is signaled when GPU has completed commands issued before it
+*/
+class Fence
+	: public ReferenceObject
+{
+public:
+	Fence() = default;
+	virtual ~Fence() = default;
+
+	/**
+		@brief	Whether commands issued before the fence have been completed without waiting
+	*/
+	virtual bool IsCompleted() = 0;
+
+	/**
+		@brief	Wait until commands issued before the fence are completed
+		@param	timeoutNanoseconds	the maximum time to wait
+		@return	false if the timeout expired
+	*/
+	virtual bool Wait(uint64_t timeoutNanoseconds) = 0;
+};
+
 enum class TextureWrapType
 {
 	Clamp,
@@ -315,6 +340,8 @@ enum class VertexLayoutFormat
 	R32G32B32A32_FLOAT,
 	R8G8B8A8_UNORM,
 	R8G8B8A8_UINT,
+	R16G16_FLOAT,
+	R16G16B16A16_FLOAT,
 };
 
 struct VertexLayoutElement
@@ -619,6 +646,15 @@ public:
 	{
 		return "";
 	}
+
+	/**
+		@brief	Insert a fence after commands which have been issued
+		@return	a fence. It is null if fences are not supported.
+	*/
+	virtual FenceRef CreateFence()
+	{
+		return FenceRef{};
+	}
 };
 
 inline int32_t GetVertexLayoutFormatSize(VertexLayoutFormat format)
@@ -644,6 +680,14 @@ inline int32_t GetVertexLayoutFormatSize(VertexLayoutFormat format)
 	{
 		size = sizeof(float) * 4;
 	}
+	else if (format == Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT)
+	{
+		size = sizeof(uint16_t) * 2;
+	}
+	else if (format == Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT)
+	{
+		size = sizeof(uint16_t) * 4;
+	}
 	else
 	{
 		assert(0);
@@ -70,6 +70,19 @@ public:
 		\~Japanese	読み込まれたカーブのポインタ
 	*/
 	virtual void Unload(CurveRef data);
+
+	/**
+		@brief
+		\~English	Get whether Load with data can be called from multiple threads at the same time. If it is true, EffectBatchLoader calls it on worker threads.
+		\~Japanese	データを引数とするLoadを複数のスレッドから同時に呼べるかどうかを取得する。trueの場合、EffectBatchLoaderはワーカースレッドで呼ぶ。
+		@note
+		\~English	It returns true because the default Load only parses data. Override it if Load is overridden with a function which is not thread safe.
+		\~Japanese	デフォルトのLoadはデータを解析するだけのため、trueを返す。スレッドセーフでない関数でLoadをオーバーライドする場合、オーバーライドすること。
+	*/
+	virtual bool GetIsThreadSafe() const
+	{
+		return true;
+	}
 };
 
 //----------------------------------------------------------------------------------
@@ -883,7 +883,7 @@ float EffectImplemented::GetMaginification() const
 //----------------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------------
-bool EffectImplemented::Load(const void* pData, int size, float mag, const char16_t* materialPath, ReloadingThreadType reloadingThreadType)
+bool EffectImplemented::Load(const void* pData, int size, float mag, const char16_t* materialPath, ReloadingThreadType reloadingThreadType, bool isResourceLoadingDeferred)
 {
 	factory.Reset();
 
@@ -922,7 +922,7 @@ bool EffectImplemented::Load(const void* pData, int size, float mag, const char1
 	if (materialPath != nullptr)
 		materialPath_ = materialPath;
 
-	if (factory->GetIsResourcesLoadedAutomatically())
+	if (factory->GetIsResourcesLoadedAutomatically() && !isResourceLoadingDeferred)
 	{
 		ReloadResources(pData, size, materialPath);
 	}
@@ -930,6 +930,29 @@ bool EffectImplemented::Load(const void* pData, int size, float mag, const char1
 	return true;
 }
 
+void EffectImplemented::LoadDeferredResources(const void* data, int32_t size)
+{
+	if (factory != nullptr && factory->GetIsResourcesLoadedAutomatically())
+	{
+		ReloadResources(data, size, materialPath_.c_str());
+	}
+}
+
+void EffectImplemented::CombineResourcePath(char16_t* dst, const char16_t* materialPath, const char16_t* path)
+{
+	PathCombine(dst, materialPath, path);
+}
+
+void EffectImplemented::GetParentDirectory(char16_t* dst, const char16_t* path)
+{
+	GetParentDir(dst, path);
+}
+
+std::u16string EffectImplemented::GetNameFromPath(const char16_t* path)
+{
+	return getFilenameWithoutExt(path);
+}
+
 //----------------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------------
@@ -0,0 +1,384 @@
+#include "Effekseer.EffectBatchLoader.h"
+#include "Effekseer.CurveLoader.h"
+#include "Effekseer.DefaultFile.h"
+#include "Effekseer.EffectImplemented.h"
+#include "Effekseer.EffectLoader.h"
+#include "Effekseer.MaterialLoader.h"
+#include "Effekseer.Manager.h"
+#include "Effekseer.ResourceManager.h"
+#include "Effekseer.Setting.h"
+#include "Effekseer.SoundLoader.h"
+#include "Effekseer.TextureLoader.h"
+#include "Model/ModelLoader.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+namespace Effekseer
+{
+
+namespace
+{
+
+enum class BatchResourceType
+{
+	Texture,
+	Model,
+	Sound,
+	Curve,
+};
+
+struct BatchEffect
+{
+	std::u16string path;
+	void* data = nullptr;
+	int32_t size = 0;
+	RefPtr<EffectImplemented> effect;
+};
+
+struct BatchResource
+{
+	BatchResourceType type;
+	TextureType textureType;
+	std::u16string path;
+	std::vector<uint8_t> data;
+
+	//! a created resource. it is created on a worker thread if the loader is thread safe.
+	TextureRef texture;
+	ModelRef model;
+	SoundDataRef sound;
+	CurveRef curve;
+	bool isCreated = false;
+};
+
+} // namespace
+
+void EffectBatchLoader::RunParallel(int32_t count, const std::function<void(int32_t)>& task, int32_t finishedOffset, int32_t totalCount)
+{
+	std::atomic<int32_t> finished(0);
+	const auto callingThreadID = std::this_thread::get_id();
+
+	RunParallelFor(workerThreads_.data(), static_cast<int32_t>(workerThreads_.size()), count, 1, [&](int32_t begin, int32_t end) {
+		for (int32_t i = begin; i < end; i++)
+		{
+			task(i);
+			const int32_t finishedCount = finished.fetch_add(1) + 1;
+
+			// the calling thread also processes tasks and reports progress
+			if (progressCallback_ != nullptr && std::this_thread::get_id() == callingThreadID)
+			{
+				progressCallback_(finishedOffset + finishedCount, totalCount);
+			}
+		}
+	});
+
+	if (progressCallback_ != nullptr)
+	{
+		progressCallback_(finishedOffset + count, totalCount);
+	}
+}
+
+EffectBatchLoader::EffectBatchLoader(const ManagerRef& manager, int32_t threadCount, FileInterfaceRef fileInterface)
+	: manager_(manager)
+	, fileInterface_(fileInterface)
+{
+	if (fileInterface_ == nullptr)
+	{
+		fileInterface_ = MakeRefPtr<DefaultFileInterface>();
+	}
+
+	if (threadCount <= 0)
+	{
+		threadCount = std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()));
+	}
+
+	// the calling thread works too
+	workerThreads_.resize(threadCount - 1);
+	for (auto& worker : workerThreads_)
+	{
+		worker.Launch();
+	}
+}
+
+EffectBatchLoader::~EffectBatchLoader()
+{
+	for (auto& worker : workerThreads_)
+	{
+		worker.Shutdown();
+	}
+}
+
+std::vector<EffectRef> EffectBatchLoader::Load(const std::vector<std::u16string>& paths, float magnification)
+{
+	std::vector<EffectRef> ret(paths.size());
+
+	auto setting = manager_->GetSetting();
+	if (setting == nullptr || setting->GetEffectLoader() == nullptr)
+	{
+		return ret;
+	}
+
+	auto effectLoader = setting->GetEffectLoader();
+	auto resourceManager = setting->GetResourceManager();
+
+	std::vector<BatchEffect> effects(paths.size());
+	int32_t totalCount = static_cast<int32_t>(paths.size());
+
+	// parse effects without resources
+	RunParallel(
+		static_cast<int32_t>(effects.size()),
+		[&](int32_t index) {
+			auto& e = effects[index];
+			e.path = paths[index];
+
+			if (!effectLoader->Load(e.path.c_str(), e.data, e.size))
+			{
+				e.data = nullptr;
+				return;
+			}
+
+			char16_t parentDir[512];
+			EffectImplemented::GetParentDirectory(parentDir, e.path.c_str());
+
+			auto effect = MakeRefPtr<EffectImplemented>(manager_, e.data, e.size);
+			if (e.data == nullptr || e.size == 0 || !effect->Load(e.data, e.size, magnification, parentDir, ReloadingThreadType::Main, true))
+			{
+				return;
+			}
+
+			e.effect = effect;
+		},
+		0,
+		totalCount);
+
+	// collect resources which are not loaded yet
+	std::vector<BatchResource> resources;
+	std::unordered_set<std::u16string> textureKeys;
+	std::unordered_set<std::u16string> modelKeys;
+	std::unordered_set<std::u16string> soundKeys;
+	std::unordered_set<std::u16string> curveKeys;
+
+	if (resourceManager != nullptr)
+	{
+		const auto addResource = [&](auto& cache, std::unordered_set<std::u16string>& keys, BatchResourceType type, TextureType textureType, const char16_t* materialPath, const char16_t* path) {
+			if (path == nullptr || !cache.GetIsCacheEnabled() || cache.GetLoader() == nullptr)
+			{
+				return;
+			}
+
+			char16_t fullPath[512];
+			EffectImplemented::CombineResourcePath(fullPath, materialPath, path);
+
+			if (cache.IsCached(fullPath) || !keys.insert(fullPath).second)
+			{
+				return;
+			}
+
+			BatchResource resource;
+			resource.type = type;
+			resource.textureType = textureType;
+			resource.path = fullPath;
+			resources.emplace_back(std::move(resource));
+		};
+
+		for (auto& e : effects)
+		{
+			auto effect = e.effect;
+			if (effect == nullptr)
+			{
+				continue;
+			}
+
+			char16_t parentDir[512];
+			EffectImplemented::GetParentDirectory(parentDir, e.path.c_str());
+
+			for (int32_t i = 0; i < effect->GetColorImageCount(); i++)
+			{
+				addResource(resourceManager->CachedTextures, textureKeys, BatchResourceType::Texture, TextureType::Color, parentDir, effect->GetColorImagePath(i));
+			}
+
+			for (int32_t i = 0; i < effect->GetNormalImageCount(); i++)
+			{
+				addResource(resourceManager->CachedTextures, textureKeys, BatchResourceType::Texture, TextureType::Normal, parentDir, effect->GetNormalImagePath(i));
+			}
+
+			for (int32_t i = 0; i < effect->GetDistortionImageCount(); i++)
+			{
+				addResource(resourceManager->CachedTextures, textureKeys, BatchResourceType::Texture, TextureType::Distortion, parentDir, effect->GetDistortionImagePath(i));
+			}
+
+			for (int32_t i = 0; i < effect->GetModelCount(); i++)
+			{
+				addResource(resourceManager->CachedModels, modelKeys, BatchResourceType::Model, TextureType::Color, parentDir, effect->GetModelPath(i));
+			}
+
+			for (int32_t i = 0; i < effect->GetWaveCount(); i++)
+			{
+				addResource(resourceManager->CachedSounds, soundKeys, BatchResourceType::Sound, TextureType::Color, parentDir, effect->GetWavePath(i));
+			}
+
+			for (int32_t i = 0; i < effect->GetCurveCount(); i++)
+			{
+				addResource(resourceManager->CachedCurves, curveKeys, BatchResourceType::Curve, TextureType::Color, parentDir, effect->GetCurvePath(i));
+			}
+		}
+	}
+
+	const int32_t finishedCount = totalCount;
+	totalCount += static_cast<int32_t>(resources.size());
+
+	const auto createResource = [&](BatchResource& resource) {
+		const auto data = resource.data.data();
+		const auto size = static_cast<int32_t>(resource.data.size());
+
+		if (resource.type == BatchResourceType::Texture)
+		{
+			resource.texture = resourceManager->GetTextureLoader()->Load(data, size, resource.textureType, TextureLoaderHelper::GetIsMipmapEnabled(resource.path));
+		}
+		else if (resource.type == BatchResourceType::Model)
+		{
+			resource.model = resourceManager->GetModelLoader()->Load(data, size);
+		}
+		else if (resource.type == BatchResourceType::Sound)
+		{
+			resource.sound = resourceManager->GetSoundLoader()->Load(data, size);
+		}
+		else if (resource.type == BatchResourceType::Curve)
+		{
+			resource.curve = resourceManager->GetCurveLoader()->Load(data, size);
+		}
+
+		resource.isCreated = true;
+		resource.data.clear();
+		resource.data.shrink_to_fit();
+	};
+
+	// resources are created while files are read if their loaders are thread safe
+	std::array<bool, 4> isThreadSafe = {};
+	if (resourceManager != nullptr)
+	{
+		const auto getIsThreadSafe = [](const auto& loader) { return loader != nullptr && loader->GetIsThreadSafe(); };
+		isThreadSafe[static_cast<int32_t>(BatchResourceType::Texture)] = getIsThreadSafe(resourceManager->GetTextureLoader());
+		isThreadSafe[static_cast<int32_t>(BatchResourceType::Model)] = getIsThreadSafe(resourceManager->GetModelLoader());
+		isThreadSafe[static_cast<int32_t>(BatchResourceType::Sound)] = getIsThreadSafe(resourceManager->GetSoundLoader());
+		isThreadSafe[static_cast<int32_t>(BatchResourceType::Curve)] = getIsThreadSafe(resourceManager->GetCurveLoader());
+	}
+
+	// read shared files once
+	RunParallel(
+		static_cast<int32_t>(resources.size()),
+		[&](int32_t index) {
+			auto& resource = resources[index];
+			auto reader = fileInterface_->TryOpenRead(resource.path.c_str());
+			if (reader == nullptr)
+			{
+				return;
+			}
+
+			resource.data.resize(reader->GetLength());
+			if (reader->Read(resource.data.data(), resource.data.size()) != resource.data.size())
+			{
+				resource.data.clear();
+				return;
+			}
+
+			if (isThreadSafe[static_cast<int32_t>(resource.type)])
+			{
+				createResource(resource);
+			}
+		},
+		finishedCount,
+		totalCount);
+
+	// other resources are created on the calling thread, and ResourceManager is not thread safe
+	std::vector<TextureRef> registeredTextures;
+	std::vector<ModelRef> registeredModels;
+	std::vector<SoundDataRef> registeredSounds;
+	std::vector<CurveRef> registeredCurves;
+
+	for (auto& resource : resources)
+	{
+		if (!resource.isCreated)
+		{
+			if (resource.data.empty())
+			{
+				continue;
+			}
+
+			createResource(resource);
+		}
+
+		const auto path = resource.path.c_str();
+
+		if (resource.texture != nullptr)
+		{
+			resourceManager->CachedTextures.Register(path, resource.texture);
+			registeredTextures.emplace_back(resource.texture);
+		}
+		else if (resource.model != nullptr)
+		{
+			resourceManager->CachedModels.Register(path, resource.model);
+			registeredModels.emplace_back(resource.model);
+		}
+		else if (resource.sound != nullptr)
+		{
+			resourceManager->CachedSounds.Register(path, resource.sound);
+			registeredSounds.emplace_back(resource.sound);
+		}
+		else if (resource.curve != nullptr)
+		{
+			resourceManager->CachedCurves.Register(path, resource.curve);
+			registeredCurves.emplace_back(resource.curve);
+		}
+
+		resource.texture.Reset();
+		resource.model.Reset();
+		resource.sound.Reset();
+		resource.curve.Reset();
+	}
+
+	// bind resources. prefetched resources are found in the cache and others are loaded as usual
+	for (size_t i = 0; i < effects.size(); i++)
+	{
+		auto& e = effects[i];
+
+		if (e.effect != nullptr)
+		{
+			e.effect->LoadDeferredResources(e.data, e.size);
+			e.effect->SetName(EffectImplemented::GetNameFromPath(e.path.c_str()).c_str());
+			ret[i] = e.effect;
+		}
+
+		if (e.data != nullptr)
+		{
+			effectLoader->Unload(e.data, e.size);
+		}
+	}
+
+	// release references which are held only for registration
+	for (auto& texture : registeredTextures)
+	{
+		resourceManager->UnloadTexture(texture);
+	}
+
+	for (auto& model : registeredModels)
+	{
+		resourceManager->UnloadModel(model);
+	}
+
+	for (auto& sound : registeredSounds)
+	{
+		resourceManager->UnloadSoundData(sound);
+	}
+
+	for (auto& curve : registeredCurves)
+	{
+		resourceManager->UnloadCurve(curve);
+	}
+
+	return ret;
+}
+
+} // namespace Effekseer
@@ -0,0 +1,97 @@
+
+#ifndef __EFFEKSEER_EFFECT_BATCH_LOADER_H__
+#define __EFFEKSEER_EFFECT_BATCH_LOADER_H__
+
+#include "Effekseer.Base.h"
+#include "Effekseer.File.h"
+#include "Effekseer.WorkerThread.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Effekseer
+{
+
+/**
+	@brief
+	\~English	A class to load many effects at once
+	\~Japanese	複数のエフェクトを一括で読み込むクラス
+	@note
+	\~English
+	Effects are parsed on worker threads. Textures, models, sounds and curves which are referred by the effects are collected,
+	de-duplicated and read from files on worker threads, and they are registered into ResourceManager on the calling thread.
+	So each file is read only once even if it is shared by many effects.
+	The FileInterface, the EffectLoader and EffectFactories of the setting are called on worker threads at the same time, so they must be thread safe.
+	TextureLoader, ModelLoader, SoundLoader and CurveLoader are called on worker threads if GetIsThreadSafe returns true, otherwise on the calling thread.
+	MaterialLoader is called only on the calling thread.
+	Materials are not prefetched. A MaterialLoader chooses between a compiled file and a source file by itself, so they are loaded with paths when effects are bound.
+	\~Japanese
+	エフェクトはワーカースレッドで解析される。エフェクトが参照するテクスチャ、モデル、サウンド、カーブは重複を除いた上でワーカースレッドでファイルから読み込まれ、
+	呼び出したスレッドでResourceManagerに登録される。そのため、複数のエフェクトで共有されるファイルは一度しか読み込まれない。
+	FileInterface、設定のEffectLoaderとEffectFactoryはワーカースレッドで同時に呼ばれるため、スレッドセーフである必要がある。
+	TextureLoader、ModelLoader、SoundLoader、CurveLoaderはGetIsThreadSafeがtrueを返す場合はワーカースレッドで、そうでない場合は呼び出したスレッドで呼ばれる。
+	MaterialLoaderは呼び出したスレッドでのみ呼ばれる。
+	マテリアルは先読みされない。MaterialLoaderはコンパイル済みファイルとソースファイルを自身で選択するため、エフェクトの結合時にパスで読み込まれる。
+*/
+class EffectBatchLoader
+{
+public:
+	/**
+		@brief
+		\~English	A callback which is called on the calling thread when loading progresses. totalCount increases when referred resources are found.
+		\~Japanese	読み込みが進んだときに呼び出したスレッドで呼ばれるコールバック。参照されているリソースが判明するとtotalCountは増加する。
+	*/
+	using ProgressCallback = std::function<void(int32_t finishedCount, int32_t totalCount)>;
+
+private:
+	ManagerRef manager_;
+	FileInterfaceRef fileInterface_;
+	std::vector<WorkerThread> workerThreads_;
+	ProgressCallback progressCallback_;
+
+	void RunParallel(int32_t count, const std::function<void(int32_t)>& task, int32_t finishedOffset, int32_t totalCount);
+
+public:
+	/**
+		@param	manager
+		\~English	a manager whose setting and resource manager are used
+		\~Japanese	設定とリソースマネージャーが使用されるマネージャー
+		@param	threadCount
+		\~English	the number of worker threads. If it is 0 or less, the number is decided by the hardware.
+		\~Japanese	ワーカースレッドの数。0以下の場合、ハードウェアに応じて決定される。
+		@param	fileInterface
+		\~English	a thread safe interface to read resources. If it is null, DefaultFileInterface is used.
+		\~Japanese	リソースを読み込むスレッドセーフなインターフェース。nullの場合、DefaultFileInterfaceが使用される。
+	*/
+	EffectBatchLoader(const ManagerRef& manager, int32_t threadCount = 0, FileInterfaceRef fileInterface = nullptr);
+
+	~EffectBatchLoader();
+
+	EffectBatchLoader(const EffectBatchLoader&) = delete;
+	EffectBatchLoader& operator=(const EffectBatchLoader&) = delete;
+
+	void SetProgressCallback(ProgressCallback callback)
+	{
+		progressCallback_ = callback;
+	}
+
+	/**
+		@brief
+		\~English	Load effects
+		\~Japanese	エフェクトを読み込む。
+		@param	paths
+		\~English	paths of effects
+		\~Japanese	エフェクトのパス
+		@param	magnification
+		\~English	magnification
+		\~Japanese	拡大率
+		@return
+		\~English	effects in the same order as paths. A failed effect is null.
+		\~Japanese	パスと同じ順番のエフェクト。読み込みに失敗したエフェクトはnull。
+	*/
+	std::vector<EffectRef> Load(const std::vector<std::u16string>& paths, float magnification = 1.0f);
+};
+
+} // namespace Effekseer
+
+#endif // __EFFEKSEER_EFFECT_BATCH_LOADER_H__
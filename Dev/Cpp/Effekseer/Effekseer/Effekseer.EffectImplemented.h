@@ -102,6 +102,7 @@ class EffectImplemented : public Effect, public ReferenceObject
 	friend class ManagerImplemented;
 	friend class EffectNodeImplemented;
 	friend class EffectFactory;
+	friend class EfkRuntimeFile;
 	friend class Instance;
 
 	static const int32_t SupportBinaryVersion = Version17;
@@ -216,7 +217,21 @@ public:
 
 	float GetMaginification() const override;
 
-	bool Load(const void* pData, int size, float mag, const char16_t* materialPath, ReloadingThreadType reloadingThreadType);
+	bool Load(const void* pData, int size, float mag, const char16_t* materialPath, ReloadingThreadType reloadingThreadType, bool isResourceLoadingDeferred = false);
+
+	/**
+		@brief	Load resources which are skipped by Load with isResourceLoadingDeferred.
+	*/
+	void LoadDeferredResources(const void* data, int32_t size);
+
+	/**
+		@brief	Combine a material path and a resource path in the same way as resources are loaded.
+	*/
+	static void CombineResourcePath(char16_t* dst, const char16_t* materialPath, const char16_t* path);
+
+	static void GetParentDirectory(char16_t* dst, const char16_t* path);
+
+	static std::u16string GetNameFromPath(const char16_t* path);
 
 	/**
 		@breif	何も読み込まれていない状態に戻す
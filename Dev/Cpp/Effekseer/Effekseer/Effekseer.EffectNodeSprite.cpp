@@ -311,6 +311,17 @@ SpriteRenderer::NodeParameter EffectNodeSprite::GetNodeParameter(const Manager*
 
 	nodeParameter.EnableViewOffset = (TranslationParam.TranslationType == ParameterTranslationType_ViewOffset);
 
+	const auto& positions = SpritePosition.fixed;
+	const bool isRectangle = SpritePosition.type == SpritePosition.Default ||
+							 (positions.ll.GetX() == positions.ul.GetX() && positions.lr.GetX() == positions.ur.GetX() &&
+							  positions.ll.GetY() == positions.lr.GetY() && positions.ul.GetY() == positions.ur.GetY());
+
+	const auto& colors = SpriteColor.fixed;
+	const bool isUniformColor = SpriteColor.type == SpriteColorParameter::Default ||
+								!(colors.ll != colors.lr || colors.ll != colors.ul || colors.ll != colors.ur);
+
+	nodeParameter.IsRectangleWithUniformColor = isRectangle && isUniformColor;
+
 	return nodeParameter;
 }
 
@@ -43,6 +43,23 @@ InstanceGlobal::~InstanceGlobal()
 {
 }
 
+void InstanceGlobal::Reset()
+{
+	m_instanceCount = 0;
+	m_updatedFrame = 0.0f;
+	m_targetLocation = SIMD::Vec3f(0.0f, 0.0f, 0.0f);
+	dynamicInputParameters.fill(0);
+	m_inputTriggerCounts.fill(0);
+	nextDeltaFrame_ = 0.0f;
+	layer_ = 0;
+	m_userData = nullptr;
+
+	IsSpawnDisabled = false;
+	CurrentLevelOfDetails = 0;
+	IsGlobalColorSet = false;
+	GlobalColor = Color(255, 255, 255, 255);
+}
+
 float InstanceGlobal::GetNextDeltaFrame() const
 {
 	return nextDeltaFrame_;
@@ -59,6 +59,9 @@ private:
 
 	virtual ~InstanceGlobal();
 
+	//! reset states which are changed while playing. The root container and rendered containers are kept to be reused.
+	void Reset();
+
 public:
 	//! A delta time for next update
 	float GetNextDeltaFrame() const;
@@ -72,29 +72,31 @@ ManagerRef Manager::Create(int instance_max, bool autoFlip)
 	return MakeRefPtr<ManagerImplemented>(instance_max, autoFlip);
 }
 
-void ManagerImplemented::DrawSet::UpdateLevelOfDetails(const LayerParameter& loadParameter)
+int ManagerImplemented::CalculateLevelOfDetails(const EffectImplemented* effect, const SIMD::Vec3f& position, const LayerParameter& loadParameter)
 {
-	SIMD::Mat43f drawSetMatrix = this->GetGlobalMatrix();
-	SIMD::Vec3f diff = SIMD::Vec3f(loadParameter.ViewerPosition) - drawSetMatrix.GetTranslation();
+	SIMD::Vec3f diff = SIMD::Vec3f(loadParameter.ViewerPosition) - position;
 	float distanceToViewer = diff.GetLength() + loadParameter.DistanceBias;
 
-	EffectImplemented* effect = (EffectImplemented*)this->ParameterPointer.Get();
 	if (effect->LODs.distance3 > 0.0F && distanceToViewer > effect->LODs.distance3)
 	{
-		GlobalPointer->CurrentLevelOfDetails = 1 << 3;
+		return 1 << 3;
 	}
 	else if (effect->LODs.distance2 > 0.0F && distanceToViewer > effect->LODs.distance2)
 	{
-		GlobalPointer->CurrentLevelOfDetails = 1 << 2;
+		return 1 << 2;
 	}
 	else if (effect->LODs.distance1 > 0.0F && distanceToViewer > effect->LODs.distance1)
 	{
-		GlobalPointer->CurrentLevelOfDetails = 1 << 1;
-	}
-	else
-	{
-		GlobalPointer->CurrentLevelOfDetails = 1 << 0;
+		return 1 << 1;
 	}
+
+	return 1 << 0;
+}
+
+void ManagerImplemented::DrawSet::UpdateLevelOfDetails(const LayerParameter& loadParameter)
+{
+	EffectImplemented* effect = (EffectImplemented*)this->ParameterPointer.Get();
+	GlobalPointer->CurrentLevelOfDetails = CalculateLevelOfDetails(effect, this->GetGlobalMatrix().GetTranslation(), loadParameter);
 }
 
 SIMD::Mat43f ManagerImplemented::DrawSet::GetGlobalMatrix() const
@@ -154,41 +156,301 @@ void ManagerImplemented::StopStoppingEffects()
 		if (draw_set.GoingToStop)
 			continue;
 
-		bool isRemoving = false;
+		if (IsFinished(draw_set.GlobalPointer, draw_set.InstanceContainerPointer))
+		{
+			StopEffect(draw_set_it.first);
+		}
+	}
+}
+
+bool ManagerImplemented::IsFinished(InstanceGlobal* global, InstanceContainer* rootContainer)
+{
+	// Empty
+	if (global->GetInstanceCount() == 0)
+	{
+		return true;
+	}
 
-		// Empty
-		if (!isRemoving && draw_set.GlobalPointer->GetInstanceCount() == 0)
+	// Root only exists and none plan to create new instances
+	if (global->GetInstanceCount() == 1)
+	{
+		InstanceGroup* group = rootContainer != nullptr ? rootContainer->GetFirstGroup() : nullptr;
+
+		if (group)
 		{
-			isRemoving = true;
+			Instance* pRootInstance = group->GetFirst();
+
+			if (pRootInstance && pRootInstance->IsActive() && !pRootInstance->IsFirstTime())
+			{
+				if (!pRootInstance->AreChildrenActive())
+				{
+					// when a sound is not playing.
+					if (m_soundPlayer == nullptr || !m_soundPlayer->CheckPlayingTag(global))
+					{
+						return true;
+					}
+				}
+			}
 		}
+	}
+
+	return false;
+}
 
-		// Root only exists and none plan to create new instances
-		if (!isRemoving && draw_set.GlobalPointer->GetInstanceCount() == 1)
+void ManagerImplemented::InitializeInstancedSpawns()
+{
+	for (const auto& request : requestedInstancedSpawns_)
+	{
+		auto e = request.ParameterPointer->GetImplemented();
+
+		auto indexIt = instancedEffectIndexes_.find(request.ParameterPointer.Get());
+		if (indexIt == instancedEffectIndexes_.end())
 		{
-			InstanceContainer* pRootContainer = draw_set.InstanceContainerPointer;
-			InstanceGroup* group = pRootContainer != nullptr ? pRootContainer->GetFirstGroup() : nullptr;
+			indexIt = instancedEffectIndexes_.emplace(request.ParameterPointer.Get(), static_cast<int32_t>(instancedEffects_.size())).first;
+			instancedEffects_.emplace_back();
+			instancedEffects_.back().ParameterPointer = request.ParameterPointer;
+		}
+
+		auto& instancedEffect = instancedEffects_[indexIt->second];
+
+		// reuse a finished spawn whose containers are already created
+		const bool isReused = !instancedEffect.PooledSpawns.empty();
+
+		InstancedSpawn spawn;
+		if (isReused)
+		{
+			spawn = instancedEffect.PooledSpawns.back();
+			instancedEffect.PooledSpawns.pop_back();
+			spawn.GlobalPointer->Reset();
+		}
+		else
+		{
+			spawn.GlobalPointer = new InstanceGlobal();
+			spawn.GlobalPointer->RenderedInstanceContainers.assign(e->renderingNodesCount, nullptr);
+			spawn.InstanceContainerPointer = nullptr;
+		}
+
+		spawn.GlobalMatrix = request.GlobalMatrix;
+		spawn.GlobalPointer->GetRandObject().SetSeed(request.RandomSeed);
+		spawn.GlobalPointer->dynamicInputParameters = e->defaultDynamicInputs;
+		spawn.GlobalPointer->EffectGlobalMatrix = request.GlobalMatrix;
+
+		Matrix44 inverted;
+		Matrix44::Inverse(inverted, ToStruct(SIMD::Mat44f(request.GlobalMatrix)));
+		spawn.GlobalPointer->InvertedEffectGlobalMatrix = inverted;
+
+		if (e->Culling.Shape == CullingShape::Sphere)
+		{
+			spawn.CullingPosition = SIMD::ToStruct(SIMD::Vec3f::Transform(SIMD::Vec3f(e->Culling.Location), request.GlobalMatrix));
+			spawn.CullingRadius = e->Culling.Sphere.Radius * request.GlobalMatrix.GetScale().GetLength();
+		}
 
-			if (group)
+		if (isReused)
+		{
+			if (!CreateRootInstance(spawn.InstanceContainerPointer, spawn.GlobalPointer, request.GlobalMatrix))
+			{
+				ReleaseInstancedSpawn(spawn);
+				continue;
+			}
+		}
+		else
+		{
+			spawn.InstanceContainerPointer = CreateInstanceContainer(e->GetRoot(), spawn.GlobalPointer, true, request.GlobalMatrix, nullptr);
+			if (spawn.InstanceContainerPointer == nullptr)
 			{
-				Instance* pRootInstance = group->GetFirst();
+				ES_SAFE_DELETE(spawn.GlobalPointer);
+				continue;
+			}
+		}
+
+		spawn.InstanceContainerPointer->GetFirstGroup()->GetFirst()->FirstUpdate();
+
+		instancedEffect.Spawns.emplace_back(spawn);
+	}
+
+	requestedInstancedSpawns_.clear();
+}
 
-				if (pRootInstance && pRootInstance->IsActive() && !pRootInstance->IsFirstTime())
+void ManagerImplemented::GCInstancedEffects(bool isRemovingAll)
+{
+	for (auto& instancedEffect : instancedEffects_)
+	{
+		auto& spawns = instancedEffect.Spawns;
+
+		// swap and pop because the order of spawns has no meaning
+		size_t i = 0;
+		while (i < spawns.size())
+		{
+			if (isRemovingAll || IsFinished(spawns[i].GlobalPointer, spawns[i].InstanceContainerPointer))
+			{
+				if (!isRemovingAll && static_cast<int32_t>(instancedEffect.PooledSpawns.size()) < InstancedSpawnPoolMaxCount)
 				{
-					if (!pRootInstance->AreChildrenActive())
+					// keep the global and the containers but remove instances in them
+					if (m_soundPlayer != nullptr)
 					{
-						// when a sound is not playing.
-						if (m_soundPlayer == nullptr || !m_soundPlayer->CheckPlayingTag(draw_set.GlobalPointer))
-						{
-							isRemoving = true;
-						}
+						m_soundPlayer->StopTag(spawns[i].GlobalPointer);
 					}
+
+					spawns[i].InstanceContainerPointer->RemoveForcibly(true);
+					instancedEffect.PooledSpawns.emplace_back(spawns[i]);
+				}
+				else
+				{
+					ReleaseInstancedSpawn(spawns[i]);
 				}
+
+				spawns[i] = spawns.back();
+				spawns.pop_back();
+			}
+			else
+			{
+				i++;
 			}
 		}
 
-		if (isRemoving)
+		if (isRemovingAll)
 		{
-			StopEffect(draw_set_it.first);
+			ReleaseInstancedEffect(instancedEffect);
+		}
+	}
+}
+
+void ManagerImplemented::ReleaseInstancedSpawn(InstancedSpawn& spawn)
+{
+	if (m_soundPlayer != nullptr)
+	{
+		m_soundPlayer->StopTag(spawn.GlobalPointer);
+	}
+
+	if (spawn.InstanceContainerPointer != nullptr)
+	{
+		spawn.InstanceContainerPointer->RemoveForcibly(true);
+		ReleaseInstanceContainer(spawn.InstanceContainerPointer);
+		spawn.InstanceContainerPointer = nullptr;
+	}
+
+	ES_SAFE_DELETE(spawn.GlobalPointer);
+}
+
+void ManagerImplemented::ReleaseInstancedEffect(InstancedEffect& instancedEffect)
+{
+	for (auto& spawn : instancedEffect.Spawns)
+	{
+		ReleaseInstancedSpawn(spawn);
+	}
+	instancedEffect.Spawns.clear();
+
+	for (auto& spawn : instancedEffect.PooledSpawns)
+	{
+		ReleaseInstancedSpawn(spawn);
+	}
+	instancedEffect.PooledSpawns.clear();
+}
+
+void ManagerImplemented::RemoveEmptyInstancedEffects()
+{
+	// pooled spawns are released when no spawn of the effect is alive
+	bool isRemoved = false;
+	for (auto& instancedEffect : instancedEffects_)
+	{
+		if (instancedEffect.Spawns.empty())
+		{
+			ReleaseInstancedEffect(instancedEffect);
+			isRemoved = true;
+		}
+	}
+
+	if (!isRemoved)
+	{
+		return;
+	}
+
+	instancedEffects_.erase(std::remove_if(instancedEffects_.begin(), instancedEffects_.end(), [](const InstancedEffect& v) { return v.Spawns.empty(); }),
+							instancedEffects_.end());
+
+	instancedEffectIndexes_.clear();
+	for (size_t i = 0; i < instancedEffects_.size(); i++)
+	{
+		instancedEffectIndexes_[instancedEffects_[i].ParameterPointer.Get()] = static_cast<int32_t>(i);
+	}
+}
+
+void ManagerImplemented::UpdateInstancedEffects()
+{
+	for (auto& instancedEffect : instancedEffects_)
+	{
+		auto e = instancedEffect.ParameterPointer->GetImplemented();
+
+		for (auto& spawn : instancedEffect.Spawns)
+		{
+			spawn.GlobalPointer->CurrentLevelOfDetails = CalculateLevelOfDetails(e, spawn.GlobalMatrix.GetTranslation(), m_layerParameters[0]);
+
+			UpdateGlobalDynamicEquations(e, spawn.GlobalPointer);
+
+			spawn.InstanceContainerPointer->Update(true, true);
+
+			spawn.GlobalPointer->EndDeltaFrame();
+		}
+	}
+}
+
+void ManagerImplemented::DrawInstancedEffects(const Manager::DrawParameter& drawParameter, const std::array<Plane, 6>& planes, bool drawsBack, bool drawsFront)
+{
+	// instanced effects are on layer 0
+	if ((drawParameter.CameraCullingMask & 1) == 0)
+	{
+		return;
+	}
+
+	for (const auto& instancedEffect : instancedEffects_)
+	{
+		auto e = instancedEffect.ParameterPointer->GetImplemented();
+
+		visibleInstancedSpawns_.clear();
+
+		for (const auto& spawn : instancedEffect.Spawns)
+		{
+			if (drawParameter.ZNear != drawParameter.ZFar && e->Culling.Shape == CullingShape::Sphere)
+			{
+				Sphare s;
+				s.Center = spawn.CullingPosition;
+				s.Radius = spawn.CullingRadius;
+				if (!GeometryUtility::IsContain(planes, s))
+				{
+					continue;
+				}
+			}
+
+			visibleInstancedSpawns_.emplace_back(&spawn);
+		}
+
+		if (e->renderingNodesCount == 0)
+		{
+			if (drawsFront)
+			{
+				for (auto spawn : visibleInstancedSpawns_)
+				{
+					spawn->InstanceContainerPointer->Draw(true);
+				}
+			}
+			continue;
+		}
+
+		// draw the same node of all spawns continuously so that renderers can batch them
+		const int32_t begin = drawsBack ? 0 : e->renderingNodesThreshold;
+		const int32_t end = drawsFront ? e->renderingNodesCount : e->renderingNodesThreshold;
+
+		for (int32_t i = begin; i < end; i++)
+		{
+			for (auto spawn : visibleInstancedSpawns_)
+			{
+				auto container = spawn->GlobalPointer->RenderedInstanceContainers[i];
+
+				if (IsClippedWithDepth(spawn->GlobalMatrix, container, drawParameter))
+					continue;
+
+				container->Draw(false);
+			}
 		}
 	}
 }
@@ -297,34 +559,40 @@ InstanceContainer* ManagerImplemented::CreateInstanceContainer(
 		pContainer->AddChild(child);
 	}
 
-	if (isRoot)
+	if (isRoot && !CreateRootInstance(pContainer, pGlobal, rootMatrix))
 	{
-		auto group = pContainer->CreateInstanceGroup();
-		if (group == nullptr)
-		{
-			ReleaseInstanceContainer(pContainer);
-			return nullptr;
-		}
-
-		auto instance = group->CreateRootInstance();
-		if (instance == nullptr)
-		{
-			group->IsReferencedFromInstance = false;
-			pContainer->RemoveInvalidGroups();
-			ReleaseInstanceContainer(pContainer);
-			return nullptr;
-		}
+		ReleaseInstanceContainer(pContainer);
+		return nullptr;
+	}
 
-		pGlobal->SetRootContainer(pContainer);
+	return pContainer;
+}
 
-		instance->Initialize(nullptr, 1, 0);
-		instance->ResetGlobalMatrix(rootMatrix);
+bool ManagerImplemented::CreateRootInstance(InstanceContainer* pContainer, InstanceGlobal* pGlobal, const SIMD::Mat43f& rootMatrix)
+{
+	auto group = pContainer->CreateInstanceGroup();
+	if (group == nullptr)
+	{
+		return false;
+	}
 
-		// This group is not generated by an instance, so changed a flag
+	auto instance = group->CreateRootInstance();
+	if (instance == nullptr)
+	{
 		group->IsReferencedFromInstance = false;
+		pContainer->RemoveInvalidGroups();
+		return false;
 	}
 
-	return pContainer;
+	pGlobal->SetRootContainer(pContainer);
+
+	instance->Initialize(nullptr, 1, 0);
+	instance->ResetGlobalMatrix(rootMatrix);
+
+	// This group is not generated by an instance, so changed a flag
+	group->IsReferencedFromInstance = false;
+
+	return true;
 }
 
 void ManagerImplemented::ReleaseInstanceContainer(InstanceContainer* container)
@@ -434,6 +702,7 @@ ManagerImplemented::ManagerImplemented(int instance_max, bool autoFlip)
 
 	, m_soundPlayer(nullptr)
 	, m_randFunc(nullptr)
+	, m_requestedSounds(RequestedSoundCapacity)
 {
 	m_setting = Setting::Create();
 
@@ -486,6 +755,9 @@ ManagerImplemented::~ManagerImplemented()
 	{
 		GCDrawSet(true);
 	}
+
+	GCInstancedEffects(true);
+	RemoveEmptyInstancedEffects();
 }
 
 Instance* ManagerImplemented::CreateInstance(EffectNodeImplemented* pEffectNode, InstanceContainer* pContainer, InstanceGroup* pGroup)
@@ -736,6 +1008,9 @@ void ManagerImplemented::StopAllEffects()
 		it.second.GoingToStop = true;
 		it.second.IsRemoving = true;
 	}
+
+	requestedInstancedSpawns_.clear();
+	isInstancedEffectsStopRequested_ = true;
 }
 
 void ManagerImplemented::StopRoot(Handle handle)
@@ -789,6 +1064,14 @@ int32_t ManagerImplemented::GetTotalInstanceCount() const
 		const DrawSet& drawSet = pair.second;
 		instanceCount += drawSet.GlobalPointer->GetInstanceCount();
 	}
+
+	for (const auto& instancedEffect : instancedEffects_)
+	{
+		for (const auto& spawn : instancedEffect.Spawns)
+		{
+			instanceCount += spawn.GlobalPointer->GetInstanceCount();
+		}
+	}
 	return instanceCount;
 }
 
@@ -1096,6 +1379,8 @@ void ManagerImplemented::SetPausedToAllEffects(bool paused)
 		(*it).second.IsPaused = paused;
 		++it;
 	}
+
+	isInstancedEffectsPaused_ = paused;
 }
 
 int32_t ManagerImplemented::GetLayer(Handle handle)
@@ -1244,6 +1529,14 @@ void ManagerImplemented::Flip()
 
 	GCDrawSet(false);
 
+	GCInstancedEffects(isInstancedEffectsStopRequested_);
+	isInstancedEffectsStopRequested_ = false;
+
+	InitializeInstancedSpawns();
+
+	// after spawns are initialized so that pooled spawns are reused by spawns requested after all spawns of the effect finished
+	RemoveEmptyInstancedEffects();
+
 	m_renderingDrawSets.clear();
 	m_renderingDrawSetMaps.clear();
 
@@ -1349,6 +1642,16 @@ void ManagerImplemented::Update(const UpdateParameter& parameter)
 		maximumDeltaFrame = std::max(maximumDeltaFrame, drawSet.second.NextUpdateFrame);
 	}
 
+	if (!instancedEffects_.empty() || !requestedInstancedSpawns_.empty())
+	{
+		instancedNextUpdateFrame_ += isInstancedEffectsPaused_ ? 0.0f : parameter.DeltaFrame;
+		maximumDeltaFrame = std::max(maximumDeltaFrame, instancedNextUpdateFrame_);
+	}
+	else
+	{
+		instancedNextUpdateFrame_ = 0.0f;
+	}
+
 	int times = 0;
 
 	if (parameter.UpdateInterval != 0)
@@ -1420,6 +1723,24 @@ void ManagerImplemented::DoUpdate(const UpdateParameter& parameter, int times)
 			}
 		}
 
+		{
+			float idf = 0;
+
+			if (instancedNextUpdateFrame_ >= parameter.UpdateInterval)
+			{
+				idf = parameter.UpdateInterval > 0 ? parameter.UpdateInterval : instancedNextUpdateFrame_;
+				instancedNextUpdateFrame_ -= idf;
+			}
+
+			for (auto& instancedEffect : instancedEffects_)
+			{
+				for (auto& spawn : instancedEffect.Spawns)
+				{
+					spawn.GlobalPointer->BeginDeltaFrame(idf);
+				}
+			}
+		}
+
 		for (auto& chunks : instanceChunks_)
 		{
 			// wakeup threads and wait to complete threads are hevery, so multithread the updates if you have a large number of instances.
@@ -1484,6 +1805,11 @@ void ManagerImplemented::DoUpdate(const UpdateParameter& parameter, int times)
 			}
 		}
 
+		{
+			PROFILER_BLOCK("DoUpdate::UpdateInstancedEffects", profiler::colors::Red600);
+			UpdateInstancedEffects();
+		}
+
 		for (auto& drawSet : m_DrawSets)
 		{
 			drawSet.second.AreChildrenOfRootGenerated = true;
@@ -1606,23 +1932,8 @@ void ManagerImplemented::UpdateHandleInternal(DrawSet& drawSet)
 	// calculate dynamic parameters
 	auto e = static_cast<EffectImplemented*>(drawSet.ParameterPointer.Get());
 	assert(e != nullptr);
-	assert(drawSet.GlobalPointer->dynamicEqResults.size() >= e->dynamicEquation.size());
 
-	std::array<float, 1> globals;
-	globals[0] = drawSet.GlobalPointer->GetUpdatedFrame() / 60.0f;
-
-	for (size_t i = 0; i < e->dynamicEquation.size(); i++)
-	{
-		if (e->dynamicEquation[i].GetRunningPhase() != InternalScript::RunningPhaseType::Global)
-			continue;
-
-		drawSet.GlobalPointer->dynamicEqResults[i] = e->dynamicEquation[i].Execute(drawSet.GlobalPointer->dynamicInputParameters,
-																				   globals,
-																				   std::array<float, 5>(),
-																				   RandCallback::Rand,
-																				   RandCallback::RandSeed,
-																				   drawSet.GlobalPointer);
-	}
+	UpdateGlobalDynamicEquations(e, drawSet.GlobalPointer);
 
 	Preupdate(drawSet);
 
@@ -1639,6 +1950,27 @@ void ManagerImplemented::UpdateHandleInternal(DrawSet& drawSet)
 	drawSet.GlobalPointer->EndDeltaFrame();
 }
 
+void ManagerImplemented::UpdateGlobalDynamicEquations(EffectImplemented* effect, InstanceGlobal* global)
+{
+	assert(global->dynamicEqResults.size() >= effect->dynamicEquation.size());
+
+	std::array<float, 1> globals;
+	globals[0] = global->GetUpdatedFrame() / 60.0f;
+
+	for (size_t i = 0; i < effect->dynamicEquation.size(); i++)
+	{
+		if (effect->dynamicEquation[i].GetRunningPhase() != InternalScript::RunningPhaseType::Global)
+			continue;
+
+		global->dynamicEqResults[i] = effect->dynamicEquation[i].Execute(global->dynamicInputParameters,
+																		 globals,
+																		 std::array<float, 5>(),
+																		 RandCallback::Rand,
+																		 RandCallback::RandSeed,
+																		 global);
+	}
+}
+
 void ManagerImplemented::Preupdate(DrawSet& drawSet)
 {
 	if (drawSet.IsPreupdated)
@@ -1669,13 +2001,13 @@ void ManagerImplemented::Preupdate(DrawSet& drawSet)
 	}
 }
 
-bool ManagerImplemented::IsClippedWithDepth(DrawSet& drawSet, InstanceContainer* container, const Manager::DrawParameter& drawParameter)
+bool ManagerImplemented::IsClippedWithDepth(const SIMD::Mat43f& globalMatrix, InstanceContainer* container, const Manager::DrawParameter& drawParameter)
 {
 	// don't use this parameter
 	if (container->m_pEffectNode->DepthValues.DepthParameter.DepthClipping > FLT_MAX / 10)
 		return false;
 
-	SIMD::Vec3f pos = drawSet.GetGlobalMatrix().GetTranslation();
+	SIMD::Vec3f pos = globalMatrix.GetTranslation();
 	auto distance = SIMD::Vec3f::Dot(pos - SIMD::Vec3f(drawParameter.CameraPosition), SIMD::Vec3f(drawParameter.CameraFrontDirection));
 	if (container->m_pEffectNode->DepthValues.DepthParameter.DepthClipping < distance)
 	{
@@ -1786,7 +2118,7 @@ void ManagerImplemented::Draw(const Manager::DrawParameter& drawParameter)
 			{
 				for (auto& c : drawSet.GlobalPointer->RenderedInstanceContainers)
 				{
-					if (IsClippedWithDepth(drawSet, c, drawParameter))
+					if (IsClippedWithDepth(drawSet.GetGlobalMatrix(), c, drawParameter))
 						continue;
 
 					c->Draw(false);
@@ -1818,6 +2150,8 @@ void ManagerImplemented::Draw(const Manager::DrawParameter& drawParameter)
 		}
 	}
 
+	DrawInstancedEffects(drawParameter, cullingPlanes, true, true);
+
 	if (m_gpuTimer != nullptr)
 	{
 		m_gpuTimer->EndFrame();
@@ -1849,7 +2183,7 @@ void ManagerImplemented::DrawBack(const Manager::DrawParameter& drawParameter)
 			auto e = (EffectImplemented*)drawSet.ParameterPointer.Get();
 			for (int32_t j = 0; j < e->renderingNodesThreshold; j++)
 			{
-				if (IsClippedWithDepth(drawSet, drawSet.GlobalPointer->RenderedInstanceContainers[j], drawParameter))
+				if (IsClippedWithDepth(drawSet.GetGlobalMatrix(), drawSet.GlobalPointer->RenderedInstanceContainers[j], drawParameter))
 					continue;
 
 				drawSet.GlobalPointer->RenderedInstanceContainers[j]->Draw(false);
@@ -1876,6 +2210,8 @@ void ManagerImplemented::DrawBack(const Manager::DrawParameter& drawParameter)
 		}
 	}
 
+	DrawInstancedEffects(drawParameter, cullingPlanes, true, false);
+
 	// calculate a time
 	m_drawTime = (int)(Effekseer::GetTime() - beginTime);
 }
@@ -1909,7 +2245,7 @@ void ManagerImplemented::DrawFront(const Manager::DrawParameter& drawParameter)
 				auto e = (EffectImplemented*)drawSet.ParameterPointer.Get();
 				for (size_t j = e->renderingNodesThreshold; j < drawSet.GlobalPointer->RenderedInstanceContainers.size(); j++)
 				{
-					if (IsClippedWithDepth(drawSet, drawSet.GlobalPointer->RenderedInstanceContainers[j], drawParameter))
+					if (IsClippedWithDepth(drawSet.GetGlobalMatrix(), drawSet.GlobalPointer->RenderedInstanceContainers[j], drawParameter))
 						continue;
 
 					drawSet.GlobalPointer->RenderedInstanceContainers[j]->Draw(false);
@@ -1941,6 +2277,8 @@ void ManagerImplemented::DrawFront(const Manager::DrawParameter& drawParameter)
 		}
 	}
 
+	DrawInstancedEffects(drawParameter, cullingPlanes, false, true);
+
 	if (m_gpuTimer != nullptr)
 	{
 		m_gpuTimer->EndFrame();
@@ -2002,6 +2340,38 @@ Handle ManagerImplemented::Play(const EffectRef& effect, const Vector3D& positio
 	return handle;
 }
 
+void ManagerImplemented::PlayInstanced(const EffectRef& effect, const Matrix43& transform, int32_t randomSeed)
+{
+	if (effect == nullptr)
+		return;
+
+	auto e = effect->GetImplemented();
+
+	if (randomSeed < 0)
+	{
+		randomSeed = e->m_defaultRandomSeed >= 0 ? e->m_defaultRandomSeed : GetRandFunc()();
+	}
+
+	// an instance is created in Flip in the same way as Play
+	RequestedInstancedSpawn request;
+	request.ParameterPointer = effect;
+	request.GlobalMatrix = transform;
+	request.RandomSeed = randomSeed;
+	requestedInstancedSpawns_.emplace_back(request);
+}
+
+int32_t ManagerImplemented::GetInstancedEffectCount() const
+{
+	int32_t count = static_cast<int32_t>(requestedInstancedSpawns_.size());
+
+	for (const auto& instancedEffect : instancedEffects_)
+	{
+		count += static_cast<int32_t>(instancedEffect.Spawns.size());
+	}
+
+	return count;
+}
+
 int ManagerImplemented::GetCameraCullingMaskToShowAllEffects()
 {
 	int mask = 0;
@@ -2042,7 +2412,7 @@ void ManagerImplemented::DrawHandle(Handle handle, const Manager::DrawParameter&
 		{
 			for (auto& c : drawSet.GlobalPointer->RenderedInstanceContainers)
 			{
-				if (IsClippedWithDepth(drawSet, c, drawParameter))
+				if (IsClippedWithDepth(drawSet.GetGlobalMatrix(), c, drawParameter))
 					continue;
 
 				c->Draw(false);
@@ -2083,7 +2453,7 @@ void ManagerImplemented::DrawHandleBack(Handle handle, const Manager::DrawParame
 
 		for (int32_t i = 0; i < e->renderingNodesThreshold; i++)
 		{
-			if (IsClippedWithDepth(drawSet, drawSet.GlobalPointer->RenderedInstanceContainers[i], drawParameter))
+			if (IsClippedWithDepth(drawSet.GetGlobalMatrix(), drawSet.GlobalPointer->RenderedInstanceContainers[i], drawParameter))
 				continue;
 
 			drawSet.GlobalPointer->RenderedInstanceContainers[i]->Draw(false);
@@ -2121,7 +2491,7 @@ void ManagerImplemented::DrawHandleFront(Handle handle, const Manager::DrawParam
 		{
 			for (size_t i = e->renderingNodesThreshold; i < drawSet.GlobalPointer->RenderedInstanceContainers.size(); i++)
 			{
-				if (IsClippedWithDepth(drawSet, drawSet.GlobalPointer->RenderedInstanceContainers[i], drawParameter))
+				if (IsClippedWithDepth(drawSet.GetGlobalMatrix(), drawSet.GlobalPointer->RenderedInstanceContainers[i], drawParameter))
 					continue;
 
 				drawSet.GlobalPointer->RenderedInstanceContainers[i]->Draw(false);
@@ -2211,6 +2581,18 @@ void ManagerImplemented::BeginReloadEffect(const EffectRef& effect, bool doLockT
 		// dispose instances
 		StopWithoutRemoveDrawSet(it.second);
 	}
+
+	// instanced effects are not played again because they are not controlled after played
+	for (auto& instancedEffect : instancedEffects_)
+	{
+		if (instancedEffect.ParameterPointer != effect)
+			continue;
+
+		// pooled containers are also released because they are created from nodes before reloading
+		ReleaseInstancedEffect(instancedEffect);
+	}
+
+	RemoveEmptyInstancedEffects();
 }
 
 void ManagerImplemented::EndReloadEffect(const EffectRef& effect, bool doLockThread)
@@ -2267,37 +2649,31 @@ void ManagerImplemented::RequestToPlaySound(Instance* instance, const EffectNode
 		parameter.Distance = node->Sound.Distance;
 		parameter.UserData = instanceGlobal->GetUserData();
 
-		std::lock_guard<std::mutex> lock(m_soundMutex);
-		m_requestedSounds.emplace(static_cast<SoundTag>(instanceGlobal), parameter);
+		// a sound is dropped if too many sounds are requested in an update
+		m_requestedSounds.TryPush(std::make_pair(static_cast<SoundTag>(instanceGlobal), parameter));
 	}
 }
 
 void ManagerImplemented::ExecuteSounds()
 {
-	if (m_requestedSounds.empty())
+	if (m_requestedSounds.IsEmpty())
 	{
 		return;
 	}
 
-	std::lock_guard<std::mutex> lock(m_soundMutex);
-
 	auto player = GetSoundPlayer();
-	if (player != nullptr)
+
+	std::pair<SoundTag, SoundPlayer::InstanceParameter> sound;
+	while (m_requestedSounds.TryPop(sound))
 	{
-		while (!m_requestedSounds.empty())
+		if (player != nullptr)
 		{
-			auto sound = m_requestedSounds.back();
 			player->Play(sound.first, sound.second);
-			m_requestedSounds.pop();
-		}
-	}
-	else
-	{
-		while (!m_requestedSounds.empty())
-		{
-			m_requestedSounds.pop();
 		}
 	}
+
+	// release a reference to sound data
+	sound.second.Data.Reset();
 }
 
 } // namespace Effekseer
@@ -889,6 +889,44 @@ public:
 	*/
 	virtual Handle Play(const EffectRef& effect, const Vector3D& position, int32_t startFrame = 0) = 0;
 
+	/**
+		@brief
+		\~English	Play an effect which is not controlled after it is played.
+		\~Japanese	再生後に操作しないエフェクトを再生する。
+		@param	effect
+		\~English	Played effect
+		\~Japanese	再生されるエフェクト
+		@param	transform
+		\~English	A transform of the effect
+		\~Japanese	エフェクトの変換行列
+		@param	randomSeed
+		\~English	A seed of random numbers. If it is negative, a seed is decided in the same way as Play.
+		\~Japanese	乱数のシード。負の場合、Playと同じ方法でシードが決定される。
+		@note
+		\~English
+		It is suitable for short effects which are played many times, like hit sparks.
+		The effect has no handle and is removed automatically when it finishes.
+		Effects played with this function are updated, removed and drawn together for each Effect, so the cost per an effect is lower than Play.
+		They are always drawn on layer 0 after effects played with Play, and are not sorted even if IsSortingEffectsEnabled is true.
+		They are paused by SetPausedToAllEffects, but are not affected by functions for handles or groups, like SetSpeed, SetTimeScaleByGroup and SetLayer.
+		Instances of finished effects are kept for each Effect and reused by next effects until all effects of the Effect finish.
+		\~Japanese
+		ヒットエフェクトのように何度も再生される短いエフェクトに適している。
+		エフェクトはハンドルを持たず、終了した時に自動的に削除される。
+		この関数で再生されたエフェクトはEffectごとにまとめて更新、削除、描画されるため、エフェクトあたりの負荷がPlayより小さい。
+		これらは常にレイヤー0で、Playで再生されたエフェクトの後に描画され、IsSortingEffectsEnabledがtrueでもソートされない。
+		SetPausedToAllEffectsで一時停止されるが、SetSpeed、SetTimeScaleByGroup、SetLayerのようなハンドルやグループに対する関数の影響は受けない。
+		終了したエフェクトのインスタンスはEffectごとに保持され、そのEffectのエフェクトが全て終了するまで次のエフェクトで再利用される。
+	*/
+	virtual void PlayInstanced(const EffectRef& effect, const Matrix43& transform, int32_t randomSeed = -1) = 0;
+
+	/**
+		@brief
+		\~English	Get the number of effects which are played with PlayInstanced and still exist.
+		\~Japanese	PlayInstancedで再生され、まだ存在しているエフェクトの数を取得する。
+	*/
+	virtual int32_t GetInstancedEffectCount() const = 0;
+
 	/**
 		@brief
 		\~English	Get a camera's culling mask to show all effects
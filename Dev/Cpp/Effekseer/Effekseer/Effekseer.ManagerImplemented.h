@@ -11,6 +11,7 @@
 #include "Effekseer.WorkerThread.h"
 #include "Geometry/GeometryUtility.h"
 #include "Utils/Effekseer.CustomAllocator.h"
+#include "Utils/Effekseer.LockFreeQueue.h"
 
 namespace Effekseer
 {
@@ -114,6 +115,37 @@ public:
 		SIMD::Mat43f GlobalMatrix;
 	};
 
+	//! an effect played with PlayInstanced. It has no handle and is removed when it finishes.
+	struct InstancedSpawn
+	{
+		InstanceGlobal* GlobalPointer = nullptr;
+		InstanceContainer* InstanceContainerPointer = nullptr;
+		SIMD::Mat43f GlobalMatrix;
+		Vector3D CullingPosition{};
+		float CullingRadius{};
+	};
+
+	//! spawns of the same effect. They are updated, removed and drawn together.
+	struct InstancedEffect
+	{
+		EffectRef ParameterPointer;
+		CustomAlignedVector<InstancedSpawn> Spawns;
+
+		//! finished spawns whose InstanceGlobal and containers are kept to be reused by next spawns
+		CustomAlignedVector<InstancedSpawn> PooledSpawns;
+	};
+
+	//! the maximum number of finished spawns which are kept for each effect
+	static const int32_t InstancedSpawnPoolMaxCount = 32;
+
+	//! a spawn which is requested with PlayInstanced and is initialized in Flip
+	struct RequestedInstancedSpawn
+	{
+		EffectRef ParameterPointer;
+		SIMD::Mat43f GlobalMatrix;
+		int32_t RandomSeed;
+	};
+
 private:
 	CustomVector<WorkerThread> m_WorkerThreads;
 
@@ -188,18 +220,65 @@ private:
 
 	std::array<LayerParameter, LayerCount> m_layerParameters;
 
-	std::queue<std::pair<SoundTag, SoundPlayer::InstanceParameter>> m_requestedSounds;
-	std::mutex m_soundMutex;
+	//! effects played with PlayInstanced
+	CustomVector<InstancedEffect> instancedEffects_;
+
+	//! indexes of instancedEffects_ by effects
+	CustomUnorderedMap<const Effect*, int32_t> instancedEffectIndexes_;
+
+	//! spawns which are waiting to be initialized
+	CustomAlignedVector<RequestedInstancedSpawn> requestedInstancedSpawns_;
+
+	//! a time (by 1/60) to progress instanced effects when Update is called
+	float instancedNextUpdateFrame_ = 0.0f;
+
+	//! whether all instanced effects are removed in next Flip
+	bool isInstancedEffectsStopRequested_ = false;
+
+	//! whether instanced effects are paused with SetPausedToAllEffects
+	bool isInstancedEffectsPaused_ = false;
+
+	//! spawns which pass culling while drawing (temporal)
+	CustomVector<const InstancedSpawn*> visibleInstancedSpawns_;
+
+	//! the maximum number of sounds which can be requested in an update
+	static const uint32_t RequestedSoundCapacity = 1024;
+
+	//! sounds requested from update threads. It does not allocate memory nor lock while playing effects.
+	LockFreeQueue<std::pair<SoundTag, SoundPlayer::InstanceParameter>> m_requestedSounds;
 
 	Handle AddDrawSet(const EffectRef& effect, InstanceContainer* pInstanceContainer, InstanceGlobal* pGlobalPointer);
 
 	void StopStoppingEffects();
 
+	//! whether an effect finished and can be removed
+	bool IsFinished(InstanceGlobal* global, InstanceContainer* rootContainer);
+
+	//! initialize spawns requested with PlayInstanced
+	void InitializeInstancedSpawns();
+
+	//! remove finished spawns. All spawns are removed if isRemovingAll is true.
+	void GCInstancedEffects(bool isRemovingAll);
+
+	void ReleaseInstancedSpawn(InstancedSpawn& spawn);
+
+	//! release all spawns of an effect including pooled ones
+	void ReleaseInstancedEffect(InstancedEffect& instancedEffect);
+
+	//! remove effects which have no spawns and update indexes
+	void RemoveEmptyInstancedEffects();
+
+	void UpdateInstancedEffects();
+
+	void DrawInstancedEffects(const Manager::DrawParameter& drawParameter, const std::array<Plane, 6>& planes, bool drawsBack, bool drawsFront);
+
 	//! GC Draw sets
 	void GCDrawSet(bool isRemovingManager);
 
 	static int Rand();
 
+	static int CalculateLevelOfDetails(const EffectImplemented* effect, const SIMD::Vec3f& position, const LayerParameter& loadParameter);
+
 	void ExecuteEvents();
 
 	void ExecuteSounds();
@@ -222,6 +301,9 @@ public:
 	CreateInstanceContainer(EffectNode* pEffectNode, InstanceGlobal* pGlobal, bool isRoot, const SIMD::Mat43f& rootMatrix, Instance* pParent);
 	void ReleaseInstanceContainer(InstanceContainer* container);
 
+	//! create a root instance in a root container which has no instances
+	bool CreateRootInstance(InstanceContainer* pContainer, InstanceGlobal* pGlobal, const SIMD::Mat43f& rootMatrix);
+
 	void LaunchWorkerThreads(uint32_t threadCount) override;
 
 	ThreadNativeHandleType GetWorkerThreadHandle(uint32_t threadID) override;
@@ -404,10 +486,12 @@ private:
 	//! update draw sets
 	void UpdateHandleInternal(DrawSet& drawSet);
 
+	void UpdateGlobalDynamicEquations(EffectImplemented* effect, InstanceGlobal* global);
+
 	void Preupdate(DrawSet& drawSet);
 
 	//! whether container is disabled while rendering because of a distance between the effect and a camera
-	bool IsClippedWithDepth(DrawSet& drawSet, InstanceContainer* container, const Manager::DrawParameter& drawParameter);
+	bool IsClippedWithDepth(const SIMD::Mat43f& globalMatrix, InstanceContainer* container, const Manager::DrawParameter& drawParameter);
 
 	void StopWithoutRemoveDrawSet(DrawSet& drawSet);
 
@@ -432,6 +516,10 @@ public:
 
 	Handle Play(const EffectRef& effect, const Vector3D& position, int32_t startFrame) override;
 
+	void PlayInstanced(const EffectRef& effect, const Matrix43& transform, int32_t randomSeed) override;
+
+	int32_t GetInstancedEffectCount() const override;
+
 	int GetCameraCullingMaskToShowAllEffects() override;
 
 	int GetUpdateTime() const override;
@@ -144,7 +144,10 @@ public:
 	private:
 		bool isCacheEnabled_ = true;
 		LOADER loader_;
-		CustomMap<PARAMETER, GenerateCounted<PARAMETER, RESOURCE>> cached_;
+		CustomUnorderedMap<PARAMETER, GenerateCounted<PARAMETER, RESOURCE>, typename PARAMETER::Hash> cached_;
+
+		//! to find a parameter from a generated resource without scanning cached_
+		CustomUnorderedMap<const void*, PARAMETER> parameters_;
 
 	public:
 		bool GetIsCacheEnabled() const
@@ -185,6 +188,7 @@ public:
 					if (resource != nullptr)
 					{
 						cached_.emplace(parameter, GenerateCounted<PARAMETER, RESOURCE>{parameter, resource, 1});
+						parameters_.emplace(resource.Get(), parameter);
 						return resource;
 					}
 				}
@@ -200,13 +204,19 @@ public:
 		{
 			if (loader_ != nullptr && resource != nullptr)
 			{
-				auto it = std::find_if(cached_.begin(), cached_.end(), [&](const std::pair<PARAMETER, GenerateCounted<PARAMETER, RESOURCE>>& v)
-									   { return v.second.resource == resource; });
-				if (it != cached_.end())
+				auto itParam = parameters_.find(resource.Get());
+				if (itParam == parameters_.end())
+				{
+					return;
+				}
+
+				auto it = cached_.find(itParam->second);
+				if (it != cached_.end() && it->second.resource == resource)
 				{
 					if (--it->second.loadCount <= 0)
 					{
 						cached_.erase(it);
+						parameters_.erase(itParam);
 						loader_->Ungenerate(resource);
 					}
 				}
@@ -231,6 +241,7 @@ public:
 				else
 				{
 					cached_.emplace(parameter, GenerateCounted<PARAMETER, RESOURCE>{parameter, resource, 1});
+					parameters_.emplace(resource.Get(), parameter);
 				}
 			}
 		}
@@ -22,6 +22,7 @@
 #include "Effekseer.Effect.h"
 #include "Effekseer.ResourceManager.h"
 #include "IO/Effekseer.EfkEfcFactory.h"
+#include "IO/Effekseer.EfkRuntimeFactory.h"
 
 //----------------------------------------------------------------------------------
 //
@@ -42,6 +43,9 @@ Setting::Setting()
 	auto efkefcFactory = MakeRefPtr<EfkEfcFactory>();
 	AddEffectFactory(efkefcFactory);
 
+	auto efkRuntimeFactory = MakeRefPtr<EfkRuntimeFactory>();
+	AddEffectFactory(efkRuntimeFactory);
+
 	resourceManager_ = MakeRefPtr<ResourceManager>();
 	resourceManager_->SetProceduralMeshGenerator(MakeRefPtr<ProceduralModelGenerator>());
 }
@@ -92,6 +92,16 @@ public:
 	{
 		data.Reset();
 	}
+
+	/**
+		@brief
+		\~English	Get whether Load with data can be called from multiple threads at the same time. If it is true, EffectBatchLoader calls it on worker threads.
+		\~Japanese	データを引数とするLoadを複数のスレッドから同時に呼べるかどうかを取得する。trueの場合、EffectBatchLoaderはワーカースレッドで呼ぶ。
+	*/
+	virtual bool GetIsThreadSafe() const
+	{
+		return false;
+	}
 };
 
 //----------------------------------------------------------------------------------
@@ -60,6 +60,12 @@ void WorkerThread::Launch()
 //----------------------------------------------------------------------------------
 void WorkerThread::Shutdown()
 {
+	// it is also called from the destructor after Shutdown
+	if (!m_Thread.joinable())
+	{
+		return;
+	}
+
 	m_QuitRequested.store(true);
 	m_TaskRequestCV.notify_one();
 	m_Thread.join();
@@ -87,6 +93,39 @@ void WorkerThread::WaitForComplete()
 	m_Task = nullptr;
 }
 
+void RunParallelFor(WorkerThread* threads, int32_t threadCount, int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task)
+{
+	const int32_t maxTaskCount = threadCount + 1;
+	const int32_t taskCount = Clamp((count + minCountPerTask - 1) / Max(minCountPerTask, 1), maxTaskCount, 1);
+
+	if (taskCount <= 1)
+	{
+		task(0, count);
+		return;
+	}
+
+	const int32_t countPerTask = (count + taskCount - 1) / taskCount;
+
+	for (int32_t i = 1; i < taskCount; i++)
+	{
+		const int32_t begin = countPerTask * i;
+		const int32_t end = Min(begin + countPerTask, count);
+		threads[i - 1].RunAsync([&task, begin, end]() {
+			if (begin < end)
+			{
+				task(begin, end);
+			}
+		});
+	}
+
+	task(0, Min(countPerTask, count));
+
+	for (int32_t i = 1; i < taskCount; i++)
+	{
+		threads[i - 1].WaitForComplete();
+	}
+}
+
 //----------------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------------
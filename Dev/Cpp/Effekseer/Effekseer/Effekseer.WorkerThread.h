@@ -61,6 +61,16 @@ public:
 	void WaitForComplete();
 };
 
+/**
+	@brief	run task(begin, end) for ranges of [0, count) on worker threads and the calling thread, and wait for them
+	@param	threads	launched worker threads
+	@param	threadCount	the number of threads
+	@param	count	the number of elements
+	@param	minCountPerTask	the minimum number of elements in a task. elements are not divided more than it.
+	@param	task	a task which is called with a range
+*/
+void RunParallelFor(WorkerThread* threads, int32_t threadCount, int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task);
+
 //----------------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------------
@@ -0,0 +1,116 @@
+#include "Effekseer.EfkRuntimeFactory.h"
+#include "../Effekseer.EffectImplemented.h"
+#include "../Utils/Effekseer.Hash.h"
+#include "Effekseer.EfkEfcFactory.h"
+
+namespace Effekseer
+{
+
+EfkRuntimeFile::EfkRuntimeFile(const void* data, int32_t size)
+	: data_(static_cast<const uint8_t*>(data))
+	, size_(size)
+{
+	if (!CheckMagic(data, size) || size < static_cast<int32_t>(sizeof(Header)))
+		return;
+
+	memcpy(&header_, data_, sizeof(Header));
+
+	if (header_.FormatVersion != FormatVersion)
+		return;
+
+	if (header_.BodyOffset < static_cast<int32_t>(sizeof(Header)) || header_.BodyOffset % BodyAlignment != 0)
+		return;
+
+	if (header_.BodySize < 8 || header_.BodySize > size_ - header_.BodyOffset)
+		return;
+
+	if (header_.BinaryVersion > EffectImplemented::SupportBinaryVersion)
+		return;
+
+	const auto body = data_ + header_.BodyOffset;
+	if (memcmp(body, "SKFE", 4) != 0)
+		return;
+
+	// the body hash is not checked here because hashing the whole body makes loading slower than efkefc
+	isValid_ = true;
+}
+
+bool EfkRuntimeFile::VerifyBodyHash() const
+{
+	return isValid_ && CalculateHash(data_ + header_.BodyOffset, static_cast<size_t>(header_.BodySize)) == header_.BodyHash;
+}
+
+bool EfkRuntimeFile::CheckMagic(const void* data, int32_t size)
+{
+	return data != nullptr && size >= 4 && memcmp(data, "EFKR", 4) == 0;
+}
+
+bool EfkRuntimeFile::Cook(std::vector<uint8_t>& dst, const void* data, int32_t size, float magnification)
+{
+	const uint8_t* body = nullptr;
+	int32_t bodySize = 0;
+
+	EfkEfcFile efkefc(data, size);
+	if (efkefc.IsValid())
+	{
+		const auto chunk = efkefc.ReadRuntimeData();
+		body = static_cast<const uint8_t*>(chunk.data);
+		bodySize = chunk.size;
+	}
+	else if (size >= 8 && memcmp(data, "SKFE", 4) == 0)
+	{
+		body = static_cast<const uint8_t*>(data);
+		bodySize = size;
+	}
+
+	if (body == nullptr || bodySize < 8 || memcmp(body, "SKFE", 4) != 0)
+	{
+		return false;
+	}
+
+	int32_t binaryVersion = 0;
+	memcpy(&binaryVersion, body + 4, sizeof(int32_t));
+	if (binaryVersion > EffectImplemented::SupportBinaryVersion)
+	{
+		return false;
+	}
+
+	Header header;
+	memcpy(header.Magic, "EFKR", 4);
+	header.FormatVersion = FormatVersion;
+	header.BinaryVersion = binaryVersion;
+	header.BodyOffset = (static_cast<int32_t>(sizeof(Header)) + BodyAlignment - 1) / BodyAlignment * BodyAlignment;
+	header.BodySize = bodySize;
+	header.Magnification = magnification;
+	header.BodyHash = CalculateHash(body, static_cast<size_t>(bodySize));
+
+	dst.assign(header.BodyOffset + bodySize, 0);
+	memcpy(dst.data(), &header, sizeof(Header));
+	memcpy(dst.data() + header.BodyOffset, body, bodySize);
+	return true;
+}
+
+bool EfkRuntimeFactory::OnLoading(Effect* effect, const void* data, int32_t size, float magnification, const char16_t* materialPath)
+{
+	EfkRuntimeFile file(data, size);
+
+	if (!file.IsValid())
+	{
+		return false;
+	}
+
+	return LoadBody(effect, file.GetBody(), file.GetBodySize(), magnification * file.GetHeader().Magnification, materialPath);
+}
+
+bool EfkRuntimeFactory::OnCheckIsBinarySupported(const void* data, int32_t size)
+{
+	return EfkRuntimeFile::CheckMagic(data, size);
+}
+
+const char* EfkRuntimeFactory::GetName() const
+{
+	static const char* name = "Runtime";
+	return name;
+}
+
+} // namespace Effekseer
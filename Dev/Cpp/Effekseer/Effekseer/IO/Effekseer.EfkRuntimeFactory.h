@@ -0,0 +1,105 @@
+#ifndef __EFFEKSEER_EFK_RUNTIME_FACTORY_H__
+#define __EFFEKSEER_EFK_RUNTIME_FACTORY_H__
+
+#include "../Effekseer.Effect.h"
+#include <vector>
+
+namespace Effekseer
+{
+
+/**
+	@brief	a compact effect format which contains only data used at runtime
+
+	@note
+	It is cooked offline from efkefc or efk. Editor data is removed and the body is aligned so that it can be passed to the loader without copying.
+	Magnification specified when cooking is applied when the effect is loaded.
+	Only the magic, versions and sizes are validated when loading. The body hash is written by the cooker and checked by tools with VerifyBodyHash.
+	The body is parsed by the same path as efkefc, so this format reduces the size of files but not the time to load them.
+*/
+class EfkRuntimeFile
+{
+public:
+	static const int32_t FormatVersion = 2;
+	static const int32_t BodyAlignment = 16;
+
+	struct Header
+	{
+		char Magic[4];
+		int32_t FormatVersion;
+		int32_t BinaryVersion;
+		int32_t BodyOffset;
+		int32_t BodySize;
+		float Magnification;
+
+		//! a 64bit FNV-1a hash of the body
+		uint64_t BodyHash;
+	};
+
+private:
+	const uint8_t* data_ = nullptr;
+	int32_t size_ = 0;
+	Header header_ = {};
+	bool isValid_ = false;
+
+public:
+	explicit EfkRuntimeFile(const void* data, int32_t size);
+
+	bool IsValid() const
+	{
+		return isValid_;
+	}
+
+	const Header& GetHeader() const
+	{
+		return header_;
+	}
+
+	const void* GetBody() const
+	{
+		return data_ + header_.BodyOffset;
+	}
+
+	int32_t GetBodySize() const
+	{
+		return header_.BodySize;
+	}
+
+	/**
+		@brief	Check whether the body is same as the body when it was cooked
+		@note
+		It reads the whole body, so it is not called when the effect is loaded.
+	*/
+	bool VerifyBodyHash() const;
+
+	/**
+		@brief	Check whether data starts with the magic of this format
+	*/
+	static bool CheckMagic(const void* data, int32_t size);
+
+	/**
+		@brief	Cook efkefc or efk into this format
+		@param	dst	cooked data
+		@param	data	efkefc or efk
+		@param	size	the size of data
+		@param	magnification	magnification which is applied when the effect is loaded
+		@return	false if data is not supported
+	*/
+	static bool Cook(std::vector<uint8_t>& dst, const void* data, int32_t size, float magnification = 1.0f);
+};
+
+/**
+	@brief a factory for cooked runtime effect format
+*/
+class EfkRuntimeFactory : public EffectFactory
+{
+public:
+	bool OnLoading(Effect* effect, const void* data, int32_t size, float magnification, const char16_t* materialPath) override;
+
+	bool OnCheckIsBinarySupported(const void* data, int32_t size) override;
+
+	const char* GetName() const override;
+};
+
+} // namespace Effekseer
+
+#endif
@@ -4,11 +4,45 @@
 namespace Effekseer
 {
 
+//! find an element which has same values as data in sets, or add data into sets, and return the index of it
+template <typename SET, typename T, typename GETTER>
+static int32_t FindOrAddUnique(CustomVector<SET>& sets, CustomUnorderedMap<uint64_t, int32_t>& indexes, const T* data, int32_t count, GETTER getter)
+{
+	const auto size = sizeof(T) * count;
+	const auto hash = CalculateHash(data, size);
+
+	auto it = indexes.find(hash);
+	if (it != indexes.end())
+	{
+		const auto& found = getter(sets[it->second]);
+		if (found.size() == static_cast<size_t>(count) && (size == 0 || memcmp(found.data(), data, size) == 0))
+		{
+			return it->second;
+		}
+	}
+
+	const auto index = static_cast<int32_t>(sets.size());
+	sets.emplace_back();
+
+	auto& added = getter(sets.back());
+	added.resize(count);
+	if (size > 0)
+	{
+		memcpy(added.data(), data, size);
+	}
+
+	// when hashes collide, the latest one is found
+	indexes[hash] = index;
+	return index;
+}
+
 Model::Model(const CustomVector<Vertex>& vertecies, const CustomVector<Face>& faces)
 {
 	models_.resize(1);
-	models_[0].vertexes = vertecies;
-	models_[0].faces = faces;
+	vertexes_.resize(1);
+	faces_.resize(1);
+	vertexes_[0].vertexes = vertecies;
+	faces_[0].faces = faces;
 }
 
 Model::Model(const void* data, int32_t size)
@@ -16,6 +50,8 @@ Model::Model(const void* data, int32_t size)
 	if (data == nullptr)
 	{
 		models_.resize(1);
+		vertexes_.resize(1);
+		faces_.resize(1);
 		return;
 	}
 
@@ -34,6 +70,8 @@ Model::Model(const void* data, int32_t size)
 	if (version_ > LastetVersion)
 	{
 		models_.resize(1);
+		vertexes_.resize(1);
+		faces_.resize(1);
 		return;
 	}
 
@@ -52,35 +90,43 @@ Model::Model(const void* data, int32_t size)
 
 	models_.resize(frameCount);
 
+	// vertex animations often repeat same faces and same vertexes between frames, so they are shared
+	CustomUnorderedMap<uint64_t, int32_t> vertexesIndexes;
+	CustomUnorderedMap<uint64_t, int32_t> facesIndexes;
+	auto getVertexes = [](InternalVertexes& v) -> CustomVector<Vertex>& { return v.vertexes; };
+	auto getFaces = [](InternalFaces& v) -> CustomVector<Face>& { return v.faces; };
+
 	for (int32_t f = 0; f < frameCount; f++)
 	{
 		int32_t vertexCount = 0;
 		memcpy(&vertexCount, p, sizeof(int32_t));
 		p += sizeof(int32_t);
 
-		models_[f].vertexes.resize(vertexCount);
-
 		if (version_ >= 1)
 		{
-			memcpy(models_[f].vertexes.data(), p, sizeof(Vertex) * vertexCount);
+			models_[f].vertexesIndex = FindOrAddUnique(vertexes_, vertexesIndexes, reinterpret_cast<const Vertex*>(p), vertexCount, getVertexes);
 			p += sizeof(Vertex) * vertexCount;
 		}
 		else
 		{
+			CustomVector<Vertex> vertexes;
+			vertexes.resize(vertexCount);
+
 			for (int32_t i = 0; i < vertexCount; i++)
 			{
-				memcpy((void*)&models_[f].vertexes[i], p, sizeof(Vertex) - sizeof(Color));
-				models_[f].vertexes[i].VColor = Color(255, 255, 255, 255);
+				memcpy((void*)&vertexes[i], p, sizeof(Vertex) - sizeof(Color));
+				vertexes[i].VColor = Color(255, 255, 255, 255);
 				p += sizeof(Vertex) - sizeof(Color);
 			}
+
+			models_[f].vertexesIndex = FindOrAddUnique(vertexes_, vertexesIndexes, vertexes.data(), vertexCount, getVertexes);
 		}
 
 		int32_t faceCount = 0;
 		memcpy(&faceCount, p, sizeof(int32_t));
 		p += sizeof(int32_t);
 
-		models_[f].faces.resize(faceCount);
-		memcpy(models_[f].faces.data(), p, sizeof(Face) * faceCount);
+		models_[f].facesIndex = FindOrAddUnique(faces_, facesIndexes, reinterpret_cast<const Face*>(p), faceCount, getFaces);
 		p += sizeof(Face) * faceCount;
 	}
 }
@@ -89,39 +135,219 @@ Model ::~Model()
 {
 }
 
+void Model::GenerateSamplersIfRequired()
+{
+	// emitters are got from multiple threads when the manager updates with worker threads
+	std::call_once(samplersGenerated_, [this]() { GenerateSamplers(); });
+}
+
+void Model::GenerateSamplers()
+{
+	// frames which share vertexes and faces share a sampler too
+	CustomUnorderedMap<uint64_t, int32_t> samplerIndexes;
+
+	for (auto& model : models_)
+	{
+		const auto key = (static_cast<uint64_t>(model.vertexesIndex) << 32) | static_cast<uint32_t>(model.facesIndex);
+		auto it = samplerIndexes.find(key);
+		if (it != samplerIndexes.end())
+		{
+			model.samplerIndex = it->second;
+			continue;
+		}
+
+		model.samplerIndex = static_cast<int32_t>(samplers_.size());
+		samplerIndexes[key] = model.samplerIndex;
+		samplers_.emplace_back();
+
+		const auto& vertexes = vertexes_[model.vertexesIndex].vertexes;
+		const auto& faces = faces_[model.facesIndex].faces;
+		auto& sampler = samplers_.back();
+
+		const auto faceCount = static_cast<int32_t>(faces.size());
+		sampler.triangles.resize(faceCount);
+		sampler.probabilities.resize(faceCount);
+		sampler.aliases.resize(faceCount);
+
+		CustomVector<float> areas;
+		areas.resize(faceCount);
+		float totalArea = 0.0f;
+
+		for (int32_t i = 0; i < faceCount; i++)
+		{
+			auto& triangle = sampler.triangles[i];
+			bool isValid = true;
+
+			for (int32_t j = 0; j < 3; j++)
+			{
+				const auto index = faces[i].Indexes[j];
+				if (index < 0 || static_cast<size_t>(index) >= vertexes.size())
+				{
+					isValid = false;
+					break;
+				}
+
+				const auto& v = vertexes[index];
+				triangle[j].Position = v.Position;
+				triangle[j].Normal = v.Normal;
+				triangle[j].Binormal = v.Binormal;
+				triangle[j].Tangent = v.Tangent;
+			}
+
+			if (!isValid)
+			{
+				triangle = {};
+				areas[i] = 0.0f;
+				continue;
+			}
+
+			Vector3D cross;
+			Vector3D::Cross(cross, triangle[1].Position - triangle[0].Position, triangle[2].Position - triangle[0].Position);
+			areas[i] = Vector3D::Length(cross) * 0.5f;
+			totalArea += areas[i];
+		}
+
+		// a mesh whose faces are all degenerated is sampled uniformly by faces
+		if (totalArea <= 0.0f)
+		{
+			std::fill(areas.begin(), areas.end(), 1.0f);
+			totalArea = static_cast<float>(faceCount);
+		}
+
+		// Vose's alias method
+		CustomVector<int32_t> smalls;
+		CustomVector<int32_t> larges;
+		smalls.reserve(faceCount);
+		larges.reserve(faceCount);
+
+		for (int32_t i = 0; i < faceCount; i++)
+		{
+			areas[i] = areas[i] * faceCount / totalArea;
+			if (areas[i] < 1.0f)
+			{
+				smalls.emplace_back(i);
+			}
+			else
+			{
+				larges.emplace_back(i);
+			}
+		}
+
+		while (!smalls.empty() && !larges.empty())
+		{
+			const auto s = smalls.back();
+			const auto l = larges.back();
+			smalls.pop_back();
+			larges.pop_back();
+
+			sampler.probabilities[s] = areas[s];
+			sampler.aliases[s] = l;
+
+			areas[l] = (areas[l] + areas[s]) - 1.0f;
+			if (areas[l] < 1.0f)
+			{
+				smalls.emplace_back(l);
+			}
+			else
+			{
+				larges.emplace_back(l);
+			}
+		}
+
+		// remaining ones are 1 except errors of floating point numbers
+		for (auto i : smalls)
+		{
+			sampler.probabilities[i] = 1.0f;
+			sampler.aliases[i] = i;
+		}
+
+		for (auto i : larges)
+		{
+			sampler.probabilities[i] = 1.0f;
+			sampler.aliases[i] = i;
+		}
+	}
+}
+
+Model::Emitter Model::SampleFace(const InternalSampler& sampler, IRandObject* g, CoordinateSystem coordinate, float magnification) const
+{
+	const auto faceCount = static_cast<int32_t>(sampler.triangles.size());
+
+	// an integral part selects a column and a fractional part selects a face or its alias
+	const float r = g->GetRand() * faceCount;
+	int32_t faceInd = Clamp(static_cast<int32_t>(r), faceCount - 1, 0);
+	if (r - faceInd >= sampler.probabilities[faceInd])
+	{
+		faceInd = sampler.aliases[faceInd];
+	}
+
+	const auto& triangle = sampler.triangles[faceInd];
+	const Emitter& v0 = triangle[0];
+	const Emitter& v1 = triangle[1];
+	const Emitter& v2 = triangle[2];
+
+	float p1 = g->GetRand();
+	float p2 = g->GetRand();
+
+	// Fit within plane
+	if (p1 + p2 > 1.0f)
+	{
+		p1 = 1.0f - p1;
+		p2 = 1.0f - p2;
+	}
+
+	float p0 = 1.0f - p1 - p2;
+
+	Emitter emitter;
+	emitter.Position = (v0.Position * p0 + v1.Position * p1 + v2.Position * p2) * magnification;
+	emitter.Normal = v0.Normal * p0 + v1.Normal * p1 + v2.Normal * p2;
+	emitter.Binormal = v0.Binormal * p0 + v1.Binormal * p1 + v2.Binormal * p2;
+	emitter.Tangent = v0.Tangent * p0 + v1.Tangent * p1 + v2.Tangent * p2;
+
+	if (coordinate == CoordinateSystem::LH)
+	{
+		emitter.Position.Z = -emitter.Position.Z;
+		emitter.Normal.Z = -emitter.Normal.Z;
+		emitter.Binormal.Z = -emitter.Binormal.Z;
+		emitter.Tangent.Z = -emitter.Tangent.Z;
+	}
+
+	return emitter;
+}
+
 const RefPtr<Backend::VertexBuffer>& Model::GetVertexBuffer(int32_t index) const
 {
-	return models_[index].vertexBuffer;
+	return vertexes_[models_[index].vertexesIndex].vertexBuffer;
 }
 
 const RefPtr<Backend::IndexBuffer>& Model::GetIndexBuffer(int32_t index) const
 {
-	return models_[index].indexBuffer;
+	return faces_[models_[index].facesIndex].indexBuffer;
 }
 
 const RefPtr<Backend::IndexBuffer>& Model::GetWireIndexBuffer(int32_t index) const
 {
-	return models_[index].wireIndexBuffer;
+	return faces_[models_[index].facesIndex].wireIndexBuffer;
 }
 
 const Model::Vertex* Model::GetVertexes(int32_t index) const
 {
-	return models_[index].vertexes.data();
+	return vertexes_[models_[index].vertexesIndex].vertexes.data();
 }
 
 int32_t Model::GetVertexCount(int32_t index) const
 {
-	return static_cast<int32_t>(models_[index].vertexes.size());
+	return static_cast<int32_t>(vertexes_[models_[index].vertexesIndex].vertexes.size());
 }
 
 const Model::Face* Model::GetFaces(int32_t index) const
 {
-	return models_[index].faces.data();
+	return faces_[models_[index].facesIndex].faces.data();
 }
 
 int32_t Model::GetFaceCount(int32_t index) const
 {
-	return static_cast<int32_t>(models_[index].faces.size());
+	return static_cast<int32_t>(faces_[models_[index].facesIndex].faces.size());
 }
 
 int32_t Model::GetFrameCount() const
@@ -129,50 +355,49 @@ int32_t Model::GetFrameCount() const
 	return static_cast<int32_t>(models_.size());
 }
 
+int32_t Model::GetUniqueVertexesCount() const
+{
+	return static_cast<int32_t>(vertexes_.size());
+}
+
+int32_t Model::GetUniqueFacesCount() const
+{
+	return static_cast<int32_t>(faces_.size());
+}
+
 Model::Emitter Model::GetEmitter(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification)
 {
 	time = time % GetFrameCount();
 
-	const auto faceCount = GetFaceCount(time);
-	if (faceCount == 0)
+	GenerateSamplersIfRequired();
+	const auto& sampler = samplers_[models_[time].samplerIndex];
+	if (sampler.triangles.empty())
 	{
 		return GetEmitterFromVertex(g, time, coordinate, magnification);
 	}
 
-	int32_t faceInd = (int32_t)((GetFaceCount(time) - 1) * (g->GetRand()));
-	faceInd = Clamp(faceInd, GetFaceCount(time) - 1, 0);
-	const Face& face = GetFaces(time)[faceInd];
-	const Vertex& v0 = GetVertexes(time)[face.Indexes[0]];
-	const Vertex& v1 = GetVertexes(time)[face.Indexes[1]];
-	const Vertex& v2 = GetVertexes(time)[face.Indexes[2]];
+	return SampleFace(sampler, g, coordinate, magnification);
+}
 
-	float p1 = g->GetRand();
-	float p2 = g->GetRand();
+void Model::GetEmitters(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification, Emitter* emitters, int32_t count)
+{
+	time = time % GetFrameCount();
 
-	// Fit within plane
-	if (p1 + p2 > 1.0f)
+	GenerateSamplersIfRequired();
+	const auto& sampler = samplers_[models_[time].samplerIndex];
+	if (sampler.triangles.empty())
 	{
-		p1 = 1.0f - p1;
-		p2 = 1.0f - p2;
+		for (int32_t i = 0; i < count; i++)
+		{
+			emitters[i] = GetEmitterFromVertex(g, time, coordinate, magnification);
+		}
+		return;
 	}
 
-	float p0 = 1.0f - p1 - p2;
-
-	Emitter emitter;
-	emitter.Position = (v0.Position * p0 + v1.Position * p1 + v2.Position * p2) * magnification;
-	emitter.Normal = v0.Normal * p0 + v1.Normal * p1 + v2.Normal * p2;
-	emitter.Binormal = v0.Binormal * p0 + v1.Binormal * p1 + v2.Binormal * p2;
-	emitter.Tangent = v0.Tangent * p0 + v1.Tangent * p1 + v2.Tangent * p2;
-
-	if (coordinate == CoordinateSystem::LH)
+	for (int32_t i = 0; i < count; i++)
 	{
-		emitter.Position.Z = -emitter.Position.Z;
-		emitter.Normal.Z = -emitter.Normal.Z;
-		emitter.Binormal.Z = -emitter.Binormal.Z;
-		emitter.Tangent.Z = -emitter.Tangent.Z;
+		emitters[i] = SampleFace(sampler, g, coordinate, magnification);
 	}
-
-	return emitter;
 }
 
 Model::Emitter Model::GetEmitterFromVertex(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification)
@@ -323,38 +548,39 @@ bool Model::StoreBufferToGPU(Backend::GraphicsDevice* graphicsDevice, bool flipV
 		return false;
 	}
 
-	for (int32_t f = 0; f < GetFrameCount(); f++)
+	for (auto& v : vertexes_)
 	{
 		if (flipVertexColor)
 		{
-			auto vdata = models_[f].vertexes;
+			auto vdata = v.vertexes;
 
-			for (auto& v : vdata)
+			for (auto& vertex : vdata)
 			{
-				std::swap(v.VColor.R, v.VColor.B);
+				std::swap(vertex.VColor.R, vertex.VColor.B);
 			}
 
-			models_[f].vertexBuffer = graphicsDevice->CreateVertexBuffer(sizeof(Effekseer::Model::Vertex) * GetVertexCount(f), vdata.data(), false);
-			if (models_[f].vertexBuffer == nullptr)
+			v.vertexBuffer = graphicsDevice->CreateVertexBuffer(sizeof(Effekseer::Model::Vertex) * static_cast<int32_t>(vdata.size()), vdata.data(), false);
+			if (v.vertexBuffer == nullptr)
 			{
 				return false;
 			}
 		}
 		else
 		{
-			models_[f].vertexBuffer = graphicsDevice->CreateVertexBuffer(sizeof(Effekseer::Model::Vertex) * GetVertexCount(f), models_[f].vertexes.data(), false);
-			if (models_[f].vertexBuffer == nullptr)
+			v.vertexBuffer = graphicsDevice->CreateVertexBuffer(sizeof(Effekseer::Model::Vertex) * static_cast<int32_t>(v.vertexes.size()), v.vertexes.data(), false);
+			if (v.vertexBuffer == nullptr)
 			{
 				return false;
 			}
 		}
+	}
 
+	for (auto& f : faces_)
+	{
+		f.indexBuffer = graphicsDevice->CreateIndexBuffer(3 * static_cast<int32_t>(f.faces.size()), f.faces.data(), Effekseer::Backend::IndexBufferStrideType::Stride4);
+		if (f.indexBuffer == nullptr)
 		{
-			models_[f].indexBuffer = graphicsDevice->CreateIndexBuffer(3 * GetFaceCount(f), models_[f].faces.data(), Effekseer::Backend::IndexBufferStrideType::Stride4);
-			if (models_[f].indexBuffer == nullptr)
-			{
-				return false;
-			}
+			return false;
 		}
 	}
 
@@ -379,14 +605,14 @@ bool Model::GenerateWireIndexBuffer(Backend::GraphicsDevice* graphicsDevice)
 		return false;
 	}
 
-	for (int32_t f = 0; f < GetFrameCount(); f++)
+	for (auto& f : faces_)
 	{
 		CustomVector<int32_t> indexes;
-		indexes.reserve(GetFaceCount(f) * 6);
+		indexes.reserve(f.faces.size() * 6);
 
-		auto fp = GetFaces(f);
+		auto fp = f.faces.data();
 
-		for (int32_t i = 0; i < GetFaceCount(f); i++)
+		for (size_t i = 0; i < f.faces.size(); i++)
 		{
 			indexes.emplace_back(fp->Indexes[0]);
 			indexes.emplace_back(fp->Indexes[1]);
@@ -398,8 +624,8 @@ bool Model::GenerateWireIndexBuffer(Backend::GraphicsDevice* graphicsDevice)
 		}
 
 		{
-			models_[f].wireIndexBuffer = graphicsDevice->CreateIndexBuffer(static_cast<int32_t>(indexes.size()), indexes.data(), Effekseer::Backend::IndexBufferStrideType::Stride4);
-			if (models_[f].wireIndexBuffer == nullptr)
+			f.wireIndexBuffer = graphicsDevice->CreateIndexBuffer(static_cast<int32_t>(indexes.size()), indexes.data(), Effekseer::Backend::IndexBufferStrideType::Stride4);
+			if (f.wireIndexBuffer == nullptr)
 			{
 				return false;
 			}
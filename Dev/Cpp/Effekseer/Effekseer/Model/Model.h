@@ -9,6 +9,7 @@
 #include "../Effekseer.Vector2D.h"
 #include "../Effekseer.Vector3D.h"
 #include "../Utils/Effekseer.CustomAllocator.h"
+#include <mutex>
 
 namespace Effekseer
 {
@@ -55,20 +56,53 @@ public:
 	};
 
 protected:
-	struct InternalModel
+	struct InternalVertexes
 	{
 		CustomVector<Vertex> vertexes;
-		CustomVector<Face> faces;
 		RefPtr<Backend::VertexBuffer> vertexBuffer;
+	};
+
+	struct InternalFaces
+	{
+		CustomVector<Face> faces;
 		RefPtr<Backend::IndexBuffer> indexBuffer;
 		RefPtr<Backend::IndexBuffer> wireIndexBuffer;
 	};
 
+	//! a structure to sample points on faces in proportion to their areas with an alias table
+	struct InternalSampler
+	{
+		//! attributes of vertices of faces which are packed to avoid indirect accesses
+		CustomVector<std::array<Emitter, 3>> triangles;
+		CustomVector<float> probabilities;
+		CustomVector<int32_t> aliases;
+	};
+
+	//! a frame refers vertexes and faces which are shared with other frames if they are same
+	struct InternalModel
+	{
+		int32_t vertexesIndex = 0;
+		int32_t facesIndex = 0;
+		int32_t samplerIndex = 0;
+	};
+
 	int32_t version_ = 0;
+	CustomVector<InternalVertexes> vertexes_;
+	CustomVector<InternalFaces> faces_;
 	CustomVector<InternalModel> models_;
+	CustomVector<InternalSampler> samplers_;
 	bool isBufferStoredOnGPU_ = false;
 	bool isWireIndexBufferGenerated_ = false;
 
+	//! samplers are generated when emitters are required first because many models are only rendered
+	std::once_flag samplersGenerated_;
+
+	void GenerateSamplers();
+
+	void GenerateSamplersIfRequired();
+
+	Emitter SampleFace(const InternalSampler& sampler, IRandObject* g, CoordinateSystem coordinate, float magnification) const;
+
 public:
 	Model(const CustomVector<Vertex>& vertecies, const CustomVector<Face>& faces);
 
@@ -92,8 +126,35 @@ public:
 
 	int32_t GetFrameCount() const;
 
+	/**
+		@brief
+		\~English	Get the number of vertex arrays. Frames with same vertexes share an array and a vertex buffer.
+		\~Japanese	頂点配列の数を取得する。同じ頂点を持つフレームは配列と頂点バッファを共有する。
+	*/
+	int32_t GetUniqueVertexesCount() const;
+
+	/**
+		@brief
+		\~English	Get the number of face arrays. Frames with same faces share an array and index buffers.
+		\~Japanese	面配列の数を取得する。同じ面を持つフレームは配列とインデックスバッファを共有する。
+	*/
+	int32_t GetUniqueFacesCount() const;
+
 	Emitter GetEmitter(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification);
 
+	/**
+		@brief
+		\~English	Get emitters at random points on faces at once. Points are distributed uniformly by area as with GetEmitter.
+		\~Japanese	面上のランダムな点のエミッターをまとめて取得する。点はGetEmitterと同様に面積に対して均一に分布する。
+		@param	g
+		\~English	a random generator which is used for all emitters
+		\~Japanese	全てのエミッターに使用される乱数生成器
+		@param	emitters
+		\~English	an array which has count elements or more
+		\~Japanese	count以上の要素を持つ配列
+	*/
+	void GetEmitters(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification, Emitter* emitters, int32_t count);
+
 	Emitter GetEmitterFromVertex(IRandObject* g, int32_t time, CoordinateSystem coordinate, float magnification);
 
 	Emitter GetEmitterFromVertex(int32_t index, int32_t time, CoordinateSystem coordinate, float magnification);
@@ -1,9 +1,11 @@
 #include "ProceduralModelGenerator.h"
+#include "../Effekseer.DefaultFile.h"
 #include "../Effekseer.Random.h"
 #include "../Model/Model.h"
 #include "../Noise/CurlNoise.h"
 #include "../Noise/PerlinNoise.h"
 #include "../SIMD/Utils.h"
+#include "../Utils/Effekseer.CacheFile.h"
 #include "ProceduralModelParameter.h"
 #include "SplineGenerator.h"
 
@@ -14,25 +16,35 @@
 namespace Effekseer
 {
 
-ProceduralMesh ProceduralMesh::Combine(ProceduralMesh mesh1, ProceduralMesh mesh2)
+void ProceduralMesh::Append(const ProceduralMesh& mesh)
 {
-	const auto vertexOffset = mesh1.Vertexes.size();
-	const auto faceOffset = mesh1.Faces.size();
+	const auto vertexOffset = Vertexes.size();
+	const auto faceOffset = Faces.size();
 
-	std::copy(mesh2.Vertexes.begin(), mesh2.Vertexes.end(), std::back_inserter(mesh1.Vertexes));
-	std::copy(mesh2.Faces.begin(), mesh2.Faces.end(), std::back_inserter(mesh1.Faces));
+	std::copy(mesh.Vertexes.begin(), mesh.Vertexes.end(), std::back_inserter(Vertexes));
+	std::copy(mesh.Faces.begin(), mesh.Faces.end(), std::back_inserter(Faces));
 
-	for (size_t f = faceOffset; f < mesh1.Faces.size(); f++)
+	for (size_t f = faceOffset; f < Faces.size(); f++)
 	{
-		for (auto& ind : mesh1.Faces[f].Indexes)
+		for (auto& ind : Faces[f].Indexes)
 		{
 			ind += static_cast<int32_t>(vertexOffset);
 		}
 	}
+}
 
+ProceduralMesh ProceduralMesh::Combine(ProceduralMesh mesh1, const ProceduralMesh& mesh2)
+{
+	mesh1.Append(mesh2);
 	return mesh1;
 }
 
+//! run task(begin, end) for the range [0, count)
+using ParallelRunner = std::function<void(int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task)>;
+
+//! the minimum number of vertexes or faces which is worth to be processed on another thread
+static const int32_t MinCountPerTask = 256;
+
 static float CalcSineWave(float x, float frequency, float offset, float power)
 {
 	return sinf(x * frequency + offset) * power;
@@ -83,7 +95,7 @@ static void CalcTangentSpace(const ProceduralMeshVertex& v1, const ProceduralMes
 	binormal = binormal.Normalize();
 }
 
-static void CalculateNormal(ProceduralMesh& mesh)
+static void CalculateNormal(ProceduralMesh& mesh, const ParallelRunner& runParallel)
 {
 	CustomAlignedVector<SIMD::Vec3f> faceNormals;
 	CustomAlignedVector<SIMD::Vec3f> faceTangents;
@@ -97,28 +109,34 @@ static void CalculateNormal(ProceduralMesh& mesh)
 		faceTangents[i] = SIMD::Vec3f(0.0f, 0.0f, 0.0f);
 	}
 
-	for (size_t i = 0; i < mesh.Faces.size(); i++)
-	{
-		const auto& v1 = mesh.Vertexes[mesh.Faces[i].Indexes[0]];
-		const auto& v2 = mesh.Vertexes[mesh.Faces[i].Indexes[1]];
-		const auto& v3 = mesh.Vertexes[mesh.Faces[i].Indexes[2]];
-
-		const auto eps = 0.0001f;
-		if ((v1.Position - v2.Position).GetLength() < eps || (v2.Position - v3.Position).GetLength() < eps || (v1.Position - v3.Position).GetLength() < eps)
+	runParallel(
+		static_cast<int32_t>(mesh.Faces.size()),
+		MinCountPerTask,
+		[&](int32_t begin, int32_t end)
 		{
-			continue;
-		}
+			for (int32_t i = begin; i < end; i++)
+			{
+				const auto& v1 = mesh.Vertexes[mesh.Faces[i].Indexes[0]];
+				const auto& v2 = mesh.Vertexes[mesh.Faces[i].Indexes[1]];
+				const auto& v3 = mesh.Vertexes[mesh.Faces[i].Indexes[2]];
 
-		const auto normal = SIMD::Vec3f::Cross(v3.Position - v1.Position, v2.Position - v1.Position).Normalize();
+				const auto eps = 0.0001f;
+				if ((v1.Position - v2.Position).GetLength() < eps || (v2.Position - v3.Position).GetLength() < eps || (v1.Position - v3.Position).GetLength() < eps)
+				{
+					continue;
+				}
 
-		faceNormals[i] = normal;
-		SIMD::Vec3f binotmal;
-		SIMD::Vec3f tangent;
+				const auto normal = SIMD::Vec3f::Cross(v3.Position - v1.Position, v2.Position - v1.Position).Normalize();
 
-		CalcTangentSpace(v1, v2, v3, binotmal, tangent);
+				faceNormals[i] = normal;
+				SIMD::Vec3f binotmal;
+				SIMD::Vec3f tangent;
 
-		faceTangents[i] = tangent;
-	}
+				CalcTangentSpace(v1, v2, v3, binotmal, tangent);
+
+				faceTangents[i] = tangent;
+			}
+		});
 
 	CustomAlignedUnorderedMap<SIMD::Vec3f, SIMD::Vec3f> normals;
 	CustomAlignedUnorderedMap<SIMD::Vec3f, SIMD::Vec3f> tangents;
@@ -178,7 +196,8 @@ static void CalculateVertexColor(ProceduralMesh& mesh,
 								 const Color& ColorLowerCenter,
 								 const Color& ColorLowerRight,
 								 const std::array<float, 2>& colorCenterPosition,
-								 const std::array<float, 2>& colorCenterArea)
+								 const std::array<float, 2>& colorCenterArea,
+								 const ParallelRunner& runParallel)
 {
 	auto calcColor = [&](float u, float v) -> Color
 	{
@@ -227,24 +246,39 @@ static void CalculateVertexColor(ProceduralMesh& mesh,
 		}
 	};
 
-	for (auto& v : mesh.Vertexes)
-	{
-		v.VColor = calcColor(v.UV.GetX(), v.UV.GetY());
-	}
+	runParallel(
+		static_cast<int32_t>(mesh.Vertexes.size()),
+		MinCountPerTask,
+		[&](int32_t begin, int32_t end)
+		{
+			for (int32_t i = begin; i < end; i++)
+			{
+				auto& v = mesh.Vertexes[i];
+				v.VColor = calcColor(v.UV.GetX(), v.UV.GetY());
+			}
+		});
 }
 
 static void ApplyVertexColorNoise(ProceduralMesh& mesh,
-								  const ProceduralModelParameter& parameter)
+								  const ProceduralModelParameter& parameter,
+								  const ParallelRunner& runParallel)
 {
 	CurlNoise curlNoise(0, 1.0f, 2);
 
-	for (auto& v : mesh.Vertexes)
-	{
-		const auto shift = curlNoise.Get(v.Position * parameter.VertexColorNoiseFrequency + parameter.VertexColorNoiseOffset) * parameter.VertexColorNoisePower;
-		v.VColor.R = static_cast<uint8_t>(Clamp(v.VColor.R + shift.GetX() * 255.0f, 255.0f, 0.0f));
-		v.VColor.G = static_cast<uint8_t>(Clamp(v.VColor.G + shift.GetY() * 255.0f, 255.0f, 0.0f));
-		v.VColor.B = static_cast<uint8_t>(Clamp(v.VColor.B + shift.GetZ() * 255.0f, 255.0f, 0.0f));
-	}
+	runParallel(
+		static_cast<int32_t>(mesh.Vertexes.size()),
+		MinCountPerTask,
+		[&](int32_t begin, int32_t end)
+		{
+			for (int32_t i = begin; i < end; i++)
+			{
+				auto& v = mesh.Vertexes[i];
+				const auto shift = curlNoise.Get(v.Position * parameter.VertexColorNoiseFrequency + parameter.VertexColorNoiseOffset) * parameter.VertexColorNoisePower;
+				v.VColor.R = static_cast<uint8_t>(Clamp(v.VColor.R + shift.GetX() * 255.0f, 255.0f, 0.0f));
+				v.VColor.G = static_cast<uint8_t>(Clamp(v.VColor.G + shift.GetY() * 255.0f, 255.0f, 0.0f));
+				v.VColor.B = static_cast<uint8_t>(Clamp(v.VColor.B + shift.GetZ() * 255.0f, 255.0f, 0.0f));
+			}
+		});
 }
 
 static void ChangeUV(ProceduralMesh& mesh,
@@ -472,6 +506,7 @@ struct RotatorMeshGenerator
 
 	std::function<SIMD::Vec2f(float)> Rotator;
 	std::function<SIMD::Vec3f(SIMD::Vec3f)> Noise;
+	ParallelRunner RunParallel;
 
 	SIMD::Vec3f GetPosition(float angleValue, float depthValue) const
 	{
@@ -502,14 +537,20 @@ struct RotatorMeshGenerator
 		ret.Vertexes.resize(depthDivision * angleDivision);
 		ret.Faces.resize((depthDivision - 1) * (angleDivision - 1) * 2);
 
-		for (int32_t v = 0; v < depthDivision; v++)
-		{
-			for (int32_t u = 0; u < angleDivision; u++)
+		RunParallel(
+			depthDivision,
+			Max(1, MinCountPerTask / angleDivision),
+			[&](int32_t begin, int32_t end)
 			{
-				ret.Vertexes[u + v * angleDivision].Position = GetPosition(u / float(angleDivision - 1), v / float(depthDivision - 1));
-				ret.Vertexes[u + v * angleDivision].UV = SIMD::Vec2f(u / float(angleDivision - 1), 1.0f - v / float(depthDivision - 1));
-			}
-		}
+				for (int32_t v = begin; v < end; v++)
+				{
+					for (int32_t u = 0; u < angleDivision; u++)
+					{
+						ret.Vertexes[u + v * angleDivision].Position = GetPosition(u / float(angleDivision - 1), v / float(depthDivision - 1));
+						ret.Vertexes[u + v * angleDivision].UV = SIMD::Vec2f(u / float(angleDivision - 1), 1.0f - v / float(depthDivision - 1));
+					}
+				}
+			});
 
 		if (IsConnected)
 		{
@@ -544,10 +585,16 @@ struct RotatorMeshGenerator
 			}
 		}
 
-		for (size_t i = 0; i < ret.Vertexes.size(); i++)
-		{
-			ret.Vertexes[i].Position = Noise(ret.Vertexes[i].Position);
-		}
+		RunParallel(
+			static_cast<int32_t>(ret.Vertexes.size()),
+			MinCountPerTask,
+			[&](int32_t begin, int32_t end)
+			{
+				for (int32_t i = begin; i < end; i++)
+				{
+					ret.Vertexes[i].Position = Noise(ret.Vertexes[i].Position);
+				}
+			});
 
 		return ret;
 	}
@@ -565,6 +612,7 @@ struct RotatedWireMeshGenerator
 
 	std::function<SIMD::Vec2f(float)> Rotator;
 	std::function<SIMD::Vec3f(SIMD::Vec3f)> Noise;
+	ParallelRunner RunParallel;
 
 	ProceduralModelCrossSectionType CrossSectionType;
 
@@ -745,14 +793,20 @@ struct RotatedWireMeshGenerator
 				}
 			}
 
-			for (size_t i = 0; i < ribbon.Vertexes.size(); i++)
-			{
-				ribbon.Vertexes[i].Position = Noise(ribbon.Vertexes[i].Position);
-			}
+			RunParallel(
+				static_cast<int32_t>(ribbon.Vertexes.size()),
+				MinCountPerTask,
+				[&](int32_t begin, int32_t end)
+				{
+					for (int32_t i = begin; i < end; i++)
+					{
+						ribbon.Vertexes[i].Position = Noise(ribbon.Vertexes[i].Position);
+					}
+				});
 
-			CalculateNormal(ribbon);
+			CalculateNormal(ribbon, RunParallel);
 
-			ret = ProceduralMesh::Combine(std::move(ret), std::move(ribbon));
+			ret.Append(ribbon);
 		}
 
 		return ret;
@@ -761,6 +815,36 @@ struct RotatedWireMeshGenerator
 
 ModelRef ProceduralModelGenerator::Generate(const ProceduralModelParameter& parameter)
 {
+	if (parameter.Type != ProceduralModelType::Mesh && parameter.Type != ProceduralModelType::Ribbon)
+	{
+		return nullptr;
+	}
+
+	ProceduralMesh generated;
+
+	if (cacheDirectory_.empty())
+	{
+		generated = GenerateMesh(parameter);
+	}
+	else
+	{
+		if (!LoadMeshCache(parameter, generated))
+		{
+			generated = GenerateMesh(parameter);
+			SaveMeshCache(parameter, generated);
+		}
+	}
+
+	return ConvertMeshToModel(generated);
+}
+
+ProceduralMesh ProceduralModelGenerator::GenerateMesh(const ProceduralModelParameter& parameter)
+{
+	const ParallelRunner runParallel = [this](int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task)
+	{
+		RunParallel(count, minCountPerTask, task);
+	};
+
 	RandObject randObj;
 	CurlNoise curlNoise(0, 1.0f, 2);
 
@@ -853,12 +937,13 @@ ModelRef ProceduralModelGenerator::Generate(const ProceduralModelParameter& para
 		auto generator = RotatorMeshGenerator();
 		generator.Rotator = primitiveGenerator;
 		generator.Noise = noiseFunc;
+		generator.RunParallel = runParallel;
 		generator.AngleMin = AngleBegin;
 		generator.AngleMax = AngleEnd;
 		generator.RotatedSpeed = parameter.Mesh.Rotate;
 		generator.IsConnected = isConnected;
 		auto generated = generator.Generate(parameter.Mesh.Divisions[0], parameter.Mesh.Divisions[1]);
-		CalculateNormal(generated);
+		CalculateNormal(generated, runParallel);
 		CalculateVertexColor(
 			generated,
 			parameter.ColorUpperLeft,
@@ -871,19 +956,21 @@ ModelRef ProceduralModelGenerator::Generate(const ProceduralModelParameter& para
 			parameter.ColorLowerCenter,
 			parameter.ColorLowerRight,
 			parameter.ColorCenterPosition,
-			parameter.ColorCenterArea);
+			parameter.ColorCenterArea,
+			runParallel);
 
-		ApplyVertexColorNoise(generated, parameter);
+		ApplyVertexColorNoise(generated, parameter, runParallel);
 		ChangeAxis(generated, parameter.AxisType);
 		ChangeUV(generated, parameter);
 
-		return ConvertMeshToModel(generated);
+		return generated;
 	}
 	else if (parameter.Type == ProceduralModelType::Ribbon)
 	{
 		auto generator = RotatedWireMeshGenerator();
 		generator.Rotator = primitiveGenerator;
 		generator.Noise = noiseFunc;
+		generator.RunParallel = runParallel;
 		generator.CrossSectionType = parameter.Ribbon.CrossSection;
 		generator.Vertices = parameter.Ribbon.Vertices;
 		generator.Rotate = parameter.Ribbon.Rotate;
@@ -894,7 +981,7 @@ ModelRef ProceduralModelGenerator::Generate(const ProceduralModelParameter& para
 
 		auto generated = generator.Generate(randObj);
 
-		CalculateNormal(generated);
+		CalculateNormal(generated, runParallel);
 		CalculateVertexColor(
 			generated,
 			parameter.ColorUpperLeft,
@@ -907,20 +994,207 @@ ModelRef ProceduralModelGenerator::Generate(const ProceduralModelParameter& para
 			parameter.ColorLowerCenter,
 			parameter.ColorLowerRight,
 			parameter.ColorCenterPosition,
-			parameter.ColorCenterArea);
+			parameter.ColorCenterArea,
+			runParallel);
 
-		ApplyVertexColorNoise(generated, parameter);
+		ApplyVertexColorNoise(generated, parameter, runParallel);
 		ChangeAxis(generated, parameter.AxisType);
 		ChangeUV(generated, parameter);
 
-		return ConvertMeshToModel(generated);
+		return generated;
 	}
 
-	return nullptr;
+	return {};
 }
 
 void ProceduralModelGenerator::Ungenerate(ModelRef model)
 {
 }
 
+ProceduralModelGenerator::~ProceduralModelGenerator()
+{
+	SetThreadCount(0);
+}
+
+int32_t ProceduralModelGenerator::GetThreadCount() const
+{
+	return static_cast<int32_t>(threads_.size());
+}
+
+void ProceduralModelGenerator::SetThreadCount(int32_t count)
+{
+	count = Max(count, 0);
+
+	if (count == GetThreadCount())
+	{
+		return;
+	}
+
+	for (auto& worker : threads_)
+	{
+		worker.Shutdown();
+	}
+
+	threads_.clear();
+	threads_.resize(count);
+
+	for (auto& worker : threads_)
+	{
+		worker.Launch();
+	}
+}
+
+void ProceduralModelGenerator::SetCacheDirectory(const char16_t* directory, FileInterfaceRef fileInterface)
+{
+	cacheDirectory_ = directory != nullptr ? directory : u"";
+	cacheFileInterface_ = fileInterface;
+
+	if (cacheFileInterface_ == nullptr)
+	{
+		cacheFileInterface_ = MakeRefPtr<DefaultFileInterface>();
+	}
+}
+
+void ProceduralModelGenerator::RunParallel(int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task)
+{
+	RunParallelFor(threads_.data(), GetThreadCount(), count, minCountPerTask, task);
+}
+
+namespace
+{
+//! a header of a cached mesh. The version must be increased when the generated mesh is changed.
+//! The parameter follows the header and it is compared because different parameters may have the same hash.
+struct ProceduralMeshCacheHeader
+{
+	static const uint32_t FourCC = 0x434d5045; // EPMC
+	static const uint32_t LatestVersion = 2;
+
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t Hash;
+	int32_t ParameterSize;
+	int32_t VertexCount;
+	int32_t FaceCount;
+};
+
+struct ProceduralMeshCacheVertex
+{
+	float Position[3];
+	float Normal[3];
+	float Tangent[3];
+	float UV[2];
+	Color VColor;
+};
+
+} // namespace
+
+bool ProceduralModelGenerator::LoadMeshCache(const ProceduralModelParameter& parameter, ProceduralMesh& mesh)
+{
+	const auto hash = parameter.CalculateHash();
+	auto reader = cacheFileInterface_->TryOpenRead(GetCacheFilePath(cacheDirectory_, hash, u".efkpmc").c_str());
+	if (reader == nullptr)
+	{
+		return false;
+	}
+
+	ProceduralMeshCacheHeader header;
+	if (reader->Read(&header, sizeof(header)) != sizeof(header))
+	{
+		return false;
+	}
+
+	if (header.Magic != ProceduralMeshCacheHeader::FourCC || header.Version != ProceduralMeshCacheHeader::LatestVersion || header.Hash != hash ||
+		header.ParameterSize != sizeof(ProceduralModelParameter) || header.VertexCount < 0 || header.FaceCount < 0)
+	{
+		return false;
+	}
+
+	const auto expectedSize = sizeof(header) + sizeof(ProceduralModelParameter) + sizeof(ProceduralMeshCacheVertex) * header.VertexCount + sizeof(ProceduralMeshFace) * header.FaceCount;
+	if (reader->GetLength() != expectedSize)
+	{
+		return false;
+	}
+
+	ProceduralModelParameter cachedParameter;
+	if (reader->Read(&cachedParameter, sizeof(ProceduralModelParameter)) != sizeof(ProceduralModelParameter) || cachedParameter != parameter)
+	{
+		return false;
+	}
+
+	CustomVector<ProceduralMeshCacheVertex> vertexes(header.VertexCount);
+	mesh.Faces.resize(header.FaceCount);
+
+	if (reader->Read(vertexes.data(), sizeof(ProceduralMeshCacheVertex) * vertexes.size()) != sizeof(ProceduralMeshCacheVertex) * vertexes.size() ||
+		reader->Read(mesh.Faces.data(), sizeof(ProceduralMeshFace) * mesh.Faces.size()) != sizeof(ProceduralMeshFace) * mesh.Faces.size())
+	{
+		mesh = ProceduralMesh();
+		return false;
+	}
+
+	mesh.Vertexes.resize(vertexes.size());
+
+	for (size_t i = 0; i < vertexes.size(); i++)
+	{
+		const auto& src = vertexes[i];
+		auto& dst = mesh.Vertexes[i];
+		dst.Position = SIMD::Vec3f(src.Position[0], src.Position[1], src.Position[2]);
+		dst.Normal = SIMD::Vec3f(src.Normal[0], src.Normal[1], src.Normal[2]);
+		dst.Tangent = SIMD::Vec3f(src.Tangent[0], src.Tangent[1], src.Tangent[2]);
+		dst.UV = SIMD::Vec2f(src.UV[0], src.UV[1]);
+		dst.VColor = src.VColor;
+	}
+
+	for (const auto& face : mesh.Faces)
+	{
+		for (auto ind : face.Indexes)
+		{
+			if (ind < 0 || ind >= header.VertexCount)
+			{
+				mesh = ProceduralMesh();
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void ProceduralModelGenerator::SaveMeshCache(const ProceduralModelParameter& parameter, const ProceduralMesh& mesh)
+{
+	const auto hash = parameter.CalculateHash();
+	auto writer = cacheFileInterface_->OpenWrite(GetCacheFilePath(cacheDirectory_, hash, u".efkpmc").c_str());
+	if (writer == nullptr)
+	{
+		return;
+	}
+
+	ProceduralMeshCacheHeader header;
+	header.Magic = ProceduralMeshCacheHeader::FourCC;
+	header.Version = ProceduralMeshCacheHeader::LatestVersion;
+	header.Hash = hash;
+	header.ParameterSize = sizeof(ProceduralModelParameter);
+	header.VertexCount = static_cast<int32_t>(mesh.Vertexes.size());
+	header.FaceCount = static_cast<int32_t>(mesh.Faces.size());
+
+	CustomVector<ProceduralMeshCacheVertex> vertexes(mesh.Vertexes.size());
+
+	for (size_t i = 0; i < vertexes.size(); i++)
+	{
+		const auto& src = mesh.Vertexes[i];
+		auto& dst = vertexes[i];
+		SIMD::Vec3f::Store(dst.Position, src.Position);
+		SIMD::Vec3f::Store(dst.Normal, src.Normal);
+		SIMD::Vec3f::Store(dst.Tangent, src.Tangent);
+		dst.UV[0] = src.UV.GetX();
+		dst.UV[1] = src.UV.GetY();
+		dst.VColor = src.VColor;
+	}
+
+	writer->Write(&header, sizeof(header));
+	writer->Write(&parameter, sizeof(ProceduralModelParameter));
+	writer->Write(vertexes.data(), sizeof(ProceduralMeshCacheVertex) * vertexes.size());
+	writer->Write(mesh.Faces.data(), sizeof(ProceduralMeshFace) * mesh.Faces.size());
+	writer->Flush();
+}
+
 } // namespace Effekseer
\ No newline at end of file
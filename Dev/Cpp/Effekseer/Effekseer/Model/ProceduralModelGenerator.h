@@ -3,10 +3,13 @@
 
 #include "../Effekseer.Base.h"
 #include "../Effekseer.Color.h"
+#include "../Effekseer.File.h"
+#include "../Effekseer.WorkerThread.h"
 #include "../SIMD/Vec2f.h"
 #include "../SIMD/Vec3f.h"
 #include "../Utils/Effekseer.CustomAllocator.h"
 #include "Model.h"
+#include <string>
 
 namespace Effekseer
 {
@@ -30,20 +33,69 @@ struct ProceduralMesh
 	CustomAlignedVector<ProceduralMeshVertex> Vertexes;
 	CustomVector<ProceduralMeshFace> Faces;
 
-	static ProceduralMesh Combine(ProceduralMesh mesh1, ProceduralMesh mesh2);
+	//! append vertexes and faces of the mesh into this mesh
+	void Append(const ProceduralMesh& mesh);
+
+	static ProceduralMesh Combine(ProceduralMesh mesh1, const ProceduralMesh& mesh2);
 };
 
+/**
+	@brief
+	\~English	A class to generate models from ProceduralModelParameter. Generate must not be called from multiple threads at once.
+	\~Japanese	ProceduralModelParameterからモデルを生成するクラス。Generateを複数のスレッドから同時に呼んではいけない。
+*/
 class ProceduralModelGenerator : public ReferenceObject
 {
+private:
+	CustomVector<WorkerThread> threads_;
+	FileInterfaceRef cacheFileInterface_;
+	std::u16string cacheDirectory_;
+
+	bool LoadMeshCache(const ProceduralModelParameter& parameter, ProceduralMesh& mesh);
+
+	void SaveMeshCache(const ProceduralModelParameter& parameter, const ProceduralMesh& mesh);
+
 public:
 	ProceduralModelGenerator() = default;
-	virtual ~ProceduralModelGenerator() = default;
+	virtual ~ProceduralModelGenerator();
 
 	virtual ModelRef Generate(const ProceduralModelParameter& parameter);
 
 	virtual void Ungenerate(ModelRef model);
 
+	/**
+		@brief
+		\~English	Get the number of worker threads which generate vertexes.
+		\~Japanese	頂点を生成するワーカースレッドの数を取得する。
+	*/
+	int32_t GetThreadCount() const;
+
+	/**
+		@brief
+		\~English	Specify the number of worker threads which generate vertexes. Generated meshes are same regardless of the number.
+		\~Japanese	頂点を生成するワーカースレッドの数を指定する。生成されるメッシュは数に関わらず同じになる。
+	*/
+	void SetThreadCount(int32_t count);
+
+	/**
+		@brief
+		\~English	Specify a directory to store generated meshes. Meshes are keyed by ProceduralModelParameter::CalculateHash, and a parameter stored with a mesh is compared when it is loaded. The cache is disabled if the directory is empty.
+		\~Japanese	生成されたメッシュを保存するディレクトリを指定する。メッシュはProceduralModelParameter::CalculateHashで識別され、読み込み時にメッシュと共に保存されたパラメーターが比較される。ディレクトリが空の場合、キャッシュは無効になる。
+		@param	directory
+		\~English	a directory which ends with a separator
+		\~Japanese	区切り文字で終わるディレクトリ
+		@param	fileInterface
+		\~English	a file interface. DefaultFileInterface is used if it is null.
+		\~Japanese	ファイルインターフェース。nullの場合、DefaultFileInterfaceが使用される。
+	*/
+	void SetCacheDirectory(const char16_t* directory, FileInterfaceRef fileInterface = nullptr);
+
+	ProceduralMesh GenerateMesh(const ProceduralModelParameter& parameter);
+
 protected:
+	//! run task(begin, end) on worker threads and the calling thread
+	void RunParallel(int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task);
+
 	virtual ModelRef ConvertMeshToModel(const ProceduralMesh& mesh);
 
 	virtual ModelRef CreateModel(const CustomVector<Model::Vertex>& vs, const CustomVector<Model::Face>& faces);
@@ -4,8 +4,10 @@
 #include "../Effekseer.Color.h"
 #include "../Utils/BinaryVersion.h"
 #include "../Utils/Effekseer.BinaryReader.h"
+#include "../Utils/Effekseer.Hash.h"
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 namespace Effekseer
 {
@@ -346,6 +348,138 @@ struct ProceduralModelParameter
 		return false;
 	}
 
+	bool operator==(const ProceduralModelParameter& rhs) const
+	{
+		return !(*this < rhs) && !(rhs < *this);
+	}
+
+	bool operator!=(const ProceduralModelParameter& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	/**
+		@brief
+		\~English	Calculate a hash from the values which are compared in operator<. It is stable between processes.
+		\~Japanese	operator<で比較される値からハッシュを計算する。プロセス間で同じ値になる。
+	*/
+	uint64_t CalculateHash() const
+	{
+		HashBuilder hash;
+
+		auto combine = [&hash](uint64_t value)
+		{
+			hash.AddValue(value);
+		};
+
+		// treat -0 as 0 like operator<
+		auto combineFloat = [&hash](float value)
+		{
+			hash.AddFloat(value);
+		};
+
+		auto combineFloats = [&combineFloat](const float* values, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				combineFloat(values[i]);
+			}
+		};
+
+		auto combineColor = [&combine](const Color& value)
+		{
+			combine(static_cast<uint64_t>(value.R) | (static_cast<uint64_t>(value.G) << 8) | (static_cast<uint64_t>(value.B) << 16) | (static_cast<uint64_t>(value.A) << 24));
+		};
+
+		combine(static_cast<uint64_t>(Type));
+
+		if (Type == ProceduralModelType::Mesh)
+		{
+			combineFloat(Mesh.AngleBegin);
+			combineFloat(Mesh.AngleEnd);
+			combine(static_cast<uint64_t>(Mesh.Divisions[0]));
+			combine(static_cast<uint64_t>(Mesh.Divisions[1]));
+			combineFloat(Mesh.Rotate);
+		}
+		else if (Type == ProceduralModelType::Ribbon)
+		{
+			combine(static_cast<uint64_t>(Ribbon.CrossSection));
+			combineFloat(Ribbon.Rotate);
+			combine(static_cast<uint64_t>(Ribbon.Vertices));
+			combineFloats(Ribbon.RibbonSizes.data(), Ribbon.RibbonSizes.size());
+			combineFloats(Ribbon.RibbonAngles.data(), Ribbon.RibbonAngles.size());
+			combineFloats(Ribbon.RibbonNoises.data(), Ribbon.RibbonNoises.size());
+			combine(static_cast<uint64_t>(Ribbon.Count));
+		}
+
+		combine(static_cast<uint64_t>(PrimitiveType));
+
+		if (PrimitiveType == ProceduralModelPrimitiveType::Sphere)
+		{
+			combineFloat(Sphere.Radius);
+			combineFloat(Sphere.DepthMin);
+			combineFloat(Sphere.DepthMax);
+		}
+		else if (PrimitiveType == ProceduralModelPrimitiveType::Cone)
+		{
+			combineFloat(Cone.Radius);
+			combineFloat(Cone.Depth);
+		}
+		else if (PrimitiveType == ProceduralModelPrimitiveType::Cylinder)
+		{
+			combineFloat(Cylinder.Radius1);
+			combineFloat(Cylinder.Radius2);
+			combineFloat(Cylinder.Depth);
+		}
+		else if (PrimitiveType == ProceduralModelPrimitiveType::Spline4)
+		{
+			combineFloats(Spline4.Point1.data(), Spline4.Point1.size());
+			combineFloats(Spline4.Point2.data(), Spline4.Point2.size());
+			combineFloats(Spline4.Point3.data(), Spline4.Point3.size());
+			combineFloats(Spline4.Point4.data(), Spline4.Point4.size());
+		}
+
+		combine(static_cast<uint64_t>(AxisType));
+
+		combineFloats(TiltNoiseFrequency.data(), TiltNoiseFrequency.size());
+		combineFloats(TiltNoiseOffset.data(), TiltNoiseOffset.size());
+		combineFloats(TiltNoisePower.data(), TiltNoisePower.size());
+		combineFloats(WaveNoiseFrequency.data(), WaveNoiseFrequency.size());
+		combineFloats(WaveNoiseOffset.data(), WaveNoiseOffset.size());
+		combineFloats(WaveNoisePower.data(), WaveNoisePower.size());
+		combineFloats(CurlNoiseFrequency.data(), CurlNoiseFrequency.size());
+		combineFloats(CurlNoiseOffset.data(), CurlNoiseOffset.size());
+		combineFloats(CurlNoisePower.data(), CurlNoisePower.size());
+
+		combineColor(ColorUpperLeft);
+		combineColor(ColorUpperCenter);
+		combineColor(ColorUpperRight);
+		combineColor(ColorMiddleLeft);
+		combineColor(ColorMiddleCenter);
+		combineColor(ColorMiddleRight);
+		combineColor(ColorLowerLeft);
+		combineColor(ColorLowerCenter);
+		combineColor(ColorLowerRight);
+
+		combineFloats(ColorCenterPosition.data(), ColorCenterPosition.size());
+		combineFloats(ColorCenterArea.data(), ColorCenterArea.size());
+		combineFloats(VertexColorNoiseFrequency.data(), VertexColorNoiseFrequency.size());
+		combineFloats(VertexColorNoiseOffset.data(), VertexColorNoiseOffset.size());
+		combineFloats(VertexColorNoisePower.data(), VertexColorNoisePower.size());
+		combineFloats(UVPosition.data(), UVPosition.size());
+		combineFloats(UVSize.data(), UVSize.size());
+
+		return hash.Get();
+	}
+
+	struct Hash
+	{
+		size_t operator()(const ProceduralModelParameter& value) const
+		{
+			return static_cast<size_t>(value.CalculateHash());
+		}
+	};
+
 	template <bool T>
 	bool Load(BinaryReader<T>& reader, int version)
 	{
@@ -75,4 +75,39 @@ SIMD::Vec3f SplineGenerator::GetValue(float t) const
 	return a[j] + (b[j] + (c[j] + d[j] * dt) * dt) * dt;
 }
 
+void SplineGenerator::GetValues(int32_t index, int32_t division, SIMD::Vec3f* values) const
+{
+	int32_t j = index;
+
+	if (j < 0)
+	{
+		j = 0;
+	}
+
+	if (j > (int32_t)a.size())
+	{
+		j = (int32_t)a.size() - 1;
+	}
+
+	if (j < (int32_t)isSame.size() && isSame[j])
+	{
+		for (int32_t i = 0; i < division; i++)
+		{
+			values[i] = a[j];
+		}
+		return;
+	}
+
+	const auto aj = a[j];
+	const auto bj = b[j];
+	const auto cj = c[j];
+	const auto dj = d[j];
+
+	for (int32_t i = 0; i < division; i++)
+	{
+		const float dt = i / (float)division;
+		values[i] = aj + (bj + (cj + dj * dt) * dt) * dt;
+	}
+}
+
 } // namespace Effekseer
\ No newline at end of file
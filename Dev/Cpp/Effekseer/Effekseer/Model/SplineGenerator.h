@@ -35,6 +35,13 @@ public:
 	void Reset();
 
 	SIMD::Vec3f GetValue(float t) const;
+
+	/**
+		@brief	Get values at index + i / division for i in [0, division) at once
+		@note
+		It is faster than GetValue for each value because the segment and its coefficients are looked up only once.
+	*/
+	void GetValues(int32_t index, int32_t division, SIMD::Vec3f* values) const;
 };
 
 } // namespace Effekseer
@@ -42,6 +42,9 @@ public:
 
 		bool EnableViewOffset = false;
 
+		//! all corners of a sprite have the same color and positions of corners form an axis aligned rectangle
+		bool IsRectangleWithUniformColor = false;
+
 		RefPtr<RenderingUserData> UserData;
 	};
 
@@ -0,0 +1,32 @@
+#ifndef __EFFEKSEER_CACHE_FILE_H__
+#define __EFFEKSEER_CACHE_FILE_H__
+
+#include <stdint.h>
+#include <string>
+
+namespace Effekseer
+{
+
+/**
+	@brief	get a path of a cache file which is named by a key in hexadecimal
+	@param	directory	a directory which ends with a separator
+	@param	key	a key of the cache
+	@param	extension	an extension which starts with a period
+*/
+inline std::u16string GetCacheFilePath(const std::u16string& directory, uint64_t key, const char16_t* extension)
+{
+	const char16_t* digits = u"0123456789abcdef";
+	std::u16string path = directory;
+
+	for (int32_t i = 15; i >= 0; i--)
+	{
+		path += digits[(key >> (i * 4)) & 0xF];
+	}
+
+	path += extension;
+	return path;
+}
+
+} // namespace Effekseer
+
+#endif
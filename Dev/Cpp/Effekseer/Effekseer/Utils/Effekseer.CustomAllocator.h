@@ -3,6 +3,7 @@
 #define __EFFEKSEER_CUSTOM_ALLOCATOR_H__
 
 #include "../Effekseer.Base.Pre.h"
+#include "Effekseer.Hash.h"
 #include <functional>
 #include <list>
 #include <map>
@@ -280,18 +281,7 @@ public:
 	{
 		size_t operator()(const StringView<T>& key) const
 		{
-			constexpr size_t basis = (sizeof(size_t) == 8) ? 14695981039346656037ULL : 2166136261U;
-			constexpr size_t prime = (sizeof(size_t) == 8) ? 1099511628211ULL : 16777619U;
-
-			const uint8_t* data = reinterpret_cast<const uint8_t*>(key.data());
-			size_t count = key.size() * sizeof(T);
-			size_t val = basis;
-			for (size_t i = 0; i < count; i++)
-			{
-				val ^= static_cast<size_t>(data[i]);
-				val *= prime;
-			}
-			return val;
+			return static_cast<size_t>(CalculateHash(key.data(), key.size() * sizeof(T)));
 		}
 	};
 
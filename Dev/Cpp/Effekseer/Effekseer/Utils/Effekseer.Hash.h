@@ -0,0 +1,72 @@
+#ifndef __EFFEKSEER_HASH_H__
+#define __EFFEKSEER_HASH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace Effekseer
+{
+
+/**
+	@brief
+	\~English	A builder of a 64bit FNV-1a hash. A hash is same between processes and platforms, so it can be used as a key of files.
+	\~Japanese	64bitのFNV-1aハッシュを構築するクラス。ハッシュはプロセスやプラットフォーム間で同じになるため、ファイルのキーとして使用できる。
+*/
+class HashBuilder
+{
+	uint64_t hash_;
+
+public:
+	static const uint64_t OffsetBasis = 14695981039346656037ULL;
+	static const uint64_t Prime = 1099511628211ULL;
+
+	explicit HashBuilder(uint64_t hash = OffsetBasis)
+		: hash_(hash)
+	{
+	}
+
+	//! combine bytes one by one
+	void AddBytes(const void* data, size_t size)
+	{
+		const auto bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash_ ^= bytes[i];
+			hash_ *= Prime;
+		}
+	}
+
+	//! combine a value at once
+	void AddValue(uint64_t value)
+	{
+		hash_ ^= value;
+		hash_ *= Prime;
+	}
+
+	//! combine a float. -0 is treated as 0.
+	void AddFloat(float value)
+	{
+		value += 0.0f;
+		uint32_t bits = 0;
+		memcpy(&bits, &value, sizeof(float));
+		AddValue(bits);
+	}
+
+	uint64_t Get() const
+	{
+		return hash_;
+	}
+};
+
+//! calculate a 64bit FNV-1a hash of bytes
+inline uint64_t CalculateHash(const void* data, size_t size)
+{
+	HashBuilder builder;
+	builder.AddBytes(data, size);
+	return builder.Get();
+}
+
+} // namespace Effekseer
+
+#endif
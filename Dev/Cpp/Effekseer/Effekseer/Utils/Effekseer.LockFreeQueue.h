@@ -0,0 +1,127 @@
+
+#ifndef __EFFEKSEER_LOCK_FREE_QUEUE_H__
+#define __EFFEKSEER_LOCK_FREE_QUEUE_H__
+
+#include "Effekseer.CustomAllocator.h"
+#include <assert.h>
+#include <atomic>
+#include <stdint.h>
+
+namespace Effekseer
+{
+
+/**
+	@brief
+	\~English	A bounded queue which can be pushed from multiple threads and popped from a single thread without locks
+	\~Japanese	複数スレッドから追加、単一スレッドから取得できるロックを使用しない固定長のキュー
+	@note
+	Storage is allocated only in the constructor. Push fails instead of allocating when the queue is full.
+*/
+template <typename T>
+class LockFreeQueue
+{
+	struct Cell
+	{
+		std::atomic<uint32_t> sequence;
+		T value;
+	};
+
+	CustomVector<Cell> cells_;
+	uint32_t mask_;
+	std::atomic<uint32_t> enqueuePos_;
+	std::atomic<uint32_t> dequeuePos_;
+
+public:
+	/**
+		@param	capacity	the number of elements which can be stored. It must be a power of two.
+	*/
+	explicit LockFreeQueue(uint32_t capacity)
+		: cells_(capacity)
+		, mask_(capacity - 1)
+		, enqueuePos_(0)
+		, dequeuePos_(0)
+	{
+		assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+		for (uint32_t i = 0; i < capacity; i++)
+		{
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	LockFreeQueue(const LockFreeQueue&) = delete;
+	LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+	uint32_t GetCapacity() const
+	{
+		return mask_ + 1;
+	}
+
+	bool IsEmpty() const
+	{
+		return enqueuePos_.load(std::memory_order_acquire) == dequeuePos_.load(std::memory_order_acquire);
+	}
+
+	/**
+		@brief	Push a value. It can be called from any thread.
+		@return	false if the queue is full
+	*/
+	bool TryPush(const T& value)
+	{
+		uint32_t pos = enqueuePos_.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			Cell& cell = cells_[pos & mask_];
+			const uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+			const int32_t diff = static_cast<int32_t>(seq - pos);
+
+			if (diff == 0)
+			{
+				if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					cell.value = value;
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = enqueuePos_.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+		@brief	Pop a value. It must be called from only one thread.
+		@return	false if the queue is empty
+	*/
+	bool TryPop(T& value)
+	{
+		const uint32_t pos = dequeuePos_.load(std::memory_order_relaxed);
+		Cell& cell = cells_[pos & mask_];
+		const uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+
+		if (static_cast<int32_t>(seq - (pos + 1)) < 0)
+		{
+			return false;
+		}
+
+		value = cell.value;
+
+		// release references which the value holds
+		cell.value = T();
+
+		dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+		cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+		return true;
+	}
+};
+
+} // namespace Effekseer
+
+#endif
@@ -0,0 +1,84 @@
+#include <Effekseer.h>
+#include <Effekseer/IO/Effekseer.EfkRuntimeFactory.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Cook efkefc or efk into the runtime format which is loaded by EfkRuntimeFactory
+// Usage : EffekseerEffectCooker input output [--magnification value]
+
+namespace
+{
+
+const char* Usage = "Usage : EffekseerEffectCooker input output [--magnification value]";
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cout << Usage << std::endl;
+		return 1;
+	}
+
+	const std::string inputPath = argv[1];
+	const std::string outputPath = argv[2];
+	float magnification = 1.0f;
+
+	for (int i = 3; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--magnification" && i + 1 < argc)
+		{
+			char* end = nullptr;
+			errno = 0;
+			magnification = strtof(argv[i + 1], &end);
+			if (errno != 0 || end == argv[i + 1] || *end != '\0' || !std::isfinite(magnification) || magnification <= 0.0f)
+			{
+				std::cout << "Invalid magnification : " << argv[i + 1] << std::endl;
+				std::cout << Usage << std::endl;
+				return 1;
+			}
+			i++;
+		}
+		else
+		{
+			std::cout << "Unknown argument : " << arg << std::endl;
+			return 1;
+		}
+	}
+
+	std::ifstream input(inputPath, std::ios::binary);
+	if (!input)
+	{
+		std::cout << "Failed to open " << inputPath << std::endl;
+		return 1;
+	}
+
+	const std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+	std::vector<uint8_t> cooked;
+	if (!Effekseer::EfkRuntimeFile::Cook(cooked, data.data(), static_cast<int32_t>(data.size()), magnification))
+	{
+		std::cout << "Unsupported file : " << inputPath << std::endl;
+		return 1;
+	}
+
+	std::ofstream output(outputPath, std::ios::binary);
+	if (!output)
+	{
+		std::cout << "Failed to open " << outputPath << std::endl;
+		return 1;
+	}
+
+	output.write(reinterpret_cast<const char*>(cooked.data()), cooked.size());
+
+	std::cout << inputPath << " (" << data.size() << " bytes) -> " << outputPath << " (" << cooked.size() << " bytes)" << std::endl;
+	return 0;
+}
@@ -1,6 +1,8 @@
 #include "ShaderGeneratorCommon.h"
+#include <cctype>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 namespace Effekseer
 {
@@ -346,6 +348,70 @@ std::string GetFixedGradient(const char* name, const Gradient& gradient)
 	return ss.str();
 }
 
+bool HasIdentifier(const std::string& code, const std::string& name)
+{
+	const auto isIdentifierChar = [](char c) { return isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+	for (auto pos = code.find(name); pos != std::string::npos; pos = code.find(name, pos + 1))
+	{
+		const auto end = pos + name.size();
+		if ((pos == 0 || !isIdentifierChar(code[pos - 1])) && (end == code.size() || !isIdentifierChar(code[end])))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+MaterialShaderUsage AnalyzeMaterialShaderUsage(MaterialFile* materialFile, MaterialShaderType shaderType)
+{
+	// $UV$ is followed by an index of UV
+	std::string code = materialFile->GetGenericCode();
+	for (auto pos = code.find("$UV$"); pos != std::string::npos; pos = code.find("$UV$", pos))
+	{
+		code.replace(pos, 4, "uv");
+	}
+
+	const bool isRefraction = shaderType == MaterialShaderType::Refraction || shaderType == MaterialShaderType::RefractionModel;
+	const bool isLit = !isRefraction && materialFile->GetShadingModel() == ShadingModelType::Lit;
+
+	MaterialShaderUsage usage;
+	usage.VertexColor = HasIdentifier(code, "vcolor");
+	usage.UV1 = HasIdentifier(code, "uv1");
+	usage.UV2 = HasIdentifier(code, "uv2");
+	usage.WorldPosition = isLit || HasIdentifier(code, "worldPos");
+	usage.WorldNormal = isLit || isRefraction || HasIdentifier(code, "worldNormal") || HasIdentifier(code, "pixelNormalDir");
+	usage.WorldTangent = HasIdentifier(code, "worldTangent") || HasIdentifier(code, "worldBinormal");
+	usage.ScreenPosition = isRefraction || HasIdentifier(code, "screenUV") || HasIdentifier(code, "meshZ");
+	return usage;
+}
+
+std::string GetVaryingDefines(const MaterialShaderUsage& usage)
+{
+	std::ostringstream ss;
+
+	const std::pair<bool, const char*> defines[] = {
+		{usage.VertexColor, "_VARYING_VCOLOR_"},
+		{usage.UV1, "_VARYING_UV1_"},
+		{usage.UV2, "_VARYING_UV2_"},
+		{usage.WorldPosition, "_VARYING_WORLD_POSITION_"},
+		{usage.WorldNormal, "_VARYING_WORLD_NORMAL_"},
+		{usage.WorldTangent, "_VARYING_WORLD_TANGENT_"},
+		{usage.ScreenPosition, "_VARYING_SCREEN_POSITION_"},
+	};
+
+	for (const auto& define : defines)
+	{
+		if (define.first)
+		{
+			ss << "#define " << define.second << " 1" << std::endl;
+		}
+	}
+
+	return ss.str();
+}
+
 const char* GetGradientFunctions()
 {
 	return material_gradient_functions;
@@ -1,12 +1,38 @@
 #pragma once
 
+#include "../../Effekseer/Effekseer/Material/Effekseer.MaterialCompiler.h"
 #include <Effekseer.h>
+#include <string>
 
 namespace Effekseer
 {
 namespace Shader
 {
 
+/**
+	@brief	values which a pixel shader of a material reads
+	@note
+	Values which are not read are not passed from a vertex shader to a pixel shader and are replaced with constants.
+*/
+struct MaterialShaderUsage
+{
+	bool VertexColor = true;
+	bool UV1 = true;
+	bool UV2 = true;
+	bool WorldPosition = true;
+	bool WorldNormal = true;
+	bool WorldTangent = true;
+	bool ScreenPosition = true;
+};
+
+//! whether code contains name as an identifier
+bool HasIdentifier(const std::string& code, const std::string& name);
+
+MaterialShaderUsage AnalyzeMaterialShaderUsage(MaterialFile* materialFile, MaterialShaderType shaderType);
+
+//! defines which enable varyings used in a material
+std::string GetVaryingDefines(const MaterialShaderUsage& usage);
+
 std::string GetFixedGradient(const char* name, const Gradient& gradient);
 
 const char* GetGradientFunctions();
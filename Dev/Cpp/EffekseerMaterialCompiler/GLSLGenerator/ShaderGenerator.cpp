@@ -109,13 +109,38 @@ LAYOUT(5) IN vec4 a_Color;
 )"
 	R"(
 
+#ifdef _VARYING_VCOLOR_
 LAYOUT(0) CENTROID OUT lowp vec4 v_VColor;
+#else
+lowp vec4 v_VColor;
+#endif
+#ifdef _VARYING_UV1_
 LAYOUT(1) CENTROID OUT mediump vec2 v_UV1;
+#else
+mediump vec2 v_UV1;
+#endif
+#ifdef _VARYING_UV2_
 LAYOUT(2) CENTROID OUT mediump vec2 v_UV2;
+#else
+mediump vec2 v_UV2;
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_NORMAL_)
 LAYOUT(3) OUT mediump vec4 v_WorldN_PX;
+#else
+mediump vec4 v_WorldN_PX;
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_TANGENT_)
 LAYOUT(4) OUT mediump vec4 v_WorldB_PY;
 LAYOUT(5) OUT mediump vec4 v_WorldT_PZ;
+#else
+mediump vec4 v_WorldB_PY;
+mediump vec4 v_WorldT_PZ;
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 LAYOUT(6) OUT mediump vec4 v_PosP;
+#else
+mediump vec4 v_PosP;
+#endif
 //$C_OUT1$
 //$C_OUT2$
 )";
@@ -235,13 +260,38 @@ LAYOUT(2) IN vec4 atTexCoord;
 )"
 
 	R"(
+#ifdef _VARYING_VCOLOR_
 LAYOUT(0) CENTROID OUT lowp vec4 v_VColor;
+#else
+lowp vec4 v_VColor;
+#endif
+#ifdef _VARYING_UV1_
 LAYOUT(1) CENTROID OUT mediump vec2 v_UV1;
+#else
+mediump vec2 v_UV1;
+#endif
+#ifdef _VARYING_UV2_
 LAYOUT(2) CENTROID OUT mediump vec2 v_UV2;
+#else
+mediump vec2 v_UV2;
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_NORMAL_)
 LAYOUT(3) OUT mediump vec4 v_WorldN_PX;
+#else
+mediump vec4 v_WorldN_PX;
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_TANGENT_)
 LAYOUT(4) OUT mediump vec4 v_WorldB_PY;
 LAYOUT(5) OUT mediump vec4 v_WorldT_PZ;
+#else
+mediump vec4 v_WorldB_PY;
+mediump vec4 v_WorldT_PZ;
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 LAYOUT(6) OUT mediump vec4 v_PosP;
+#else
+mediump vec4 v_PosP;
+#endif
 )";
 
 static const char g_material_sprite_vs_src_pre_simple_uniform[] =
@@ -268,13 +318,38 @@ LAYOUT(5) IN vec2 atTexCoord2;
 )"
 
 	R"(
+#ifdef _VARYING_VCOLOR_
 LAYOUT(0) CENTROID OUT lowp vec4 v_VColor;
+#else
+lowp vec4 v_VColor;
+#endif
+#ifdef _VARYING_UV1_
 LAYOUT(1) CENTROID OUT mediump vec2 v_UV1;
+#else
+mediump vec2 v_UV1;
+#endif
+#ifdef _VARYING_UV2_
 LAYOUT(2) CENTROID OUT mediump vec2 v_UV2;
+#else
+mediump vec2 v_UV2;
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_NORMAL_)
 LAYOUT(3) OUT mediump vec4 v_WorldN_PX;
+#else
+mediump vec4 v_WorldN_PX;
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_TANGENT_)
 LAYOUT(4) OUT mediump vec4 v_WorldB_PY;
 LAYOUT(5) OUT mediump vec4 v_WorldT_PZ;
+#else
+mediump vec4 v_WorldB_PY;
+mediump vec4 v_WorldT_PZ;
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 LAYOUT(6) OUT mediump vec4 v_PosP;
+#else
+mediump vec4 v_PosP;
+#endif
 //$C_OUT1$
 //$C_OUT2$
 )";
@@ -405,13 +480,39 @@ static const char g_material_sprite_vs_src_suf2[] =
 static const char g_material_fs_src_pre[] =
 	R"(
 
+// varyings which are not used are replaced with constants
+#ifdef _VARYING_VCOLOR_
 LAYOUT(0) CENTROID IN lowp vec4 v_VColor;
+#else
+#define v_VColor vec4(1.0, 1.0, 1.0, 1.0)
+#endif
+#ifdef _VARYING_UV1_
 LAYOUT(1) CENTROID IN mediump vec2 v_UV1;
+#else
+#define v_UV1 vec2(0.0, 0.0)
+#endif
+#ifdef _VARYING_UV2_
 LAYOUT(2) CENTROID IN mediump vec2 v_UV2;
+#else
+#define v_UV2 vec2(0.0, 0.0)
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_NORMAL_)
 LAYOUT(3) IN mediump vec4 v_WorldN_PX;
+#else
+#define v_WorldN_PX vec4(0.0, 0.0, 0.0, 0.0)
+#endif
+#if defined(_VARYING_WORLD_POSITION_) || defined(_VARYING_WORLD_TANGENT_)
 LAYOUT(4) IN mediump vec4 v_WorldB_PY;
 LAYOUT(5) IN mediump vec4 v_WorldT_PZ;
+#else
+#define v_WorldB_PY vec4(0.0, 0.0, 0.0, 0.0)
+#define v_WorldT_PZ vec4(0.0, 0.0, 0.0, 0.0)
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 LAYOUT(6) IN mediump vec4 v_PosP;
+#else
+#define v_PosP vec4(0.0, 0.0, 0.0, 1.0)
+#endif
 //$C_PIN1$
 //$C_PIN2$
 
@@ -673,6 +774,8 @@ void ShaderGenerator::ExportHeader(std::ostringstream& maincode, MaterialFile* m
 
 	maincode << material_common_define;
 
+	maincode << Effekseer::Shader::GetVaryingDefines(usage_);
+
 	if (stage == 0)
 	{
 		maincode << material_common_vs_define;
@@ -896,6 +999,7 @@ ShaderData ShaderGenerator::GenerateShader(MaterialFile* materialFile,
 	useUniformBlock_ = useUniformBlock;
 	useSet_ = useSet;
 	textureBindingOffset_ = textureBindingOffset;
+	usage_ = Effekseer::Shader::AnalyzeMaterialShaderUsage(materialFile, shaderType);
 
 	bool isSprite = shaderType == MaterialShaderType::Standard || shaderType == MaterialShaderType::Refraction;
 	bool isRefrection = materialFile->GetHasRefraction() &&
@@ -931,10 +1035,18 @@ ShaderData ShaderGenerator::GenerateShader(MaterialFile* materialFile,
 		int32_t actualUniformCount = std::min(maximumUniformCount, materialFile->GetUniformCount());
 		int32_t actualTextureCount = std::min(maximumTextureCount, materialFile->GetTextureCount());
 
+		// without uniform blocks, textures and uniforms are bound with names, so unused ones are not declared
+		const std::string genericCode = materialFile->GetGenericCode();
+
 		for (int32_t i = 0; i < actualTextureCount; i++)
 		{
 			auto textureName = materialFile->GetTextureName(i);
 
+			if (!useUniformBlock && genericCode.find("$TEX_P" + std::to_string(materialFile->GetTextureIndex(i)) + "$") == std::string::npos)
+			{
+				continue;
+			}
+
 			ExportTexture(maincode, textureName, i, stage);
 		}
 
@@ -1021,6 +1133,11 @@ uniform vec4 customData2s[_INSTANCE_COUNT_];
 		{
 			auto uniformName = materialFile->GetUniformName(i);
 
+			if (!useUniformBlock && !Effekseer::Shader::HasIdentifier(genericCode, uniformName))
+			{
+				continue;
+			}
+
 			ExportUniform(maincode, 4, uniformName);
 		}
 
@@ -1033,6 +1150,11 @@ uniform vec4 customData2s[_INSTANCE_COUNT_];
 
 		for (size_t i = 0; i < materialFile->Gradients.size(); i++)
 		{
+			if (!useUniformBlock && !Effekseer::Shader::HasIdentifier(genericCode, materialFile->Gradients[i].Name + "_0"))
+			{
+				continue;
+			}
+
 			// TODO : remove a magic number
 			for (size_t j = 0; j < 13; j++)
 			{
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "../../Effekseer/Effekseer/Material/Effekseer.MaterialCompiler.h"
+#include "../Common/ShaderGeneratorCommon.h"
 #include <iostream>
 
 namespace Effekseer
@@ -20,6 +21,7 @@ class ShaderGenerator
 	bool useUniformBlock_ = false;
 	bool useSet_ = false;
 	int32_t textureBindingOffset_ = 0;
+	Effekseer::Shader::MaterialShaderUsage usage_;
 
 	std::string Replace(std::string target, std::string from_, std::string to_);
 
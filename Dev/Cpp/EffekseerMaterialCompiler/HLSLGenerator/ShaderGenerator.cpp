@@ -117,14 +117,28 @@ struct VS_Input
 struct VS_Output
 {
 	float4 Position		: SV_POSITION;
+#ifdef _VARYING_VCOLOR_
 	C_LINEAR C_CENTROID float4 VColor		: COLOR;
+#endif
+#ifdef _VARYING_UV1_
 	C_LINEAR C_CENTROID float2 UV1		: TEXCOORD0;
+#endif
+#ifdef _VARYING_UV2_
 	C_LINEAR C_CENTROID float2 UV2		: TEXCOORD1;
+#endif
+#ifdef _VARYING_WORLD_POSITION_
 	float3 WorldP	: TEXCOORD2;
+#endif
+#ifdef _VARYING_WORLD_NORMAL_
 	float3 WorldN : TEXCOORD3;
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
 	float3 WorldT : TEXCOORD4;
 	float3 WorldB : TEXCOORD5;
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 	float4 PosP : TEXCOORD6;
+#endif
 	//float2 ScreenUV : TEXCOORD6;
 };
 
@@ -155,14 +169,28 @@ struct VS_Input
 struct VS_Output
 {
 	float4 Position		: SV_POSITION;
+#ifdef _VARYING_VCOLOR_
 	C_LINEAR C_CENTROID float4 VColor		: COLOR;
+#endif
+#ifdef _VARYING_UV1_
 	C_LINEAR C_CENTROID float2 UV1		: TEXCOORD0;
+#endif
+#ifdef _VARYING_UV2_
 	C_LINEAR C_CENTROID float2 UV2		: TEXCOORD1;
+#endif
+#ifdef _VARYING_WORLD_POSITION_
 	float3 WorldP	: TEXCOORD2;
+#endif
+#ifdef _VARYING_WORLD_NORMAL_
 	float3 WorldN : TEXCOORD3;
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
 	float3 WorldT : TEXCOORD4;
 	float3 WorldB : TEXCOORD5;
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 	float4 PosP : TEXCOORD6;
+#endif
 	//float2 ScreenUV : TEXCOORD6;
 	//$C_OUT1$
 	//$C_OUT2$
@@ -197,9 +225,13 @@ VS_Output main( const VS_Input Input )
 	//uv2.y = mUVInversed.x + mUVInversed.y * uv2.y;
 
 	// NBT
+#ifdef _VARYING_WORLD_NORMAL_
 	Output.WorldN = worldNormal;
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
 	Output.WorldB = worldBinormal;
 	Output.WorldT = worldTangent;
+#endif
 
 	float3 pixelNormalDir = worldNormal;
 	float4 vcolor = Input.Color;
@@ -227,9 +259,13 @@ VS_Output main( const VS_Input Input )
 	//uv2.y = mUVInversed.x + mUVInversed.y * uv2.y;
 
 	// NBT
+#ifdef _VARYING_WORLD_NORMAL_
 	Output.WorldN = worldNormal;
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
 	Output.WorldB = worldBinormal;
 	Output.WorldT = worldTangent;
+#endif
 
 	float3 pixelNormalDir = worldNormal;
 	float4 vcolor = Input.Color;
@@ -247,12 +283,22 @@ static char* material_sprite_vs_suf2 = R"(
 	cameraPos = cameraPos / cameraPos.w;
 	Output.Position = mul(mProj, cameraPos);
 
+#ifdef _VARYING_WORLD_POSITION_
 	Output.WorldP = worldPos;
+#endif
+#ifdef _VARYING_VCOLOR_
 	Output.VColor = Input.Color;
+#endif
+#ifdef _VARYING_UV1_
 	Output.UV1 = uv1;
+#endif
+#ifdef _VARYING_UV2_
 	Output.UV2 = uv2;
+#endif
 
+#ifdef _VARYING_SCREEN_POSITION_
 	Output.PosP = Output.Position;
+#endif
 	//Output.ScreenUV = Output.Position.xy / Output.Position.w;
 	//Output.ScreenUV.xy = float2(Output.ScreenUV.x + 1.0, 1.0 - Output.ScreenUV.y) * 0.5;
 
@@ -295,14 +341,28 @@ struct VS_Input
 struct VS_Output
 {
 	float4 Position		: SV_POSITION;
+#ifdef _VARYING_VCOLOR_
 	C_LINEAR C_CENTROID float4 VColor		: COLOR;
+#endif
+#ifdef _VARYING_UV1_
 	C_LINEAR C_CENTROID float2 UV1		: TEXCOORD0;
+#endif
+#ifdef _VARYING_UV2_
 	C_LINEAR C_CENTROID float2 UV2		: TEXCOORD1;
+#endif
+#ifdef _VARYING_WORLD_POSITION_
 	float3 WorldP	: TEXCOORD2;
+#endif
+#ifdef _VARYING_WORLD_NORMAL_
 	float3 WorldN : TEXCOORD3;
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
 	float3 WorldT : TEXCOORD4;
 	float3 WorldB : TEXCOORD5;
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 	float4 PosP : TEXCOORD6;
+#endif
 	//float2 ScreenUV : TEXCOORD6;
 	//$C_OUT1$
 	//$C_OUT2$
@@ -391,16 +451,30 @@ static char* model_vs_suf2 = R"(
 
 	Output.Position = mul( mCameraProj,  float4(worldPos, 1.0) );
 
+#ifdef _VARYING_WORLD_POSITION_
 	Output.WorldP = worldPos;
+#endif
+#ifdef _VARYING_WORLD_NORMAL_
 	Output.WorldN = worldNormal;
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
 	Output.WorldB = worldBinormal;
 	Output.WorldT = worldTangent;
+#endif
 
+#ifdef _VARYING_VCOLOR_
 	Output.VColor = modelColor;
+#endif
+#ifdef _VARYING_UV1_
 	Output.UV1 = uv1;
+#endif
+#ifdef _VARYING_UV2_
 	Output.UV2 = uv2;
+#endif
 
+#ifdef _VARYING_SCREEN_POSITION_
 	Output.PosP = Output.Position;
+#endif
 	//Output.ScreenUV = Output.Position.xy / Output.Position.w;
 	//Output.ScreenUV.xy = float2(Output.ScreenUV.x + 1.0, 1.0 - Output.ScreenUV.y) * 0.5;
 
@@ -426,18 +500,71 @@ struct PS_Input
 	}
 
 	ss << R"(
+#ifdef _VARYING_VCOLOR_
 	C_LINEAR C_CENTROID float4 VColor		: COLOR;
+#endif
+#ifdef _VARYING_UV1_
 	C_LINEAR C_CENTROID float2 UV1		: TEXCOORD0;
+#endif
+#ifdef _VARYING_UV2_
 	C_LINEAR C_CENTROID float2 UV2		: TEXCOORD1;
+#endif
+#ifdef _VARYING_WORLD_POSITION_
 	float3 WorldP	: TEXCOORD2;
+#endif
+#ifdef _VARYING_WORLD_NORMAL_
 	float3 WorldN : TEXCOORD3;
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
 	float3 WorldT : TEXCOORD4;
 	float3 WorldB : TEXCOORD5;
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
 	float4 PosP : TEXCOORD6;
+#endif
 	//float2 ScreenUV : TEXCOORD6;
 	//$C_PIN1$
 	//$C_PIN2$
 };
+
+// varyings which are not used are replaced with constants
+#ifdef _VARYING_VCOLOR_
+#define INPUT_VCOLOR Input.VColor
+#else
+#define INPUT_VCOLOR float4(1.0, 1.0, 1.0, 1.0)
+#endif
+#ifdef _VARYING_UV1_
+#define INPUT_UV1 Input.UV1
+#else
+#define INPUT_UV1 float2(0.0, 0.0)
+#endif
+#ifdef _VARYING_UV2_
+#define INPUT_UV2 Input.UV2
+#else
+#define INPUT_UV2 float2(0.0, 0.0)
+#endif
+#ifdef _VARYING_WORLD_POSITION_
+#define INPUT_WORLDP Input.WorldP
+#else
+#define INPUT_WORLDP float3(0.0, 0.0, 0.0)
+#endif
+#ifdef _VARYING_WORLD_NORMAL_
+#define INPUT_WORLDN Input.WorldN
+#else
+#define INPUT_WORLDN float3(0.0, 0.0, 0.0)
+#endif
+#ifdef _VARYING_WORLD_TANGENT_
+#define INPUT_WORLDB Input.WorldB
+#define INPUT_WORLDT Input.WorldT
+#else
+#define INPUT_WORLDB float3(0.0, 0.0, 0.0)
+#define INPUT_WORLDT float3(0.0, 0.0, 0.0)
+#endif
+#ifdef _VARYING_SCREEN_POSITION_
+#define INPUT_POSP Input.PosP
+#else
+#define INPUT_POSP float4(0.0, 0.0, 0.0, 1.0)
+#endif
 )";
 
 	if (type == ShaderGeneratorTarget::DirectX9 || type == ShaderGeneratorTarget::DirectX11 || type == ShaderGeneratorTarget::PSSL)
@@ -566,19 +693,19 @@ float3 calcDirectionalLightDiffuseColor(float3 diffuseColor, float3 normal, floa
 
 float4 main( const PS_Input Input ) : SV_Target
 {
-	float2 uv1 = Input.UV1;
-	float2 uv2 = Input.UV2;
-	float3 worldPos = Input.WorldP;
-	float3 worldNormal = Input.WorldN;
-	float3 worldBinormal = Input.WorldB;
-	float3 worldTangent = Input.WorldT;
+	float2 uv1 = INPUT_UV1;
+	float2 uv2 = INPUT_UV2;
+	float3 worldPos = INPUT_WORLDP;
+	float3 worldNormal = INPUT_WORLDN;
+	float3 worldBinormal = INPUT_WORLDB;
+	float3 worldTangent = INPUT_WORLDT;
 	float3 objectScale = float3(1.0, 1.0, 1.0);
 
 	float3 pixelNormalDir = worldNormal;
-	float4 vcolor = Input.VColor;
+	float4 vcolor = INPUT_VCOLOR;
 
-	float2 screenUV = Input.PosP.xy / Input.PosP.w;
-	float meshZ =  Input.PosP.z / Input.PosP.w;
+	float2 screenUV = INPUT_POSP.xy / INPUT_POSP.w;
+	float meshZ =  INPUT_POSP.z / INPUT_POSP.w;
 	screenUV.xy = float2(screenUV.x + 1.0, 1.0 - screenUV.y) * 0.5;
 )";
 
@@ -727,6 +854,8 @@ int32_t ShaderGenerator::ExportHeader(std::ostringstream& maincode, MaterialFile
 
 	maincode << common_define_;
 
+	maincode << Effekseer::Shader::GetVaryingDefines(usage_);
+
 	// gradient
 	bool hasGradient = false;
 	bool hasNoise = false;
@@ -920,6 +1049,15 @@ ShaderData ShaderGenerator::GenerateShader(MaterialFile* materialFile,
 {
 	ShaderData shaderData;
 
+	usage_ = Effekseer::Shader::AnalyzeMaterialShaderUsage(materialFile, shaderType);
+
+	// an input structure of a pixel shader must not be empty without SV_POSITION
+	if (target_ == ShaderGeneratorTarget::DirectX9 && !usage_.VertexColor && !usage_.UV1 && !usage_.UV2 && !usage_.WorldPosition &&
+		!usage_.WorldNormal && !usage_.WorldTangent && !usage_.ScreenPosition)
+	{
+		usage_.VertexColor = true;
+	}
+
 	bool isSprite = shaderType == MaterialShaderType::Standard || shaderType == MaterialShaderType::Refraction;
 	bool isRefrection = materialFile->GetHasRefraction() &&
 						(shaderType == MaterialShaderType::Refraction || shaderType == MaterialShaderType::RefractionModel);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Effekseer/Effekseer/Material/Effekseer.MaterialCompiler.h"
+#include "../Common/ShaderGeneratorCommon.h"
 #include <string>
 #include <vector>
 
@@ -43,6 +44,7 @@ protected:
 	std::string ps_suf2_unlit_;
 	std::string ps_suf2_refraction_;
 	ShaderGeneratorTarget target_;
+	Effekseer::Shader::MaterialShaderUsage usage_;
 
 	std::string Replace(std::string target, std::string from_, std::string to_);
 
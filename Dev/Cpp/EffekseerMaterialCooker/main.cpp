@@ -0,0 +1,495 @@
+#include "../Viewer/DynamicLinkLibrary.h"
+#include <Effekseer.h>
+#include <Effekseer/Material/Effekseer.CompiledMaterial.h>
+#include <Effekseer/Material/Effekseer.MaterialCompiler.h>
+#include <Effekseer/Material/Effekseer.MaterialFile.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compile all efkmat in a directory into efkmatd for all platforms whose compilers are found
+// Compilers (EffekseerMaterialCompilerXXX) are loaded from the directory of the executable unless --compilers is specified
+// Unchanged materials are skipped with a manifest which contains hashes of inputs
+// Usage : EffekseerMaterialCooker input_directory output_directory [--compilers directory] [--platforms GL,Metal,...] [--threads count] [--force]
+
+typedef Effekseer::MaterialCompiler*(EFK_STDCALL* CreateCompilerFunc)();
+
+namespace
+{
+
+const char* ManifestName = "EffekseerMaterialCooker.manifest";
+
+//! change it when the output is changed with the same inputs
+const char* ManifestHeader = "EffekseerMaterialCooker 1";
+
+struct CompilerPlugin
+{
+	Effekseer::CompiledMaterialPlatformType Type;
+	std::string Name;
+	std::filesystem::path Path;
+	std::shared_ptr<DynamicLinkLibrary> Library;
+	CreateCompilerFunc CreateCompiler = nullptr;
+};
+
+struct MaterialEntry
+{
+	std::filesystem::path InputPath;
+	std::filesystem::path OutputPath;
+	std::string RelativePath;
+	std::vector<uint8_t> Data;
+	uint64_t Hash = 0;
+	Effekseer::MaterialFile File;
+	bool IsLoaded = false;
+};
+
+struct CompiledShaders
+{
+	std::array<std::vector<uint8_t>, 4> VertexShaders;
+	std::array<std::vector<uint8_t>, 4> PixelShaders;
+	bool IsSucceeded = false;
+};
+
+std::string ToHexString(uint64_t value)
+{
+	std::ostringstream ss;
+	ss << std::hex;
+	ss.width(16);
+	ss.fill('0');
+	ss << value;
+	return ss.str();
+}
+
+bool LoadFile(std::vector<uint8_t>& dst, const std::filesystem::path& path)
+{
+	std::ifstream input(path, std::ios::binary);
+	if (!input)
+	{
+		return false;
+	}
+
+	dst.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	return true;
+}
+
+std::vector<CompilerPlugin> LoadCompilers(const std::filesystem::path& directory, const std::vector<std::string>& platforms)
+{
+	std::vector<std::pair<Effekseer::CompiledMaterialPlatformType, std::string>> names = {
+		{Effekseer::CompiledMaterialPlatformType::DirectX9, "DX9"},
+		{Effekseer::CompiledMaterialPlatformType::DirectX11, "DX11"},
+		{Effekseer::CompiledMaterialPlatformType::DirectX12, "DX12"},
+		{Effekseer::CompiledMaterialPlatformType::OpenGL, "GL"},
+		{Effekseer::CompiledMaterialPlatformType::Metal, "Metal"},
+		{Effekseer::CompiledMaterialPlatformType::Vulkan, "VK"},
+		{Effekseer::CompiledMaterialPlatformType::PS4, "PS4"},
+		{Effekseer::CompiledMaterialPlatformType::Switch, "Switch"},
+		{Effekseer::CompiledMaterialPlatformType::PS5, "PS5"},
+	};
+
+	std::vector<CompilerPlugin> plugins;
+
+	for (const auto& name : names)
+	{
+		if (!platforms.empty() && std::find(platforms.begin(), platforms.end(), name.second) == platforms.end())
+		{
+			continue;
+		}
+
+#ifdef _WIN32
+		std::string filename = "EffekseerMaterialCompiler" + name.second;
+#ifdef _DEBUG
+		filename += ".Debug.dll";
+#else
+		filename += ".dll";
+#endif
+#elif defined(__APPLE__)
+		std::string filename = "libEffekseerMaterialCompiler" + name.second + ".dylib";
+#else
+		std::string filename = "libEffekseerMaterialCompiler" + name.second + ".so";
+#endif
+
+		const auto path = directory / filename;
+		auto library = std::make_shared<DynamicLinkLibrary>();
+		if (!library->Load(path.string().c_str()))
+		{
+			continue;
+		}
+
+#if defined(_WIN32) && !defined(_WIN64)
+		auto createCompiler = library->GetProc<CreateCompilerFunc>("_CreateCompiler@0");
+#else
+		auto createCompiler = library->GetProc<CreateCompilerFunc>("CreateCompiler");
+#endif
+		if (createCompiler == nullptr)
+		{
+			continue;
+		}
+
+		CompilerPlugin plugin;
+		plugin.Type = name.first;
+		plugin.Name = name.second;
+		plugin.Path = path;
+		plugin.Library = library;
+		plugin.CreateCompiler = createCompiler;
+		plugins.emplace_back(plugin);
+	}
+
+	return plugins;
+}
+
+std::map<std::string, uint64_t> LoadManifest(const std::filesystem::path& path)
+{
+	std::map<std::string, uint64_t> manifest;
+
+	std::ifstream input(path);
+	std::string line;
+	if (!input || !std::getline(input, line) || line != ManifestHeader)
+	{
+		return manifest;
+	}
+
+	while (std::getline(input, line))
+	{
+		const auto separator = line.find('\t');
+		if (separator == std::string::npos || separator == 0)
+		{
+			continue;
+		}
+
+		// a broken line is ignored, so the material is compiled again
+		const auto hashText = line.substr(0, separator);
+		char* end = nullptr;
+		errno = 0;
+		const auto hash = strtoull(hashText.c_str(), &end, 16);
+		if (errno != 0 || end != hashText.c_str() + hashText.size())
+		{
+			continue;
+		}
+
+		manifest[line.substr(separator + 1)] = hash;
+	}
+
+	return manifest;
+}
+
+bool SaveManifest(const std::filesystem::path& path, const std::map<std::string, uint64_t>& manifest)
+{
+	std::ofstream output(path, std::ios::trunc);
+	if (!output)
+	{
+		return false;
+	}
+
+	output << ManifestHeader << "\n";
+	for (const auto& entry : manifest)
+	{
+		output << ToHexString(entry.second) << "\t" << entry.first << "\n";
+	}
+
+	return true;
+}
+
+bool CompileMaterial(CompiledShaders& dst, Effekseer::MaterialCompiler* compiler, Effekseer::MaterialFile* materialFile)
+{
+	if (compiler == nullptr)
+	{
+		return false;
+	}
+
+	auto binary = Effekseer::RefPtr<Effekseer::CompiledMaterialBinary>(compiler->Compile(materialFile));
+	if (binary == nullptr)
+	{
+		return false;
+	}
+
+	const Effekseer::MaterialShaderType types[] = {
+		Effekseer::MaterialShaderType::Standard,
+		Effekseer::MaterialShaderType::Model,
+		Effekseer::MaterialShaderType::Refraction,
+		Effekseer::MaterialShaderType::RefractionModel,
+	};
+
+	for (size_t i = 0; i < dst.VertexShaders.size(); i++)
+	{
+		const auto vs = binary->GetVertexShaderData(types[i]);
+		const auto ps = binary->GetPixelShaderData(types[i]);
+		dst.VertexShaders[i].assign(vs, vs + binary->GetVertexShaderSize(types[i]));
+		dst.PixelShaders[i].assign(ps, ps + binary->GetPixelShaderSize(types[i]));
+	}
+
+	dst.IsSucceeded = !dst.VertexShaders[0].empty() && !dst.PixelShaders[0].empty() && !dst.VertexShaders[1].empty() && !dst.PixelShaders[1].empty();
+	return dst.IsSucceeded;
+}
+
+//! run tasks with threads. task receives an index of a thread and an index of a task
+void RunParallel(int32_t count, int32_t threadCount, const std::function<void(int32_t, int32_t)>& task)
+{
+	std::atomic<int32_t> next(0);
+	auto worker = [&](int32_t threadIndex) {
+		for (int32_t i = next++; i < count; i = next++)
+		{
+			task(threadIndex, i);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int32_t i = 1; i < std::min(threadCount, count); i++)
+	{
+		threads.emplace_back(worker, i);
+	}
+
+	worker(0);
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage : EffekseerMaterialCooker input_directory output_directory [--compilers directory] [--platforms GL,Metal,...] [--threads count] [--force]" << std::endl;
+		return 1;
+	}
+
+	const std::filesystem::path inputDirectory = argv[1];
+	const std::filesystem::path outputDirectory = argv[2];
+	std::filesystem::path compilerDirectory = std::filesystem::absolute(argv[0]).parent_path();
+	std::vector<std::string> platforms;
+	int32_t threadCount = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+	bool isForced = false;
+
+	for (int i = 3; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--compilers" && i + 1 < argc)
+		{
+			compilerDirectory = argv[i + 1];
+			i++;
+		}
+		else if (arg == "--platforms" && i + 1 < argc)
+		{
+			std::istringstream ss(argv[i + 1]);
+			std::string platform;
+			while (std::getline(ss, platform, ','))
+			{
+				platforms.emplace_back(platform);
+			}
+			i++;
+		}
+		else if (arg == "--threads" && i + 1 < argc)
+		{
+			char* end = nullptr;
+			errno = 0;
+			const auto value = strtol(argv[i + 1], &end, 10);
+			if (errno != 0 || end == argv[i + 1] || *end != '\0' || value < 1 || value > 1024)
+			{
+				std::cout << "Invalid thread count : " << argv[i + 1] << std::endl;
+				return 1;
+			}
+
+			threadCount = static_cast<int32_t>(value);
+			i++;
+		}
+		else if (arg == "--force")
+		{
+			isForced = true;
+		}
+		else
+		{
+			std::cout << "Unknown argument : " << arg << std::endl;
+			return 1;
+		}
+	}
+
+	const auto compilers = LoadCompilers(compilerDirectory, platforms);
+	if (compilers.empty())
+	{
+		std::cout << "No material compiler is found in " << compilerDirectory.string() << std::endl;
+		return 1;
+	}
+
+	std::error_code ec;
+	if (!std::filesystem::is_directory(inputDirectory, ec))
+	{
+		std::cout << "Failed to open " << inputDirectory.string() << std::endl;
+		return 1;
+	}
+
+	// outputs depend on the set of platforms and the binaries of compilers as well as the input
+	Effekseer::HashBuilder platformHash;
+	for (const auto& compiler : compilers)
+	{
+		platformHash.AddBytes(&compiler.Type, sizeof(compiler.Type));
+
+		const auto fileSize = std::filesystem::file_size(compiler.Path, ec);
+		platformHash.AddValue(ec ? 0 : static_cast<uint64_t>(fileSize));
+
+		const auto writeTime = std::filesystem::last_write_time(compiler.Path, ec);
+		platformHash.AddValue(ec ? 0 : static_cast<uint64_t>(writeTime.time_since_epoch().count()));
+	}
+
+	std::vector<std::unique_ptr<MaterialEntry>> materials;
+	for (const auto& file : std::filesystem::recursive_directory_iterator(inputDirectory, ec))
+	{
+		if (!file.is_regular_file() || file.path().extension() != ".efkmat")
+		{
+			continue;
+		}
+
+		auto material = std::make_unique<MaterialEntry>();
+		material->InputPath = file.path();
+		material->RelativePath = std::filesystem::relative(file.path(), inputDirectory).generic_string();
+		material->OutputPath = outputDirectory / std::filesystem::relative(file.path(), inputDirectory);
+		material->OutputPath.replace_extension(".efkmatd");
+		materials.emplace_back(std::move(material));
+	}
+
+	std::sort(materials.begin(), materials.end(), [](const std::unique_ptr<MaterialEntry>& a, const std::unique_ptr<MaterialEntry>& b) { return a->RelativePath < b->RelativePath; });
+
+	const auto manifestPath = outputDirectory / ManifestName;
+	const auto oldManifest = isForced ? std::map<std::string, uint64_t>() : LoadManifest(manifestPath);
+	std::map<std::string, uint64_t> newManifest;
+
+	std::vector<MaterialEntry*> dirtyMaterials;
+	int32_t skippedCount = 0;
+	int32_t failedCount = 0;
+
+	for (auto& material : materials)
+	{
+		if (!LoadFile(material->Data, material->InputPath))
+		{
+			std::cout << "Failed to open " << material->InputPath.string() << std::endl;
+			failedCount++;
+			continue;
+		}
+
+		auto hash = platformHash;
+		hash.AddBytes(material->Data.data(), material->Data.size());
+		material->Hash = hash.Get();
+
+		const auto it = oldManifest.find(material->RelativePath);
+		if (it != oldManifest.end() && it->second == material->Hash && std::filesystem::exists(material->OutputPath, ec))
+		{
+			newManifest[material->RelativePath] = material->Hash;
+			skippedCount++;
+			continue;
+		}
+
+		material->IsLoaded = material->File.Load(material->Data.data(), static_cast<int32_t>(material->Data.size()));
+		if (!material->IsLoaded)
+		{
+			std::cout << "Unsupported file : " << material->InputPath.string() << std::endl;
+			failedCount++;
+			continue;
+		}
+
+		dirtyMaterials.emplace_back(material.get());
+	}
+
+	// compile each pair of a material and a platform in parallel
+	const int32_t platformCount = static_cast<int32_t>(compilers.size());
+	std::vector<CompiledShaders> results(dirtyMaterials.size() * compilers.size());
+
+	// compilers are not guaranteed to be thread safe, so each thread has own compilers which are created when they are used first
+	std::vector<std::vector<Effekseer::RefPtr<Effekseer::MaterialCompiler>>> threadCompilers(threadCount);
+	for (auto& c : threadCompilers)
+	{
+		c.resize(compilers.size());
+	}
+
+	RunParallel(
+		static_cast<int32_t>(results.size()),
+		threadCount,
+		[&](int32_t threadIndex, int32_t index)
+		{
+			const auto platformIndex = index % platformCount;
+			auto& compiler = threadCompilers[threadIndex][platformIndex];
+			if (compiler == nullptr)
+			{
+				compiler = Effekseer::RefPtr<Effekseer::MaterialCompiler>(compilers[platformIndex].CreateCompiler());
+			}
+
+			CompileMaterial(results[index], compiler.Get(), &dirtyMaterials[index / platformCount]->File);
+		});
+
+	for (size_t m = 0; m < dirtyMaterials.size(); m++)
+	{
+		auto material = dirtyMaterials[m];
+		Effekseer::CompiledMaterial compiledMaterial;
+		bool isSucceeded = true;
+
+		for (int32_t p = 0; p < platformCount; p++)
+		{
+			const auto& result = results[m * platformCount + p];
+			if (!result.IsSucceeded)
+			{
+				std::cout << "Failed to compile " << material->InputPath.string() << " for " << compilers[p].Name << std::endl;
+				isSucceeded = false;
+				continue;
+			}
+
+			compiledMaterial.UpdateData(result.VertexShaders[0],
+										result.PixelShaders[0],
+										result.VertexShaders[1],
+										result.PixelShaders[1],
+										result.VertexShaders[2],
+										result.PixelShaders[2],
+										result.VertexShaders[3],
+										result.PixelShaders[3],
+										compilers[p].Type);
+		}
+
+		std::vector<uint8_t> cooked;
+		compiledMaterial.Save(cooked, material->File.GetGUID(), material->Data);
+
+		std::filesystem::create_directories(material->OutputPath.parent_path(), ec);
+		std::ofstream output(material->OutputPath, std::ios::binary | std::ios::trunc);
+		if (!output)
+		{
+			std::cout << "Failed to open " << material->OutputPath.string() << std::endl;
+			failedCount++;
+			continue;
+		}
+
+		output.write(reinterpret_cast<const char*>(cooked.data()), cooked.size());
+		std::cout << material->InputPath.string() << " -> " << material->OutputPath.string() << " (" << cooked.size() << " bytes)" << std::endl;
+
+		// a material which failed to compile for some platforms is compiled again at the next time
+		if (isSucceeded)
+		{
+			newManifest[material->RelativePath] = material->Hash;
+		}
+		else
+		{
+			failedCount++;
+		}
+	}
+
+	std::filesystem::create_directories(outputDirectory, ec);
+	if (!SaveManifest(manifestPath, newManifest))
+	{
+		std::cout << "Failed to open " << manifestPath.string() << std::endl;
+		return 1;
+	}
+
+	std::cout << materials.size() << " materials : " << dirtyMaterials.size() << " compiled, " << skippedCount << " skipped, " << failedCount << " failed" << std::endl;
+
+	return failedCount > 0 ? 1 : 0;
+}
@@ -80,6 +80,16 @@ std::array<std::array<float, 4>, 13> ToUniform(const Effekseer::Gradient& gradie
 	return ret;
 }
 
+void CalcBillboardAxes(::Effekseer::SIMD::Vec3f& right,
+					   ::Effekseer::SIMD::Vec3f& up,
+					   const ::Effekseer::SIMD::Vec3f& frontDirection)
+{
+	::Effekseer::SIMD::Vec3f Up(0.0f, 1.0f, 0.0f);
+
+	right = ::Effekseer::SIMD::Vec3f::Cross(Up, frontDirection).Normalize();
+	up = ::Effekseer::SIMD::Vec3f::Cross(frontDirection, right).Normalize();
+}
+
 void CalcBillboard(::Effekseer::BillboardType billboardType,
 				   Effekseer::SIMD::Mat43f& dst,
 				   ::Effekseer::SIMD::Vec3f& s,
@@ -101,19 +111,13 @@ void CalcBillboard(::Effekseer::BillboardType billboardType,
 
 		if (billboardType == ::Effekseer::BillboardType::Billboard)
 		{
-			::Effekseer::SIMD::Vec3f Up(0.0f, 1.0f, 0.0f);
-
 			F = frontDir;
-			R = ::Effekseer::SIMD::Vec3f::Cross(Up, F).Normalize();
-			U = ::Effekseer::SIMD::Vec3f::Cross(F, R).Normalize();
+			CalcBillboardAxes(R, U, F);
 		}
 		else if (billboardType == ::Effekseer::BillboardType::RotatedBillboard)
 		{
-			::Effekseer::SIMD::Vec3f Up(0.0f, 1.0f, 0.0f);
-
 			F = frontDir;
-			R = ::Effekseer::SIMD::Vec3f::Cross(Up, F).Normalize();
-			U = ::Effekseer::SIMD::Vec3f::Cross(F, R).Normalize();
+			CalcBillboardAxes(R, U, F);
 
 			float c_zx2 = Effekseer::SIMD::Vec3f::Dot(r.Y, r.Y) - r.Y.GetZ() * r.Y.GetZ();
 			float c_zx = sqrt(std::max(0.0f, c_zx2));
@@ -609,6 +613,83 @@ Effekseer::Backend::VertexLayoutRef GetVertexLayout(Effekseer::Backend::Graphics
 	return {};
 }
 
+Effekseer::Backend::VertexLayoutRef GetCompactVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, RendererShaderType type)
+{
+	if (type == RendererShaderType::Unlit)
+	{
+		const Effekseer::Backend::VertexLayoutElement vlElemSprite[3] = {
+			{Effekseer::Backend::VertexLayoutFormat::R32G32B32_FLOAT, "Input_Pos", "POSITION", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Color", "NORMAL", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_UV", "TEXCOORD", 0},
+		};
+
+		return graphicsDevice->CreateVertexLayout(vlElemSprite, 3);
+	}
+	else if (type == RendererShaderType::AdvancedUnlit)
+	{
+		const Effekseer::Backend::VertexLayoutElement vlElemUnlitAd[8] = {
+			{Effekseer::Backend::VertexLayoutFormat::R32G32B32_FLOAT, "Input_Pos", "POSITION", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Color", "NORMAL", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_UV", "TEXCOORD", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT, "Input_Alpha_Dist_UV", "TEXCOORD", 1},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_BlendUV", "TEXCOORD", 2},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT, "Input_Blend_Alpha_Dist_UV", "TEXCOORD", 3},
+			{Effekseer::Backend::VertexLayoutFormat::R32_FLOAT, "Input_FlipbookIndex", "TEXCOORD", 4},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_AlphaThreshold", "TEXCOORD", 5},
+		};
+
+		return graphicsDevice->CreateVertexLayout(vlElemUnlitAd, 8);
+	}
+	else if (type == RendererShaderType::Lit || type == RendererShaderType::BackDistortion)
+	{
+		const Effekseer::Backend::VertexLayoutElement vlElemLit[6] = {
+			{Effekseer::Backend::VertexLayoutFormat::R32G32B32_FLOAT, "Input_Pos", "POSITION", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Color", "NORMAL", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Normal", "NORMAL", 1},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Tangent", "NORMAL", 2},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_UV1", "TEXCOORD", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_UV2", "TEXCOORD", 1},
+		};
+
+		return graphicsDevice->CreateVertexLayout(vlElemLit, 6);
+	}
+	else if (type == RendererShaderType::AdvancedLit || type == RendererShaderType::AdvancedBackDistortion)
+	{
+		const Effekseer::Backend::VertexLayoutElement vlElemLitAd[11] = {
+			{Effekseer::Backend::VertexLayoutFormat::R32G32B32_FLOAT, "Input_Pos", "POSITION", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Color", "NORMAL", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Normal", "NORMAL", 1},
+			{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Tangent", "NORMAL", 2},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_UV1", "TEXCOORD", 0},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_UV2", "TEXCOORD", 1},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT, "Input_Alpha_Dist_UV", "TEXCOORD", 2},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_BlendUV", "TEXCOORD", 3},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT, "Input_Blend_Alpha_Dist_UV", "TEXCOORD", 4},
+			{Effekseer::Backend::VertexLayoutFormat::R32_FLOAT, "Input_FlipbookIndex", "TEXCOORD", 5},
+			{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_AlphaThreshold", "TEXCOORD", 6},
+		};
+
+		return graphicsDevice->CreateVertexLayout(vlElemLitAd, 11);
+	}
+
+	assert(0);
+
+	return {};
+}
+
+Effekseer::Backend::VertexLayoutRef GetSpriteInstanceVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice)
+{
+	const Effekseer::Backend::VertexLayoutElement vlElem[5] = {
+		{Effekseer::Backend::VertexLayoutFormat::R32G32B32_FLOAT, "Input_Pos", "POSITION", 0},
+		{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_Color", "NORMAL", 0},
+		{Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT, "Input_Rotation", "TEXCOORD", 0},
+		{Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT, "Input_UV", "TEXCOORD", 1},
+		{Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT, "Input_Extent", "TEXCOORD", 2},
+	};
+
+	return graphicsDevice->CreateVertexLayout(vlElem, 5);
+}
+
 Effekseer::Backend::VertexLayoutRef GetModelRendererVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice)
 {
 	const Effekseer::Backend::VertexLayoutElement vlElem[6] = {
@@ -623,6 +704,19 @@ Effekseer::Backend::VertexLayoutRef GetModelRendererVertexLayout(Effekseer::Back
 	return graphicsDevice->CreateVertexLayout(vlElem, 6);
 }
 
+Effekseer::Backend::VertexLayoutRef GetModelRendererInstanceVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice)
+{
+	const Effekseer::Backend::VertexLayoutElement vlElem[5] = {
+		{Effekseer::Backend::VertexLayoutFormat::R32G32B32A32_FLOAT, "Input_Model0", "TEXCOORD", 1},
+		{Effekseer::Backend::VertexLayoutFormat::R32G32B32A32_FLOAT, "Input_Model1", "TEXCOORD", 2},
+		{Effekseer::Backend::VertexLayoutFormat::R32G32B32A32_FLOAT, "Input_Model2", "TEXCOORD", 3},
+		{Effekseer::Backend::VertexLayoutFormat::R32G32B32A32_FLOAT, "Input_ModelUV", "TEXCOORD", 4},
+		{Effekseer::Backend::VertexLayoutFormat::R8G8B8A8_UNORM, "Input_ModelColor", "NORMAL", 4},
+	};
+
+	return graphicsDevice->CreateVertexLayout(vlElem, 5);
+}
+
 Effekseer::Backend::VertexLayoutRef GetMaterialSimpleVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice)
 {
 	const Effekseer::Backend::VertexLayoutElement vlElem[3] = {
@@ -47,6 +47,106 @@ inline Effekseer::Vector3D UnpackVector3DF(const Effekseer::Color& v)
 	return ret;
 }
 
+inline uint16_t PackHalfFloat(float value)
+{
+	uint32_t bits = 0;
+	memcpy(&bits, &value, sizeof(float));
+
+	const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+	const auto exponent = static_cast<int32_t>((bits >> 23) & 0xFF);
+	auto mantissa = bits & 0x7FFFFF;
+
+	// NaN or infinity
+	if (exponent == 0xFF)
+	{
+		return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+	}
+
+	const auto halfExponent = exponent - 127 + 15;
+
+	if (halfExponent >= 31)
+	{
+		return sign | 0x7C00;
+	}
+
+	if (halfExponent <= 0)
+	{
+		// denormalized
+		if (halfExponent < -10)
+		{
+			return sign;
+		}
+
+		mantissa |= 0x800000;
+		const auto shift = 14 - halfExponent;
+		auto half = static_cast<uint16_t>(mantissa >> shift);
+		const auto remainder = mantissa & ((1u << shift) - 1);
+		const auto halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (half & 1)))
+		{
+			half++;
+		}
+		return sign | half;
+	}
+
+	auto half = static_cast<uint16_t>(sign | (halfExponent << 10) | (mantissa >> 13));
+
+	// round to nearest even like GPU. a carry moves to the exponent correctly
+	const auto remainder = mantissa & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+	{
+		half++;
+	}
+
+	return half;
+}
+
+inline float UnpackHalfFloat(uint16_t value)
+{
+	const auto sign = static_cast<uint32_t>(value & 0x8000) << 16;
+	const auto exponent = static_cast<uint32_t>((value >> 10) & 0x1F);
+	const auto mantissa = static_cast<uint32_t>(value & 0x3FF);
+
+	if (exponent == 0)
+	{
+		const auto v = static_cast<float>(mantissa) / 16777216.0f;
+		return sign != 0 ? -v : v;
+	}
+
+	uint32_t bits = 0;
+	if (exponent == 31)
+	{
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else
+	{
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+
+	float ret = 0.0f;
+	memcpy(&ret, &bits, sizeof(float));
+	return ret;
+}
+
+/**
+	@brief	a half float in a vertex which is converted from and into float implicitly
+*/
+struct VertexHalf
+{
+	uint16_t Value;
+
+	VertexHalf& operator=(float value)
+	{
+		Value = PackHalfFloat(value);
+		return *this;
+	}
+
+	operator float() const
+	{
+		return UnpackHalfFloat(Value);
+	}
+};
+
 struct DynamicVertex
 {
 	VertexFloat3 Pos;
@@ -347,6 +447,299 @@ struct AdvancedSimpleVertex
 	}
 };
 
+/**
+	@brief	a compact version of SimpleVertex
+	@note	UVs lose precision when they are far from 0
+*/
+struct CompactSimpleVertex
+{
+	VertexFloat3 Pos;
+	VertexColor Col;
+
+	union
+	{
+		VertexHalf UV[2];
+		//! dummy for template
+		VertexHalf UV2[2];
+	};
+
+	void SetFlipbookIndexAndNextRate(float value)
+	{
+	}
+	void SetAlphaThreshold(float value)
+	{
+	}
+
+	void SetColor(const VertexColor& color, bool flipRGB)
+	{
+		Col = color;
+
+		if (flipRGB)
+		{
+			std::swap(Col.R, Col.B);
+		}
+	}
+
+	void SetPackedNormal(const VertexColor& normal, bool flipRGB)
+	{
+	}
+
+	void SetPackedTangent(const VertexColor& tangent, bool flipRGB)
+	{
+	}
+
+	void SetUV2(float u, float v)
+	{
+	}
+};
+
+/**
+	@brief	a compact version of LightingVertex
+	@note	UVs lose precision when they are far from 0
+*/
+struct CompactLightingVertex
+{
+	VertexFloat3 Pos;
+	VertexColor Col;
+	//! packed vector
+	VertexColor Normal;
+	//! packed vector
+	VertexColor Tangent;
+
+	union
+	{
+		//! UV1 (for template)
+		VertexHalf UV[2];
+		VertexHalf UV1[2];
+	};
+
+	VertexHalf UV2[2];
+
+	void SetFlipbookIndexAndNextRate(float value)
+	{
+	}
+	void SetAlphaThreshold(float value)
+	{
+	}
+
+	void SetColor(const VertexColor& color, bool flipRGB)
+	{
+		Col = color;
+
+		if (flipRGB)
+		{
+			std::swap(Col.R, Col.B);
+		}
+	}
+
+	void SetPackedNormal(const VertexColor& normal, bool flipRGB)
+	{
+		Normal = normal;
+
+		if (flipRGB)
+		{
+			std::swap(Normal.R, Normal.B);
+		}
+	}
+
+	void SetPackedTangent(const VertexColor& tangent, bool flipRGB)
+	{
+		Tangent = tangent;
+
+		if (flipRGB)
+		{
+			std::swap(Tangent.R, Tangent.B);
+		}
+	}
+
+	void SetUV2(float u, float v)
+	{
+		UV2[0] = u;
+		UV2[1] = v;
+	}
+};
+
+/**
+	@brief	a compact version of AdvancedLightingVertex
+	@note	UVs lose precision when they are far from 0. FlipbookIndexAndNextRate keeps a float because an index is large.
+*/
+struct CompactAdvancedLightingVertex
+{
+	VertexFloat3 Pos;
+	VertexColor Col;
+	//! packed vector
+	VertexColor Normal;
+	//! packed vector
+	VertexColor Tangent;
+
+	union
+	{
+		//! UV1 (for template)
+		VertexHalf UV[2];
+		VertexHalf UV1[2];
+	};
+
+	VertexHalf UV2[2];
+
+	VertexHalf AlphaUV[2];
+	VertexHalf UVDistortionUV[2];
+	VertexHalf BlendUV[2];
+	VertexHalf BlendAlphaUV[2];
+	VertexHalf BlendUVDistortionUV[2];
+	float FlipbookIndexAndNextRate;
+	VertexHalf AlphaThreshold;
+	//! it is read as y of AlphaThreshold by a shader, so it is written with AlphaThreshold
+	uint16_t Padding;
+
+	void SetFlipbookIndexAndNextRate(float value)
+	{
+		FlipbookIndexAndNextRate = value;
+	}
+	void SetAlphaThreshold(float value)
+	{
+		AlphaThreshold = value;
+		Padding = 0;
+	}
+
+	void SetColor(const VertexColor& color, bool flipRGB)
+	{
+		Col = color;
+
+		if (flipRGB)
+		{
+			std::swap(Col.R, Col.B);
+		}
+	}
+
+	void SetPackedNormal(const VertexColor& normal, bool flipRGB)
+	{
+		Normal = normal;
+
+		if (flipRGB)
+		{
+			std::swap(Normal.R, Normal.B);
+		}
+	}
+
+	void SetPackedTangent(const VertexColor& tangent, bool flipRGB)
+	{
+		Tangent = tangent;
+
+		if (flipRGB)
+		{
+			std::swap(Tangent.R, Tangent.B);
+		}
+	}
+
+	void SetUV2(float u, float v)
+	{
+		UV2[0] = u;
+		UV2[1] = v;
+	}
+};
+
+/**
+	@brief	a compact version of AdvancedSimpleVertex
+	@note	UVs lose precision when they are far from 0. FlipbookIndexAndNextRate keeps a float because an index is large.
+*/
+struct CompactAdvancedSimpleVertex
+{
+	VertexFloat3 Pos;
+	VertexColor Col;
+
+	union
+	{
+		VertexHalf UV[2];
+		//! dummy for template
+		VertexHalf UV1[2];
+		//! dummy for template
+		VertexHalf UV2[2];
+	};
+
+	VertexHalf AlphaUV[2];
+	VertexHalf UVDistortionUV[2];
+	VertexHalf BlendUV[2];
+	VertexHalf BlendAlphaUV[2];
+	VertexHalf BlendUVDistortionUV[2];
+	float FlipbookIndexAndNextRate;
+	VertexHalf AlphaThreshold;
+	//! it is read as y of AlphaThreshold by a shader, so it is written with AlphaThreshold
+	uint16_t Padding;
+
+	void SetFlipbookIndexAndNextRate(float value)
+	{
+		FlipbookIndexAndNextRate = value;
+	}
+	void SetAlphaThreshold(float value)
+	{
+		AlphaThreshold = value;
+		Padding = 0;
+	}
+
+	void SetColor(const VertexColor& color, bool flipRGB)
+	{
+		Col = color;
+
+		if (flipRGB)
+		{
+			std::swap(Col.R, Col.B);
+		}
+	}
+
+	void SetPackedNormal(const VertexColor& normal, bool flipRGB)
+	{
+	}
+
+	void SetPackedTangent(const VertexColor& tangent, bool flipRGB)
+	{
+	}
+
+	void SetUV2(float u, float v)
+	{
+	}
+};
+
+/**
+	@brief	a record of a sprite which is expanded into a quad by a vertex shader
+	@note	Corners are calculated from billboard axes in a constant buffer.
+*/
+struct SpriteInstanceVertex
+{
+	//! a center of the sprite
+	VertexFloat3 Pos;
+	VertexColor Col;
+
+	//! a rotation around the front axis multiplied by a scale of the depth parameter (cos, sin)
+	VertexHalf Rotation[2];
+
+	//! left, top, right and bottom of UV
+	VertexHalf UV[4];
+
+	//! left, bottom, right and top of the sprite in billboard space
+	VertexHalf Extent[4];
+
+	void SetColor(const VertexColor& color, bool flipRGB)
+	{
+		Col = color;
+
+		if (flipRGB)
+		{
+			std::swap(Col.R, Col.B);
+		}
+	}
+};
+
+/**
+	@brief	per instance data of a model which is read from a vertex stream instead of a constant buffer
+*/
+struct ModelRendererInstanceVertex
+{
+	//! the first three columns of a model matrix
+	float ModelMatrix[3][4];
+	float ModelUV[4];
+	VertexColor ModelColor;
+};
+
 template <typename U>
 class ContainAdvancedData
 {
@@ -375,6 +768,20 @@ public:
 	using Value = float;
 };
 
+template <>
+class ContainAdvancedData<CompactSimpleVertex>
+{
+public:
+	using Value = float;
+};
+
+template <>
+class ContainAdvancedData<CompactLightingVertex>
+{
+public:
+	using Value = float;
+};
+
 template <typename U>
 using enable_if_contain_advanced_t = typename std::enable_if<std::is_same<typename ContainAdvancedData<U>::Value, int>::value, std::nullptr_t>::type;
 
@@ -577,6 +984,18 @@ inline bool VertexNormalRequired<AdvancedLightingVertex>()
 	return true;
 }
 
+template <>
+inline bool VertexNormalRequired<CompactLightingVertex>()
+{
+	return true;
+}
+
+template <>
+inline bool VertexNormalRequired<CompactAdvancedLightingVertex>()
+{
+	return true;
+}
+
 template <typename T>
 inline bool VertexUV2Required()
 {
@@ -644,6 +1063,13 @@ struct StrideView
 
 std::array<std::array<float, 4>, 13> ToUniform(const Effekseer::Gradient& gradient);
 
+/**
+	@brief	calculate right and up axes of a billboard which faces frontDirection
+*/
+void CalcBillboardAxes(::Effekseer::SIMD::Vec3f& right,
+					   ::Effekseer::SIMD::Vec3f& up,
+					   const ::Effekseer::SIMD::Vec3f& frontDirection);
+
 void CalcBillboard(::Effekseer::BillboardType billboardType,
 				   Effekseer::SIMD::Mat43f& dst,
 				   ::Effekseer::SIMD::Vec3f& s,
@@ -1574,8 +2000,23 @@ void CalculateAlignedTextureInformation(Effekseer::Backend::TextureFormatType fo
 //! only support OpenGL, DirectX11
 Effekseer::Backend::VertexLayoutRef GetVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, RendererShaderType type);
 
+/**
+	@brief	get a vertex layout of compact vertices. Inputs of shaders are the same as GetVertexLayout.
+*/
+Effekseer::Backend::VertexLayoutRef GetCompactVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, RendererShaderType type);
+
+/**
+	@brief	get a vertex layout of SpriteInstanceVertex
+*/
+Effekseer::Backend::VertexLayoutRef GetSpriteInstanceVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice);
+
 Effekseer::Backend::VertexLayoutRef GetModelRendererVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice);
 
+/**
+	@brief	get a vertex layout of ModelRendererInstanceVertex
+*/
+Effekseer::Backend::VertexLayoutRef GetModelRendererInstanceVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice);
+
 Effekseer::Backend::VertexLayoutRef GetMaterialSimpleVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice);
 
 Effekseer::Backend::VertexLayoutRef GetMaterialSpriteVertexLayout(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, int32_t customData1, int32_t customData2);
@@ -1675,6 +2116,8 @@ inline RendererStateFlipbook ToState(const Effekseer::NodeRendererFlipbookParame
 template <typename T>
 bool GenerateIndexDataStride(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, int32_t squareMaxCount, Effekseer::Backend::IndexBufferRef& indexBuffer, Effekseer::Backend::IndexBufferRef& indexBufferForWireframe)
 {
+	const auto stride = sizeof(T) == 4 ? Effekseer::Backend::IndexBufferStrideType::Stride4 : Effekseer::Backend::IndexBufferStrideType::Stride2;
+
 	{
 		std::vector<T> buffer;
 		buffer.resize(squareMaxCount * 6);
@@ -1689,7 +2132,7 @@ bool GenerateIndexDataStride(Effekseer::Backend::GraphicsDeviceRef graphicsDevic
 			buffer[5 + i * 6] = (T)(2 + 4 * i);
 		}
 
-		indexBuffer = graphicsDevice->CreateIndexBuffer(squareMaxCount * 6, buffer.data(), Effekseer::Backend::IndexBufferStrideType::Stride2);
+		indexBuffer = graphicsDevice->CreateIndexBuffer(squareMaxCount * 6, buffer.data(), stride);
 		if (indexBuffer == nullptr)
 			return false;
 	}
@@ -1710,7 +2153,7 @@ bool GenerateIndexDataStride(Effekseer::Backend::GraphicsDeviceRef graphicsDevic
 			buffer[7 + i * 8] = (T)(3 + 4 * i);
 		}
 
-		indexBufferForWireframe = graphicsDevice->CreateIndexBuffer(squareMaxCount * 8, buffer.data(), Effekseer::Backend::IndexBufferStrideType::Stride2);
+		indexBufferForWireframe = graphicsDevice->CreateIndexBuffer(squareMaxCount * 8, buffer.data(), stride);
 		if (indexBufferForWireframe == nullptr)
 			return false;
 	}
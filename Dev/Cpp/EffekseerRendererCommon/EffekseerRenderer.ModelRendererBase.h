@@ -253,6 +253,10 @@ protected:
 	int32_t customData1Count_ = 0;
 	int32_t customData2Count_ = 0;
 
+	std::vector<ModelRendererInstanceVertex> instanceVertices_;
+
+	std::vector<int32_t> frameOrder_;
+
 	ShaderParameterCollector collector_;
 
 	void ColorToFloat4(::Effekseer::Color color, float fc[4])
@@ -289,6 +293,20 @@ protected:
 	{
 	}
 
+	//! only backends which support instance buffers have DrawPolygonInstancedWithBuffer
+	template <typename RENDERER, typename SHADER>
+	static auto DrawPolygonInstancedWithBuffer(RENDERER* renderer, SHADER* shader, const ModelRendererInstanceVertex* instances, int32_t vertexCount, int32_t indexCount, int32_t instanceCount)
+		-> decltype(renderer->DrawPolygonInstancedWithBuffer(shader, instances, vertexCount, indexCount, instanceCount))
+	{
+		renderer->DrawPolygonInstancedWithBuffer(shader, instances, vertexCount, indexCount, instanceCount);
+	}
+
+	template <typename RENDERER, typename SHADER, typename... Args>
+	static void DrawPolygonInstancedWithBuffer(RENDERER* renderer, SHADER* shader, const ModelRendererInstanceVertex* instances, int32_t vertexCount, int32_t indexCount, int32_t instanceCount, Args...)
+	{
+		assert(0);
+	}
+
 	template <typename RENDERER>
 	void GetInversedFlags(RENDERER* renderer, std::array<float, 4>& uvInversed, std::array<float, 4>& uvInversedBack)
 	{
@@ -821,6 +839,82 @@ public:
 		// parameter.BasicParameterPtr
 	}
 
+	template <typename T>
+	static void ReorderValues(std::vector<T>& values, std::vector<T>& sorted, const std::vector<int32_t>& order)
+	{
+		sorted.resize(order.size());
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			sorted[i] = values[order[i]];
+		}
+		std::swap(values, sorted);
+	}
+
+	//! whether the result is same regardless of an order of instances
+	static bool IsDrawingOrderIndependent(const efkModelNodeParam& param)
+	{
+		if (param.DepthParameterPtr->ZSort != Effekseer::ZSortType::None)
+		{
+			return false;
+		}
+
+		// a depth written by a previous instance changes a result
+		if (param.ZWrite)
+		{
+			return false;
+		}
+
+		const auto alphaBlend = param.BasicParameterPtr->AlphaBlend;
+		return alphaBlend == Effekseer::AlphaBlendType::Add || alphaBlend == Effekseer::AlphaBlendType::Sub || alphaBlend == Effekseer::AlphaBlendType::Mul;
+	}
+
+	/**
+		@brief
+		\~English	Sort instances by frames of a model stably so that instances with same frames are drawn by one instanced draw call.
+		\~Japanese	同じフレームのインスタンスが1回のインスタンス描画で描画されるように、モデルのフレームでインスタンスを安定ソートする。
+	*/
+	void SortTemporaryValuesByFrame(int32_t frameCount)
+	{
+		auto compare = [this, frameCount](int32_t a, int32_t b) -> bool
+		{ return m_times[a] % frameCount < m_times[b] % frameCount; };
+
+		frameOrder_.resize(m_matrixes.size());
+		for (size_t i = 0; i < frameOrder_.size(); i++)
+		{
+			frameOrder_[i] = static_cast<int32_t>(i);
+		}
+
+		if (std::is_sorted(frameOrder_.begin(), frameOrder_.end(), compare))
+		{
+			return;
+		}
+
+		std::stable_sort(frameOrder_.begin(), frameOrder_.end(), compare);
+
+		ReorderValues(m_matrixes, matrixesSorted_, frameOrder_);
+		ReorderValues(m_uv, uvSorted_, frameOrder_);
+		ReorderValues(m_alphaUV, alphaUVSorted_, frameOrder_);
+		ReorderValues(m_uvDistortionUV, uvDistortionUVSorted_, frameOrder_);
+		ReorderValues(m_blendUV, blendUVSorted_, frameOrder_);
+		ReorderValues(m_blendAlphaUV, blendAlphaUVSorted_, frameOrder_);
+		ReorderValues(m_blendUVDistortionUV, blendUVDistortionUVSorted_, frameOrder_);
+		ReorderValues(m_flipbookIndexAndNextRate, flipbookIndexAndNextRateSorted_, frameOrder_);
+		ReorderValues(m_alphaThreshold, alphaThresholdSorted_, frameOrder_);
+		ReorderValues(m_viewOffsetDistance, viewOffsetDistanceSorted_, frameOrder_);
+		ReorderValues(m_colors, colorsSorted_, frameOrder_);
+		ReorderValues(m_times, timesSorted_, frameOrder_);
+
+		if (customData1Count_ > 0)
+		{
+			ReorderValues(customData1_, customData1Sorted_, frameOrder_);
+		}
+
+		if (customData2Count_ > 0)
+		{
+			ReorderValues(customData2_, customData2Sorted_, frameOrder_);
+		}
+	}
+
 	template <typename RENDERER, typename SHADER, typename MODEL, bool Instancing, int InstanceCount>
 	void EndRendering_(RENDERER* renderer,
 					   SHADER* advanced_shader_lit,
@@ -830,7 +924,8 @@ public:
 					   SHADER* shader_unlit,
 					   SHADER* shader_distortion,
 					   const efkModelNodeParam& param,
-					   void* userData)
+					   void* userData,
+					   SHADER* shader_unlit_instance_buffer = nullptr)
 	{
 		if (m_matrixes.size() == 0)
 			return;
@@ -861,6 +956,25 @@ public:
 		// sort
 		SortTemporaryValues(renderer, param);
 
+		if (Instancing && IsDrawingOrderIndependent(param))
+		{
+			::Effekseer::RefPtr<MODEL> model;
+
+			if (param.IsProceduralMode)
+			{
+				model = param.EffectPointer->GetProceduralModel(param.ModelIndex);
+			}
+			else
+			{
+				model = param.EffectPointer->GetModel(param.ModelIndex);
+			}
+
+			if (model != nullptr && model->GetFrameCount() > 1)
+			{
+				SortTemporaryValuesByFrame(model->GetFrameCount());
+			}
+		}
+
 		for (int32_t renderPassInd = 0; renderPassInd < renderPassCount; renderPassInd++)
 		{
 			Effekseer::MaterialRenderData* materialRenderData = param.BasicParameterPtr->MaterialRenderDataPtr;
@@ -869,19 +983,19 @@ public:
 				param.EffectPointer->GetMaterial(materialRenderData->MaterialIndex) != nullptr)
 			{
 				RenderPass<RENDERER, SHADER, MODEL, Instancing, InstanceCount, ModelRendererMaterialVertexConstantBuffer<InstanceCount>, false>(
-					renderer, advanced_shader_lit, advanced_shader_unlit, advanced_shader_distortion, shader_lit, shader_unlit, shader_distortion, param, renderPassInd, userData);
+					renderer, advanced_shader_lit, advanced_shader_unlit, advanced_shader_distortion, shader_lit, shader_unlit, shader_distortion, param, renderPassInd, userData, shader_unlit_instance_buffer);
 			}
 			else
 			{
 				if (collector_.DoRequireAdvancedRenderer())
 				{
 					RenderPass<RENDERER, SHADER, MODEL, Instancing, InstanceCount, ModelRendererAdvancedVertexConstantBuffer<InstanceCount>, true>(
-						renderer, advanced_shader_lit, advanced_shader_unlit, advanced_shader_distortion, shader_lit, shader_unlit, shader_distortion, param, renderPassInd, userData);
+						renderer, advanced_shader_lit, advanced_shader_unlit, advanced_shader_distortion, shader_lit, shader_unlit, shader_distortion, param, renderPassInd, userData, shader_unlit_instance_buffer);
 				}
 				else
 				{
 					RenderPass<RENDERER, SHADER, MODEL, Instancing, InstanceCount, ModelRendererVertexConstantBuffer<InstanceCount>, false>(
-						renderer, advanced_shader_lit, advanced_shader_unlit, advanced_shader_distortion, shader_lit, shader_unlit, shader_distortion, param, renderPassInd, userData);
+						renderer, advanced_shader_lit, advanced_shader_unlit, advanced_shader_distortion, shader_lit, shader_unlit, shader_distortion, param, renderPassInd, userData, shader_unlit_instance_buffer);
 				}
 			}
 		}
@@ -897,7 +1011,8 @@ public:
 					SHADER* shader_distortion,
 					const efkModelNodeParam& param,
 					int32_t renderPassInd,
-					void* userData)
+					void* userData,
+					SHADER* shader_unlit_instance_buffer)
 	{
 		if (m_matrixes.size() == 0)
 			return;
@@ -1029,6 +1144,15 @@ public:
 			return;
 		}
 
+		// all instances are drawn at once with a buffer instead of constant buffers
+		const bool isInstanceBufferUsed = Instancing && shader_ == shader_unlit && shader_unlit_instance_buffer != nullptr &&
+										  renderer->GetExternalShaderSettings() == nullptr && m_matrixes.size() > 1;
+
+		if (isInstanceBufferUsed)
+		{
+			shader_ = shader_unlit_instance_buffer;
+		}
+
 		RenderStateBase::State& state = renderer->GetRenderState()->Push();
 		state.DepthTest = param.ZTest;
 		state.DepthWrite = param.ZWrite;
@@ -1089,121 +1213,168 @@ public:
 		renderer->GetImpl()->CurrentRenderingUserData = param.UserData;
 		renderer->GetImpl()->CurrentHandleUserData = userData;
 
-		// Check time
-		auto stTime0 = m_times[0] % model->GetFrameCount();
-		auto isTimeSame = true;
+		const auto getModelMatrix = [&](size_t index) -> Effekseer::Matrix44 {
+			::Effekseer::SIMD::Mat44f modelMatrix = m_matrixes[index];
 
-		for (auto t : m_times)
-		{
-			t = t % model->GetFrameCount();
-			if (t != stTime0)
+			if (param.EnableViewOffset)
 			{
-				isTimeSame = false;
-				break;
+				ApplyViewOffset(modelMatrix, renderer->GetCameraMatrix(), m_viewOffsetDistance[index]);
 			}
-		}
-
-		if (Instancing && isTimeSame)
-		{
-			// auto& imodel = model->InternalModels[stTime0];
 
-			// Invalid unless layout is set after buffer
-			renderer->SetVertexBuffer(model->GetVertexBuffer(stTime0), sizeof(Effekseer::Model::Vertex));
+			ApplyDepthParameters(modelMatrix,
+								 renderer->GetCameraFrontDirection(),
+								 renderer->GetCameraPosition(),
+								 param.DepthParameterPtr,
+								 param.IsRightHand);
+			return ToStruct(modelMatrix);
+		};
 
-			int32_t indexPerFace = 3;
-			if (renderer->GetRenderMode() == Effekseer::RenderMode::Wireframe)
-			{
-				renderer->SetIndexBuffer(model->GetWireIndexBuffer(stTime0));
-				indexPerFace = 6;
-			}
-			else
+		if (Instancing)
+		{
+			for (size_t loop = 0; loop < m_matrixes.size();)
 			{
-				renderer->SetIndexBuffer(model->GetIndexBuffer(stTime0));
-			}
+				// instances whose frames of the model are same are drawn together without changing an order
+				// frames which share buffers are also drawn together
+				const auto stTime = m_times[loop] % model->GetFrameCount();
+				auto isSameBuffer = [&](int32_t time) -> bool
+				{
+					time = time % model->GetFrameCount();
+					if (time == stTime)
+					{
+						return true;
+					}
 
-			renderer->SetLayout(shader_);
+					return model->GetVertexBuffer(stTime) != nullptr &&
+						   model->GetVertexBuffer(time) == model->GetVertexBuffer(stTime) &&
+						   model->GetIndexBuffer(time) == model->GetIndexBuffer(stTime);
+				};
 
-			for (size_t loop = 0; loop < m_matrixes.size();)
-			{
-				int32_t modelCount = Effekseer::Min(static_cast<int32_t>(m_matrixes.size()) - (int32_t)loop, InstanceCount);
+				size_t loopEnd = loop + 1;
+				while (loopEnd < m_matrixes.size() && isSameBuffer(m_times[loopEnd]))
+				{
+					loopEnd++;
+				}
 
-				for (int32_t num = 0; num < modelCount; num++)
+				// Invalid unless layout is set after buffer
+				renderer->SetVertexBuffer(model->GetVertexBuffer(stTime), sizeof(Effekseer::Model::Vertex));
+
+				int32_t indexPerFace = 3;
+				if (renderer->GetRenderMode() == Effekseer::RenderMode::Wireframe)
 				{
-					vcb->ModelMatrix[num] = m_matrixes[loop + num];
+					renderer->SetIndexBuffer(model->GetWireIndexBuffer(stTime));
+					indexPerFace = 6;
+				}
+				else
+				{
+					renderer->SetIndexBuffer(model->GetIndexBuffer(stTime));
+				}
 
-					// DepthParameter
-					::Effekseer::SIMD::Mat44f modelMatrix = vcb->ModelMatrix[num];
+				renderer->SetLayout(shader_);
 
-					if (param.EnableViewOffset)
+				if (isInstanceBufferUsed)
+				{
+					instanceVertices_.resize(loopEnd - loop);
+
+					for (size_t num = 0; num < instanceVertices_.size(); num++)
 					{
-						ApplyViewOffset(modelMatrix, renderer->GetCameraMatrix(), m_viewOffsetDistance[loop + num]);
+						auto& instance = instanceVertices_[num];
+						const auto modelMatrix = getModelMatrix(loop + num);
+
+						for (int32_t c = 0; c < 3; c++)
+						{
+							for (int32_t r = 0; r < 4; r++)
+							{
+								instance.ModelMatrix[c][r] = modelMatrix.Values[r][c];
+							}
+						}
+
+						instance.ModelUV[0] = m_uv[loop + num].X;
+						instance.ModelUV[1] = m_uv[loop + num].Y;
+						instance.ModelUV[2] = m_uv[loop + num].Width;
+						instance.ModelUV[3] = m_uv[loop + num].Height;
+						instance.ModelColor = m_colors[loop + num];
 					}
 
-					ApplyDepthParameters(modelMatrix,
-										 renderer->GetCameraFrontDirection(),
-										 renderer->GetCameraPosition(),
-										 param.DepthParameterPtr,
-										 param.IsRightHand);
-					vcb->ModelMatrix[num] = ToStruct(modelMatrix);
-
-					vcb->ModelUV[num][0] = m_uv[loop + num].X;
-					vcb->ModelUV[num][1] = m_uv[loop + num].Y;
-					vcb->ModelUV[num][2] = m_uv[loop + num].Width;
-					vcb->ModelUV[num][3] = m_uv[loop + num].Height;
-
-					vcb->SetModelAlphaUV(
-						num, m_alphaUV[loop + num].X, m_alphaUV[loop + num].Y, m_alphaUV[loop + num].Width, m_alphaUV[loop + num].Height);
-					vcb->SetModelUVDistortionUV(num,
-												m_uvDistortionUV[loop + num].X,
-												m_uvDistortionUV[loop + num].Y,
-												m_uvDistortionUV[loop + num].Width,
-												m_uvDistortionUV[loop + num].Height);
-					vcb->SetModelBlendUV(
-						num, m_blendUV[loop + num].X, m_blendUV[loop + num].Y, m_blendUV[loop + num].Width, m_blendUV[loop + num].Height);
-					vcb->SetModelBlendAlphaUV(num,
-											  m_blendAlphaUV[loop + num].X,
-											  m_blendAlphaUV[loop + num].Y,
-											  m_blendAlphaUV[loop + num].Width,
-											  m_blendAlphaUV[loop + num].Height);
-					vcb->SetModelBlendUVDistortionUV(num,
-													 m_blendUVDistortionUV[loop + num].X,
-													 m_blendUVDistortionUV[loop + num].Y,
-													 m_blendUVDistortionUV[loop + num].Width,
-													 m_blendUVDistortionUV[loop + num].Height);
-					vcb->SetModelFlipbookIndexAndNextRate(num, m_flipbookIndexAndNextRate[loop + num]);
-					vcb->SetModelAlphaThreshold(num, m_alphaThreshold[loop + num]);
-
-					ColorToFloat4(m_colors[loop + num], vcb->ModelColor[num]);
-
-					if (cutomData1Ptr != nullptr)
+					shader_->SetConstantBuffer();
+
+					DrawPolygonInstancedWithBuffer(renderer,
+												   shader_,
+												   instanceVertices_.data(),
+												   model->GetVertexCount(stTime),
+												   model->GetFaceCount(stTime) * indexPerFace,
+												   static_cast<int32_t>(instanceVertices_.size()));
+
+					loop = loopEnd;
+					continue;
+				}
+
+				while (loop < loopEnd)
+				{
+					int32_t modelCount = Effekseer::Min(static_cast<int32_t>(loopEnd - loop), InstanceCount);
+
+					for (int32_t num = 0; num < modelCount; num++)
 					{
-						cutomData1Ptr[num * 4 + 0] = customData1_[loop + num][0];
-						cutomData1Ptr[num * 4 + 1] = customData1_[loop + num][1];
-						cutomData1Ptr[num * 4 + 2] = customData1_[loop + num][2];
-						cutomData1Ptr[num * 4 + 3] = customData1_[loop + num][3];
+						vcb->ModelMatrix[num] = getModelMatrix(loop + num);
+
+						vcb->ModelUV[num][0] = m_uv[loop + num].X;
+						vcb->ModelUV[num][1] = m_uv[loop + num].Y;
+						vcb->ModelUV[num][2] = m_uv[loop + num].Width;
+						vcb->ModelUV[num][3] = m_uv[loop + num].Height;
+
+						vcb->SetModelAlphaUV(
+							num, m_alphaUV[loop + num].X, m_alphaUV[loop + num].Y, m_alphaUV[loop + num].Width, m_alphaUV[loop + num].Height);
+						vcb->SetModelUVDistortionUV(num,
+													m_uvDistortionUV[loop + num].X,
+													m_uvDistortionUV[loop + num].Y,
+													m_uvDistortionUV[loop + num].Width,
+													m_uvDistortionUV[loop + num].Height);
+						vcb->SetModelBlendUV(
+							num, m_blendUV[loop + num].X, m_blendUV[loop + num].Y, m_blendUV[loop + num].Width, m_blendUV[loop + num].Height);
+						vcb->SetModelBlendAlphaUV(num,
+												  m_blendAlphaUV[loop + num].X,
+												  m_blendAlphaUV[loop + num].Y,
+												  m_blendAlphaUV[loop + num].Width,
+												  m_blendAlphaUV[loop + num].Height);
+						vcb->SetModelBlendUVDistortionUV(num,
+														 m_blendUVDistortionUV[loop + num].X,
+														 m_blendUVDistortionUV[loop + num].Y,
+														 m_blendUVDistortionUV[loop + num].Width,
+														 m_blendUVDistortionUV[loop + num].Height);
+						vcb->SetModelFlipbookIndexAndNextRate(num, m_flipbookIndexAndNextRate[loop + num]);
+						vcb->SetModelAlphaThreshold(num, m_alphaThreshold[loop + num]);
+
+						ColorToFloat4(m_colors[loop + num], vcb->ModelColor[num]);
+
+						if (cutomData1Ptr != nullptr)
+						{
+							cutomData1Ptr[num * 4 + 0] = customData1_[loop + num][0];
+							cutomData1Ptr[num * 4 + 1] = customData1_[loop + num][1];
+							cutomData1Ptr[num * 4 + 2] = customData1_[loop + num][2];
+							cutomData1Ptr[num * 4 + 3] = customData1_[loop + num][3];
+						}
+
+						if (cutomData2Ptr != nullptr)
+						{
+							cutomData2Ptr[num * 4 + 0] = customData2_[loop + num][0];
+							cutomData2Ptr[num * 4 + 1] = customData2_[loop + num][1];
+							cutomData2Ptr[num * 4 + 2] = customData2_[loop + num][2];
+							cutomData2Ptr[num * 4 + 3] = customData2_[loop + num][3];
+						}
 					}
 
-					if (cutomData2Ptr != nullptr)
+					shader_->SetConstantBuffer();
+
+					if (VertexType == ModelRendererVertexType::Instancing)
 					{
-						cutomData2Ptr[num * 4 + 0] = customData2_[loop + num][0];
-						cutomData2Ptr[num * 4 + 1] = customData2_[loop + num][1];
-						cutomData2Ptr[num * 4 + 2] = customData2_[loop + num][2];
-						cutomData2Ptr[num * 4 + 3] = customData2_[loop + num][3];
+						renderer->DrawPolygonInstanced(model->GetVertexCount(stTime), model->GetFaceCount(stTime) * indexPerFace, modelCount);
+					}
+					else
+					{
+						assert(0);
 					}
-				}
-
-				shader_->SetConstantBuffer();
 
-				if (VertexType == ModelRendererVertexType::Instancing)
-				{
-					renderer->DrawPolygonInstanced(model->GetVertexCount(stTime0), model->GetFaceCount(stTime0) * indexPerFace, modelCount);
-				}
-				else
-				{
-					assert(0);
+					loop += modelCount;
 				}
-
-				loop += modelCount;
 			}
 		}
 		else
@@ -118,6 +118,41 @@ void Renderer::ResetDrawVertexCount()
 	impl->ResetDrawVertexCount();
 }
 
+int32_t Renderer::GetStagingVertexSize() const
+{
+	return impl->GetStagingVertexSize();
+}
+
+void Renderer::ResetStagingVertexSize()
+{
+	impl->ResetStagingVertexSize();
+}
+
+int32_t Renderer::GetVertexBufferUsedSize() const
+{
+	return impl->GetVertexBufferUsedSize();
+}
+
+void Renderer::ResetVertexBufferUsedSize()
+{
+	impl->ResetVertexBufferUsedSize();
+}
+
+int32_t Renderer::GetDroppedSquareCount() const
+{
+	return impl->GetDroppedSquareCount();
+}
+
+int32_t Renderer::GetRequiredSquareMaxCount() const
+{
+	return impl->GetRequiredSquareMaxCount();
+}
+
+void Renderer::ResetDroppedSquareCount()
+{
+	impl->ResetDroppedSquareCount();
+}
+
 Effekseer::RenderMode Renderer::GetRenderMode() const
 {
 	return impl->GetRenderMode();
@@ -215,6 +250,56 @@ void Renderer::SetMaintainGammaColorInLinearColorSpace(bool value)
 	impl->MaintainGammaColorInLinearColorSpace = value;
 }
 
+bool Renderer::GetIsStateSortingEnabled() const
+{
+	return impl->isStateSortingEnabled;
+}
+
+void Renderer::SetIsStateSortingEnabled(bool value)
+{
+	impl->isStateSortingEnabled = value;
+}
+
+bool Renderer::GetIsCompactVertexSupported() const
+{
+	return impl->isCompactVertexSupported;
+}
+
+bool Renderer::GetIsCompactVertexEnabled() const
+{
+	return impl->isCompactVertexEnabled;
+}
+
+void Renderer::SetIsCompactVertexEnabled(bool value)
+{
+	impl->isCompactVertexEnabled = value;
+}
+
+bool Renderer::GetIsInstancedSpriteSupported() const
+{
+	return impl->isInstancedSpriteSupported;
+}
+
+bool Renderer::GetIsInstancedSpriteEnabled() const
+{
+	return impl->isInstancedSpriteEnabled;
+}
+
+void Renderer::SetIsInstancedSpriteEnabled(bool value)
+{
+	impl->isInstancedSpriteEnabled = value;
+}
+
+int32_t Renderer::GetVertexGenerationThreadCount() const
+{
+	return impl->GetVertexGenerationThreadCount();
+}
+
+void Renderer::SetVertexGenerationThreadCount(int32_t count)
+{
+	impl->SetVertexGenerationThreadCount(count);
+}
+
 Effekseer::Backend::GraphicsDeviceRef Renderer::GetGraphicsDevice() const
 {
 	return nullptr;
@@ -340,6 +340,55 @@ public:
 	*/
 	virtual void ResetDrawVertexCount();
 
+	/**
+	@brief
+	\~english Get the size of vertices in bytes which are copied through a staging buffer before they are uploaded. It is 0 if vertices are written into a vertex buffer directly.
+	\~japanese アップロードされる前にステージングバッファを経由してコピーされた頂点のバイト数を取得する。頂点が直接頂点バッファに書き込まれる場合は0になる。
+	*/
+	virtual int32_t GetStagingVertexSize() const;
+
+	/**
+	@brief
+	\~english Reset the size of vertices which are copied through a staging buffer
+	\~japanese ステージングバッファを経由してコピーされた頂点のバイト数をリセットする
+	*/
+	virtual void ResetStagingVertexSize();
+
+	/**
+	@brief
+	\~english Get the size of vertices in bytes which are uploaded into vertex buffers. It can be used to decide squareMaxCount if it is reset every frame.
+	\~japanese 頂点バッファにアップロードされた頂点のバイト数を取得する。毎フレームリセットすると、squareMaxCountを決めるのに使用できる。
+	*/
+	virtual int32_t GetVertexBufferUsedSize() const;
+
+	/**
+	@brief
+	\~english Reset the size of vertices which are uploaded into vertex buffers
+	\~japanese 頂点バッファにアップロードされた頂点のバイト数をリセットする
+	*/
+	virtual void ResetVertexBufferUsedSize();
+
+	/**
+	@brief
+	\~english Get the number of squares which are not drawn because vertex buffers are not enough
+	\~japanese 頂点バッファが足りないために描画されなかった四角形の数を取得する
+	*/
+	virtual int32_t GetDroppedSquareCount() const;
+
+	/**
+	@brief
+	\~english Get the maximum number of squares which a node requires at once. If squareMaxCount is larger than it, no square is dropped.
+	\~japanese ノードが一度に必要とする四角形の最大数を取得する。squareMaxCountがこれより大きい場合、四角形は描画されなくなることはない。
+	*/
+	virtual int32_t GetRequiredSquareMaxCount() const;
+
+	/**
+	@brief
+	\~english Reset the number of dropped squares and the maximum number of required squares
+	\~japanese 描画されなかった四角形の数と必要な四角形の最大数をリセットする
+	*/
+	virtual void ResetDroppedSquareCount();
+
 	/**
 	@brief
 	\~english Get a render mode.
@@ -456,6 +505,96 @@ public:
 	*/
 	virtual void SetMaintainGammaColorInLinearColorSpace(bool value);
 
+	/**
+		@brief
+		\~English	Get whether sprites, ribbons, rings and tracks are sorted by states to reduce draw calls
+		\~Japanese	描画回数を減らすためにスプライト、リボン、リング、軌跡がステートでソートされるか、を取得する。
+	*/
+	virtual bool GetIsStateSortingEnabled() const;
+
+	/**
+		@brief
+		\~English	Specify whether sprites, ribbons, rings and tracks are sorted by states to reduce draw calls
+		\~Japanese	描画回数を減らすためにスプライト、リボン、リング、軌跡がステートでソートされるか、を設定する。
+		@note
+		\~English	Only batches whose order doesn't change a result are reordered. For example, additive batches without a depth write are reordered but alpha blended batches are not.
+		\~Japanese	順番が結果を変えない描画のみが並び替えられる。例えば、深度書き込みのない加算の描画は並び替えられるが、アルファブレンドの描画は並び替えられない。
+	*/
+	virtual void SetIsStateSortingEnabled(bool value);
+
+	/**
+		@brief
+		\~English	Get whether compact vertices are supported by this renderer
+		\~Japanese	この描画クラスでコンパクトな頂点がサポートされているか、を取得する。
+	*/
+	virtual bool GetIsCompactVertexSupported() const;
+
+	/**
+		@brief
+		\~English	Get whether compact vertices are used for sprites, ribbons, rings and tracks
+		\~Japanese	スプライト、リボン、リング、軌跡にコンパクトな頂点が使用されるか、を取得する。
+	*/
+	virtual bool GetIsCompactVertexEnabled() const;
+
+	/**
+		@brief
+		\~English	Specify whether compact vertices are used for sprites, ribbons, rings and tracks
+		\~Japanese	スプライト、リボン、リング、軌跡にコンパクトな頂点が使用されるか、を設定する。
+		@note
+		\~English	UVs are stored as half floats to reduce a bandwidth. UVs far from 0 lose precision. Materials are not affected. It is ignored if it is not supported.
+		\~Japanese	帯域を減らすためにUVが半精度浮動小数点数で保存される。0から離れたUVは精度が落ちる。マテリアルは影響を受けない。サポートされていない場合は無視される。
+	*/
+	virtual void SetIsCompactVertexEnabled(bool value);
+
+	/**
+		@brief
+		\~English	Get whether sprites can be expanded into quads on GPU by this renderer
+		\~Japanese	この描画クラスでスプライトをGPU上で四角形に展開できるか、を取得する。
+	*/
+	virtual bool GetIsInstancedSpriteSupported() const;
+
+	/**
+		@brief
+		\~English	Get whether sprites are expanded into quads on GPU
+		\~Japanese	スプライトがGPU上で四角形に展開されるか、を取得する。
+	*/
+	virtual bool GetIsInstancedSpriteEnabled() const;
+
+	/**
+		@brief
+		\~English	Specify whether sprites are expanded into quads on GPU
+		\~Japanese	スプライトがGPU上で四角形に展開されるか、を設定する。
+		@note
+		\~English
+		One record per sprite is uploaded instead of four vertices. It is applied to unlit sprites whose billboard type is Billboard or RotatedBillboard,
+		whose corners have the same color and form a rectangle. Other sprites are expanded on CPU. It is ignored if it is not supported.
+		\~Japanese
+		4頂点の代わりにスプライトごとに1つのデータが転送される。ビルボードの種類がBillboardかRotatedBillboardで、頂点の色が同じで、頂点が長方形を成す、ライティングなしのスプライトに適用される。
+		その他のスプライトはCPUで展開される。サポートされていない場合は無視される。
+	*/
+	virtual void SetIsInstancedSpriteEnabled(bool value);
+
+	/**
+		@brief
+		\~English	Get the number of worker threads which generate vertices
+		\~Japanese	頂点を生成するワーカースレッドの数を取得する。
+	*/
+	virtual int32_t GetVertexGenerationThreadCount() const;
+
+	/**
+		@brief
+		\~English	Specify the number of worker threads which generate vertices
+		\~Japanese	頂点を生成するワーカースレッドの数を設定する。
+		@note
+		\~English
+		Vertices of sprites and rings of a node are generated on worker threads and the rendering thread when the node has many instances.
+		Results are same as results without worker threads. If it is 0, vertices are generated only on the rendering thread.
+		\~Japanese
+		ノードのインスタンスが多い場合、スプライトとリングの頂点がワーカースレッドと描画スレッドで生成される。
+		結果はワーカースレッドがない場合と同じになる。0の場合、描画スレッドでのみ頂点が生成される。
+	*/
+	virtual void SetVertexGenerationThreadCount(int32_t count);
+
 	/**
 		@brief	
 		\~English	Get the graphics device
@@ -7,6 +7,7 @@ namespace EffekseerRenderer
 
 Renderer::Impl::~Impl()
 {
+	SetVertexGenerationThreadCount(0);
 }
 
 void Renderer::Impl::SetCameraParameterInternal(const ::Effekseer::SIMD::Vec3f& front, const ::Effekseer::SIMD::Vec3f& position)
@@ -173,6 +174,48 @@ void Renderer::Impl::ResetDrawVertexCount()
 	drawvertexCount = 0;
 }
 
+int32_t Renderer::Impl::GetStagingVertexSize() const
+{
+	return stagingVertexSize;
+}
+
+void Renderer::Impl::ResetStagingVertexSize()
+{
+	stagingVertexSize = 0;
+}
+
+int32_t Renderer::Impl::GetVertexBufferUsedSize() const
+{
+	return vertexBufferUsedSize;
+}
+
+void Renderer::Impl::ResetVertexBufferUsedSize()
+{
+	vertexBufferUsedSize = 0;
+}
+
+int32_t Renderer::Impl::GetDroppedSquareCount() const
+{
+	return droppedSquareCount;
+}
+
+int32_t Renderer::Impl::GetRequiredSquareMaxCount() const
+{
+	return requiredSquareMaxCount;
+}
+
+void Renderer::Impl::ResetDroppedSquareCount()
+{
+	droppedSquareCount = 0;
+	requiredSquareMaxCount = 0;
+}
+
+void Renderer::Impl::ReportSquareCount(int32_t requiredCount, int32_t allocatedCount)
+{
+	requiredSquareMaxCount = Effekseer::Max(requiredSquareMaxCount, requiredCount);
+	droppedSquareCount += Effekseer::Max(requiredCount - allocatedCount, 0);
+}
+
 float Renderer::Impl::GetTime() const
 {
 	return time_;
@@ -246,4 +289,37 @@ void Renderer::Impl::SetDepth(::Effekseer::Backend::TextureRef texture, const De
 	reconstructionParam_ = reconstructionParam;
 }
 
+int32_t Renderer::Impl::GetVertexGenerationThreadCount() const
+{
+	return static_cast<int32_t>(vertexGenerationThreads_.size());
+}
+
+void Renderer::Impl::SetVertexGenerationThreadCount(int32_t count)
+{
+	count = Effekseer::Max(count, 0);
+
+	if (count == GetVertexGenerationThreadCount())
+	{
+		return;
+	}
+
+	for (auto& worker : vertexGenerationThreads_)
+	{
+		worker.Shutdown();
+	}
+
+	vertexGenerationThreads_.clear();
+	vertexGenerationThreads_.resize(count);
+
+	for (auto& worker : vertexGenerationThreads_)
+	{
+		worker.Launch();
+	}
+}
+
+void Renderer::Impl::RunVertexGeneration(int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task)
+{
+	Effekseer::RunParallelFor(vertexGenerationThreads_.data(), GetVertexGenerationThreadCount(), count, minCountPerTask, task);
+}
+
 } // namespace EffekseerRenderer
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define __EFFEKSEERRENDERER_RENDERER_IMPL_H__
 
 #include <Effekseer.h>
+#include <Effekseer/Effekseer.WorkerThread.h>
+#include <functional>
 
 #include "EffekseerRenderer.Renderer.h"
 
@@ -35,14 +37,31 @@ private:
 	::Effekseer::Backend::TextureRef depthTexture_;
 	DepthReconstructionParameter reconstructionParam_;
 
+	//! worker threads which generate vertices with a rendering thread
+	Effekseer::CustomVector<Effekseer::WorkerThread> vertexGenerationThreads_;
+
 	void SetCameraParameterInternal(const ::Effekseer::SIMD::Vec3f& front, const ::Effekseer::SIMD::Vec3f& position);
 
 public:
 	int32_t drawcallCount = 0;
 	int32_t drawvertexCount = 0;
+	int32_t stagingVertexSize = 0;
+	int32_t vertexBufferUsedSize = 0;
+	int32_t droppedSquareCount = 0;
+	int32_t requiredSquareMaxCount = 0;
 	bool isRenderModeValid = true;
 	bool isSoftParticleEnabled = false;
 	bool isDepthReversed = false;
+	bool isStateSortingEnabled = false;
+	bool isCompactVertexEnabled = false;
+
+	//! it is set by a backend which has shaders for compact vertices
+	bool isCompactVertexSupported = false;
+
+	bool isInstancedSpriteEnabled = false;
+
+	//! it is set by a backend which can expand sprites into quads on GPU
+	bool isInstancedSpriteSupported = false;
 
 	Effekseer::RefPtr<Effekseer::RenderingUserData> CurrentRenderingUserData;
 	void* CurrentHandleUserData = nullptr;
@@ -114,6 +133,26 @@ public:
 
 	void ResetDrawVertexCount();
 
+	int32_t GetStagingVertexSize() const;
+
+	void ResetStagingVertexSize();
+
+	int32_t GetVertexBufferUsedSize() const;
+
+	void ResetVertexBufferUsedSize();
+
+	int32_t GetDroppedSquareCount() const;
+
+	int32_t GetRequiredSquareMaxCount() const;
+
+	void ResetDroppedSquareCount();
+
+	/**
+		@brief	record squares which a renderer requires and squares which are actually allocated
+		@note	squares which are not allocated are counted as dropped
+	*/
+	void ReportSquareCount(int32_t requiredCount, int32_t allocatedCount);
+
 	float GetTime() const;
 
 	void SetTime(float time);
@@ -129,6 +168,16 @@ public:
 	void GetDepth(::Effekseer::Backend::TextureRef& texture, DepthReconstructionParameter& reconstructionParam);
 
 	void SetDepth(::Effekseer::Backend::TextureRef texture, const DepthReconstructionParameter& reconstructionParam);
+
+	int32_t GetVertexGenerationThreadCount() const;
+
+	void SetVertexGenerationThreadCount(int32_t count);
+
+	/**
+		@brief	call a task with ranges which divide [0, count) on worker threads and the calling thread, and wait for them
+		@note	ranges depend only on count, minCountPerTask and the number of threads, so a result is same as a serial one if ranges are independent
+	*/
+	void RunVertexGeneration(int32_t count, int32_t minCountPerTask, const std::function<void(int32_t, int32_t)>& task);
 };
 
 
@@ -40,6 +40,8 @@ protected:
 	Effekseer::CustomAlignedVector<efkRibbonInstanceParam> instances;
 	Effekseer::SplineGenerator spline_left;
 	Effekseer::SplineGenerator spline_right;
+	Effekseer::CustomAlignedVector<Effekseer::SIMD::Vec3f> spline_left_values_;
+	Effekseer::CustomAlignedVector<Effekseer::SIMD::Vec3f> spline_right_values_;
 
 	int32_t vertexCount_ = 0;
 	int32_t stride_ = 0;
@@ -455,6 +457,9 @@ protected:
 
 			spline_left.Calculate();
 			spline_right.Calculate();
+
+			spline_left_values_.resize(parameter.SplineDivision);
+			spline_right_values_.resize(parameter.SplineDivision);
 		}
 
 		StrideView<VERTEX> verteies(m_ringBufferData, stride_, vertexCount_);
@@ -462,6 +467,13 @@ protected:
 		{
 			auto& param = instances[loop];
 
+			// evaluate a segment at once
+			if (parameter.SplineDivision > 1)
+			{
+				spline_left.GetValues(param.InstanceIndex, parameter.SplineDivision, spline_left_values_.data());
+				spline_right.GetValues(param.InstanceIndex, parameter.SplineDivision, spline_right_values_.data());
+			}
+
 			for (auto sploop = 0; sploop < parameter.SplineDivision; sploop++)
 			{
 				bool isFirst = param.InstanceIndex == 0 && sploop == 0;
@@ -471,8 +483,8 @@ protected:
 
 				if (parameter.SplineDivision > 1)
 				{
-					verteies[0].Pos = ToStruct(spline_left.GetValue(param.InstanceIndex + sploop / (float)parameter.SplineDivision));
-					verteies[1].Pos = ToStruct(spline_right.GetValue(param.InstanceIndex + sploop / (float)parameter.SplineDivision));
+					verteies[0].Pos = ToStruct(spline_left_values_[sploop]);
+					verteies[1].Pos = ToStruct(spline_right_values_[sploop]);
 
 					verteies[0].SetColor(Effekseer::Color::Lerp(param.Colors[0], param.Colors[2], percent_instance), FLIP_RGB);
 					verteies[1].SetColor(Effekseer::Color::Lerp(param.Colors[1], param.Colors[3], percent_instance), FLIP_RGB);
@@ -765,7 +777,26 @@ protected:
 
 		const auto& state = m_renderer->GetStandardRenderer()->GetState();
 		const ShaderParameterCollector& collector = state.Collector;
-		if (collector.ShaderType == RendererShaderType::Material)
+		if (state.IsCompactVertex)
+		{
+			if (collector.ShaderType == RendererShaderType::AdvancedLit || collector.ShaderType == RendererShaderType::AdvancedBackDistortion)
+			{
+				Rendering_Internal<CompactAdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+			else if (collector.ShaderType == RendererShaderType::AdvancedUnlit)
+			{
+				Rendering_Internal<CompactAdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+			else if (collector.ShaderType == RendererShaderType::Lit || collector.ShaderType == RendererShaderType::BackDistortion)
+			{
+				Rendering_Internal<CompactLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+			else
+			{
+				Rendering_Internal<CompactSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+		}
+		else if (collector.ShaderType == RendererShaderType::Material)
 		{
 			Rendering_Internal<DynamicVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
 		}
@@ -54,6 +54,120 @@ protected:
 	int32_t customData1Count_ = 0;
 	int32_t customData2Count_ = 0;
 
+	//! instances are stored and their vertices are generated on worker threads in EndRendering
+	bool isVertexGenerationParallel_ = false;
+
+	//! the minimum number of vertices which are generated by a thread
+	static const int32_t VertexGenerationCountPerThread = 1024;
+
+	//! cos and sin on a unit circle which are shared between rings with the same division and viewing angle
+	struct CircleTable
+	{
+		int32_t VertexCount;
+		float ViewingAngleStart;
+		float ViewingAngleEnd;
+
+		//! circleTableSerial_ when it is used at last
+		uint64_t UsedSerial;
+
+		//! values from an index -1 to VertexCount + 1 to calculate tangents
+		std::vector<float> Cos;
+		std::vector<float> Sin;
+	};
+
+	std::vector<CircleTable> circleTables_;
+
+	//! it is incremented for each node so that tables used by rings in the current node are not replaced
+	uint64_t circleTableSerial_ = 0;
+
+	//! rings in a node usually have the same key, so the last found table is checked first
+	int32_t lastCircleTableIndex_ = -1;
+
+	static const int32_t CircleTableMaxCount = 16;
+
+	static bool IsCircleTableMatched(const CircleTable& table, int32_t vertexCount, float viewingAngleStart, float viewingAngleEnd)
+	{
+		return table.VertexCount == vertexCount && table.ViewingAngleStart == viewingAngleStart && table.ViewingAngleEnd == viewingAngleEnd;
+	}
+
+	int32_t FindCircleTableIndex(int32_t vertexCount, float viewingAngleStart, float viewingAngleEnd) const
+	{
+		if (lastCircleTableIndex_ >= 0 && IsCircleTableMatched(circleTables_[lastCircleTableIndex_], vertexCount, viewingAngleStart, viewingAngleEnd))
+		{
+			return lastCircleTableIndex_;
+		}
+
+		for (size_t i = 0; i < circleTables_.size(); i++)
+		{
+			if (IsCircleTableMatched(circleTables_[i], vertexCount, viewingAngleStart, viewingAngleEnd))
+			{
+				return static_cast<int32_t>(i);
+			}
+		}
+
+		return -1;
+	}
+
+	const CircleTable* FindCircleTable(int32_t vertexCount, float viewingAngleStart, float viewingAngleEnd) const
+	{
+		const auto index = FindCircleTableIndex(vertexCount, viewingAngleStart, viewingAngleEnd);
+		return index >= 0 ? &circleTables_[index] : nullptr;
+	}
+
+	//! it must not be called while vertices are generated because a table may be replaced
+	void PrepareCircleTable(int32_t vertexCount, float viewingAngleStart, float viewingAngleEnd)
+	{
+		auto index = FindCircleTableIndex(vertexCount, viewingAngleStart, viewingAngleEnd);
+
+		if (index < 0)
+		{
+			if (circleTables_.size() < CircleTableMaxCount)
+			{
+				index = static_cast<int32_t>(circleTables_.size());
+				circleTables_.emplace_back();
+			}
+			else
+			{
+				// replace the least recently used table. tables used in the current node may be read by rings which are not generated yet
+				for (size_t i = 0; i < circleTables_.size(); i++)
+				{
+					if (circleTables_[i].UsedSerial != circleTableSerial_ && (index < 0 || circleTables_[i].UsedSerial < circleTables_[index].UsedSerial))
+					{
+						index = static_cast<int32_t>(i);
+					}
+				}
+
+				if (index < 0)
+				{
+					return;
+				}
+			}
+
+			auto& table = circleTables_[index];
+			table.VertexCount = vertexCount;
+			table.ViewingAngleStart = viewingAngleStart;
+			table.ViewingAngleEnd = viewingAngleEnd;
+			table.Cos.resize(vertexCount + 3);
+			table.Sin.resize(vertexCount + 3);
+
+			for (int32_t i = 0; i < vertexCount + 3; i++)
+			{
+				const auto angle = GetCircleAngle(vertexCount, viewingAngleStart, viewingAngleEnd, i - 1);
+				table.Cos[i] = cosf(angle);
+				table.Sin[i] = sinf(angle);
+			}
+		}
+
+		circleTables_[index].UsedSerial = circleTableSerial_;
+		lastCircleTableIndex_ = index;
+	}
+
+	static float GetCircleAngle(int32_t vertexCount, float viewingAngleStart, float viewingAngleEnd, int32_t index)
+	{
+		const float stepAngleDegree = (viewingAngleEnd - viewingAngleStart) / vertexCount;
+		return (viewingAngleStart + 90 + stepAngleDegree * index) / 180.0f * 3.141592f;
+	}
+
 public:
 	RingRendererBase(RENDERER* renderer)
 		: m_renderer(renderer)
@@ -62,6 +176,7 @@ public:
 		, m_spriteCount(0)
 		, m_instanceCount(0)
 	{
+		circleTables_.reserve(CircleTableMaxCount);
 	}
 
 	virtual ~RingRendererBase()
@@ -73,35 +188,66 @@ protected:
 						   const efkRingNodeParam& parameter,
 						   const StandardRendererState& state,
 						   const ::Effekseer::SIMD::Mat44f& camera)
+	{
+		RenderingInstance(instanceParameter, parameter, state, camera, m_ringBufferData);
+
+		m_spriteCount += 2 * parameter.VertexCount;
+		m_ringBufferData += stride_ * parameter.VertexCount * 8;
+	}
+
+	void RenderingInstance(const efkRingInstanceParam& instanceParameter,
+						   const efkRingNodeParam& parameter,
+						   const StandardRendererState& state,
+						   const ::Effekseer::SIMD::Mat44f& camera,
+						   uint8_t* data)
 	{
 		const ShaderParameterCollector& collector = state.Collector;
-		if (collector.ShaderType == RendererShaderType::Material)
+		if (state.IsCompactVertex)
+		{
+			if (collector.ShaderType == RendererShaderType::AdvancedLit || collector.ShaderType == RendererShaderType::AdvancedBackDistortion)
+			{
+				Rendering_Internal<CompactAdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+			else if (collector.ShaderType == RendererShaderType::AdvancedUnlit)
+			{
+				Rendering_Internal<CompactAdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+			else if (collector.ShaderType == RendererShaderType::Lit || collector.ShaderType == RendererShaderType::BackDistortion)
+			{
+				Rendering_Internal<CompactLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+			else
+			{
+				Rendering_Internal<CompactSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+		}
+		else if (collector.ShaderType == RendererShaderType::Material)
 		{
-			Rendering_Internal<DynamicVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<DynamicVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::AdvancedLit)
 		{
-			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::AdvancedBackDistortion)
 		{
-			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::AdvancedUnlit)
 		{
-			Rendering_Internal<AdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<AdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::Lit)
 		{
-			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::BackDistortion)
 		{
-			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else
 		{
-			Rendering_Internal<SimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<SimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 	}
 
@@ -111,13 +257,20 @@ protected:
 		const auto singleVertexCount = param.VertexCount * 8;
 		const auto singleSpriteCount = param.VertexCount * 2;
 
+		const auto requiredCount = count;
 		count = (std::min)(count, renderer->GetSquareMaxCount() / singleSpriteCount);
+		m_renderer->GetImpl()->ReportSquareCount(requiredCount * singleSpriteCount, count * singleSpriteCount);
 
 		m_instanceCount = count;
 
 		instances_.clear();
 
-		if (param.DepthParameterPtr->ZSort != Effekseer::ZSortType::None)
+		circleTableSerial_++;
+
+		isVertexGenerationParallel_ = m_renderer->GetImpl()->GetVertexGenerationThreadCount() > 0 &&
+									  count * singleVertexCount >= VertexGenerationCountPerThread * 2;
+
+		if (param.DepthParameterPtr->ZSort != Effekseer::ZSortType::None || isVertexGenerationParallel_)
 		{
 			instances_.reserve(count);
 		}
@@ -174,7 +327,9 @@ protected:
 					const efkRingInstanceParam& instanceParameter,
 					const ::Effekseer::SIMD::Mat44f& camera)
 	{
-		if (parameter.DepthParameterPtr->ZSort == Effekseer::ZSortType::None)
+		PrepareCircleTable(parameter.VertexCount, instanceParameter.ViewingAngleStart, instanceParameter.ViewingAngleEnd);
+
+		if (parameter.DepthParameterPtr->ZSort == Effekseer::ZSortType::None && !isVertexGenerationParallel_)
 		{
 			const auto& state = m_renderer->GetStandardRenderer()->GetState();
 
@@ -196,7 +351,8 @@ protected:
 	template <typename VERTEX, bool FLIP_RGB>
 	void Rendering_Internal(const efkRingNodeParam& parameter,
 							const efkRingInstanceParam& instanceParameter,
-							const ::Effekseer::SIMD::Mat44f& camera)
+							const ::Effekseer::SIMD::Mat44f& camera,
+							uint8_t* data)
 	{
 		::Effekseer::SIMD::Mat43f mat43{};
 
@@ -249,11 +405,15 @@ protected:
 		int32_t singleVertexCount = parameter.VertexCount * 8;
 		// Vertex* verteies = (Vertex*)m_renderer->GetVertexBuffer()->GetBufferDirect( sizeof(Vertex) * vertexCount );
 
-		StrideView<VERTEX> verteies(m_ringBufferData, stride_, singleVertexCount);
+		StrideView<VERTEX> verteies(data, stride_, singleVertexCount);
 		const float circleAngleDegree = (instanceParameter.ViewingAngleEnd - instanceParameter.ViewingAngleStart);
 		const float stepAngleDegree = circleAngleDegree / (parameter.VertexCount);
+
+		// if a table is not prepared, a rotation is accumulated
+		const CircleTable* circleTable = FindCircleTable(parameter.VertexCount, instanceParameter.ViewingAngleStart, instanceParameter.ViewingAngleEnd);
 		const float stepAngle = (stepAngleDegree) / 180.0f * 3.141592f;
-		const float beginAngle = (instanceParameter.ViewingAngleStart + 90) / 180.0f * 3.141592f;
+		const float stepC = circleTable != nullptr ? 0.0f : cosf(stepAngle);
+		const float stepS = circleTable != nullptr ? 0.0f : sinf(stepAngle);
 
 		const float outerRadius = instanceParameter.OuterLocation.GetX();
 		const float innerRadius = instanceParameter.InnerLocation.GetX();
@@ -277,10 +437,19 @@ protected:
 			centerColor.A = 0;
 		}
 
-		const float stepC = cosf(stepAngle);
-		const float stepS = sinf(stepAngle);
-		float cos_ = cosf(beginAngle);
-		float sin_ = sinf(beginAngle);
+		float cos_;
+		float sin_;
+		if (circleTable != nullptr)
+		{
+			cos_ = circleTable->Cos[1];
+			sin_ = circleTable->Sin[1];
+		}
+		else
+		{
+			const float beginAngle = GetCircleAngle(parameter.VertexCount, instanceParameter.ViewingAngleStart, instanceParameter.ViewingAngleEnd, 0);
+			cos_ = cosf(beginAngle);
+			sin_ = sinf(beginAngle);
+		}
 
 		float uv0Current = instanceParameter.UV.X;
 		const float uv0Step = instanceParameter.UV.Width / parameter.VertexCount;
@@ -355,13 +524,22 @@ protected:
 
 		for (int i = 0; i < singleVertexCount; i += 8)
 		{
-			float old_c = cos_;
-			float old_s = sin_;
+			const int32_t circleIndex = i / 8;
+			const float old_c = cos_;
+			const float old_s = sin_;
 
-			float t;
-			t = cos_ * stepC - sin_ * stepS;
-			sin_ = sin_ * stepC + cos_ * stepS;
-			cos_ = t;
+			if (circleTable != nullptr)
+			{
+				cos_ = circleTable->Cos[circleIndex + 2];
+				sin_ = circleTable->Sin[circleIndex + 2];
+			}
+			else
+			{
+				float t;
+				t = cos_ * stepC - sin_ * stepS;
+				sin_ = sin_ * stepC + cos_ * stepS;
+				cos_ = t;
+			}
 
 			outerNext = ::Effekseer::SIMD::Vec3f{cos_ * outerRadius, sin_ * outerRadius, 0};
 			innerNext = ::Effekseer::SIMD::Vec3f{cos_ * innerRadius, sin_ * innerRadius, 0};
@@ -543,18 +721,35 @@ protected:
 				StrideView<VERTEX> vs(&verteies[i], stride_, 8);
 
 				// return back
-				float t_b;
-				t_b = old_c * (stepC)-old_s * (-stepS);
-				auto s_b = old_s * (stepC) + old_c * (-stepS);
-				auto c_b = t_b;
+				float c_b;
+				float s_b;
+				if (circleTable != nullptr)
+				{
+					c_b = circleTable->Cos[circleIndex];
+					s_b = circleTable->Sin[circleIndex];
+				}
+				else
+				{
+					c_b = old_c * stepC + old_s * stepS;
+					s_b = old_s * stepC - old_c * stepS;
+				}
 
 				::Effekseer::SIMD::Vec3f outerBefore{c_b * outerRadius, s_b * outerRadius, 0.0f};
 				outerTransform.Transform(outerBefore);
 
 				// next
-				auto t_n = cos_ * stepC - sin_ * stepS;
-				auto s_n = sin_ * stepC + cos_ * stepS;
-				auto c_n = t_n;
+				float c_n;
+				float s_n;
+				if (circleTable != nullptr)
+				{
+					c_n = circleTable->Cos[circleIndex + 3];
+					s_n = circleTable->Sin[circleIndex + 3];
+				}
+				else
+				{
+					c_n = cos_ * stepC - sin_ * stepS;
+					s_n = sin_ * stepC + cos_ * stepS;
+				}
 
 				::Effekseer::SIMD::Vec3f outerNN{c_n * outerRadius, s_n * outerRadius, 0.0f};
 				outerTransform.Transform(outerNN);
@@ -647,7 +842,7 @@ protected:
 		// custom parameter
 		if (customData1Count_ > 0)
 		{
-			StrideView<float> custom(m_ringBufferData + sizeof(DynamicVertex), stride_, singleVertexCount);
+			StrideView<float> custom(data + sizeof(DynamicVertex), stride_, singleVertexCount);
 			for (int i = 0; i < singleVertexCount; i++)
 			{
 				auto c = (float*)(&custom[i]);
@@ -658,16 +853,13 @@ protected:
 		if (customData2Count_ > 0)
 		{
 			StrideView<float> custom(
-				m_ringBufferData + sizeof(DynamicVertex) + sizeof(float) * customData1Count_, stride_, singleVertexCount);
+				data + sizeof(DynamicVertex) + sizeof(float) * customData1Count_, stride_, singleVertexCount);
 			for (int i = 0; i < singleVertexCount; i++)
 			{
 				auto c = (float*)(&custom[i]);
 				memcpy(c, instanceParameter.CustomData2.data(), sizeof(float) * customData2Count_);
 			}
 		}
-
-		m_spriteCount += 2 * parameter.VertexCount;
-		m_ringBufferData += stride_ * singleVertexCount;
 	}
 
 	void EndRendering_(RENDERER* renderer, const efkRingNodeParam& param, const ::Effekseer::SIMD::Mat44f& camera)
@@ -695,16 +887,47 @@ protected:
 			{
 				std::sort(instances_.begin(), instances_.end(), [](const KeyValue& a, const KeyValue& b) -> bool { return a.Key > b.Key; });
 			}
+		}
 
-			const auto& state = m_renderer->GetStandardRenderer()->GetState();
+		if (param.DepthParameterPtr->ZSort != Effekseer::ZSortType::None || isVertexGenerationParallel_)
+		{
+			RenderingInstances(param, camera);
+		}
+
+		renderer->GetStandardRenderer()->EndRenderingAndRenderingIfRequired();
+	}
 
+	void RenderingInstances(const efkRingNodeParam& param, const ::Effekseer::SIMD::Mat44f& camera)
+	{
+		const auto& state = m_renderer->GetStandardRenderer()->GetState();
+
+		if (!isVertexGenerationParallel_)
+		{
 			for (auto& kv : instances_)
 			{
 				RenderingInstance(kv.Value, param, state, camera);
 			}
+			return;
 		}
 
-		renderer->GetStandardRenderer()->EndRenderingAndRenderingIfRequired();
+		// each instance is written into its own range, so vertices are same as vertices generated serially
+		const int32_t singleVertexCount = param.VertexCount * 8;
+		const int32_t sizePerInstance = stride_ * singleVertexCount;
+		uint8_t* const data = m_ringBufferData;
+
+		m_renderer->GetImpl()->RunVertexGeneration(
+			static_cast<int32_t>(instances_.size()),
+			(std::max)(1, VertexGenerationCountPerThread / singleVertexCount),
+			[&](int32_t begin, int32_t end)
+			{
+				for (int32_t i = begin; i < end; i++)
+				{
+					RenderingInstance(instances_[i].Value, param, state, camera, data + sizePerInstance * i);
+				}
+			});
+
+		m_spriteCount += 2 * param.VertexCount * static_cast<int32_t>(instances_.size());
+		m_ringBufferData += sizePerInstance * instances_.size();
 	}
 
 public:
@@ -726,7 +949,7 @@ public:
 	{
 		if (m_ringBufferData == nullptr)
 			return;
-		if (m_spriteCount == 0 && parameter.DepthParameterPtr->ZSort == Effekseer::ZSortType::None)
+		if (m_spriteCount == 0 && parameter.DepthParameterPtr->ZSort == Effekseer::ZSortType::None && !isVertexGenerationParallel_)
 			return;
 
 		EndRendering_(m_renderer, parameter, m_renderer->GetCameraMatrix());
@@ -49,6 +49,16 @@ protected:
 	int32_t customData1Count_ = 0;
 	int32_t customData2Count_ = 0;
 
+	//! axes which are used to expand instanced sprites
+	efkVector3D billboardRight_;
+	efkVector3D billboardUp_;
+
+	//! instances are stored and their vertices are generated on worker threads in EndRendering
+	bool isVertexGenerationParallel_ = false;
+
+	//! the minimum number of sprites which are processed by a thread
+	static const int32_t VertexGenerationCountPerThread = 256;
+
 public:
 	SpriteRendererBase(RENDERER* renderer)
 		: m_renderer(renderer)
@@ -64,39 +74,83 @@ public:
 	}
 
 protected:
+	//! a size of vertices which are written for an instance
+	int32_t GetVertexSizePerInstance(const StandardRendererState& state) const
+	{
+		return state.IsInstancedSprite ? stride_ : stride_ * 4;
+	}
+
 	void RenderingInstance(const efkSpriteInstanceParam& instanceParameter,
 						   const efkSpriteNodeParam& parameter,
 						   const StandardRendererState& state,
 						   const ::Effekseer::SIMD::Mat44f& camera)
+	{
+		if (m_ringBufferData == nullptr)
+			return;
+
+		RenderingInstance(instanceParameter, parameter, state, camera, m_ringBufferData);
+
+		m_ringBufferData += GetVertexSizePerInstance(state);
+		m_spriteCount++;
+	}
+
+	void RenderingInstance(const efkSpriteInstanceParam& instanceParameter,
+						   const efkSpriteNodeParam& parameter,
+						   const StandardRendererState& state,
+						   const ::Effekseer::SIMD::Mat44f& camera,
+						   uint8_t* data)
 	{
 		const ShaderParameterCollector& collector = state.Collector;
-		if (collector.ShaderType == RendererShaderType::Material)
+		if (state.IsInstancedSprite)
+		{
+			RenderingInstanced_Internal<FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+		}
+		else if (state.IsCompactVertex)
+		{
+			if (collector.ShaderType == RendererShaderType::AdvancedLit || collector.ShaderType == RendererShaderType::AdvancedBackDistortion)
+			{
+				Rendering_Internal<CompactAdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+			else if (collector.ShaderType == RendererShaderType::AdvancedUnlit)
+			{
+				Rendering_Internal<CompactAdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+			else if (collector.ShaderType == RendererShaderType::Lit || collector.ShaderType == RendererShaderType::BackDistortion)
+			{
+				Rendering_Internal<CompactLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+			else
+			{
+				Rendering_Internal<CompactSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
+			}
+		}
+		else if (collector.ShaderType == RendererShaderType::Material)
 		{
-			Rendering_Internal<DynamicVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<DynamicVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::AdvancedLit)
 		{
-			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::AdvancedBackDistortion)
 		{
-			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<AdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::AdvancedUnlit)
 		{
-			Rendering_Internal<AdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<AdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::Lit)
 		{
-			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else if (collector.ShaderType == RendererShaderType::BackDistortion)
 		{
-			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<LightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 		else
 		{
-			Rendering_Internal<SimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			Rendering_Internal<SimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera, data);
 		}
 	}
 
@@ -144,12 +198,24 @@ protected:
 		customData1Count_ = state.CustomData1Count;
 		customData2Count_ = state.CustomData2Count;
 
+		state.IsInstancedSprite = IsInstancedSpriteAvailable(state, param);
+
+		if (state.IsInstancedSprite)
+		{
+			state.IsCompactVertex = false;
+			CalcBillboardAxes(billboardRight_, billboardUp_, m_renderer->GetCameraFrontDirection());
+		}
+
 		instanceMaxCount_ = (std::min)(count, m_renderer->GetSquareMaxCount());
-		vertexCount_ = instanceMaxCount_ * 4;
+		m_renderer->GetImpl()->ReportSquareCount(count, instanceMaxCount_);
+		vertexCount_ = state.IsInstancedSprite ? instanceMaxCount_ : instanceMaxCount_ * 4;
 
 		renderer->GetStandardRenderer()->BeginRenderingAndRenderingIfRequired(state, vertexCount_, stride_, (void*&)m_ringBufferData);
 		m_spriteCount = 0;
 
+		isVertexGenerationParallel_ = m_renderer->GetImpl()->GetVertexGenerationThreadCount() > 0 &&
+									  instanceMaxCount_ >= VertexGenerationCountPerThread * 2;
+
 		instances.clear();
 	}
 
@@ -157,7 +223,7 @@ protected:
 					const efkSpriteInstanceParam& instanceParameter,
 					const ::Effekseer::SIMD::Mat44f& camera)
 	{
-		if (parameter.ZSort == Effekseer::ZSortType::None)
+		if (parameter.ZSort == Effekseer::ZSortType::None && !isVertexGenerationParallel_)
 		{
 			auto cameraMat = m_renderer->GetCameraMatrix();
 			const auto& state = m_renderer->GetStandardRenderer()->GetState();
@@ -177,15 +243,82 @@ protected:
 		}
 	}
 
+	bool IsInstancedSpriteAvailable(const StandardRendererState& state, const efkSpriteNodeParam& param) const
+	{
+		const auto impl = m_renderer->GetImpl();
+		if (!impl->isInstancedSpriteEnabled || !impl->isInstancedSpriteSupported || m_renderer->GetExternalShaderSettings() != nullptr)
+		{
+			return false;
+		}
+
+		// axes of other billboards are different for each sprite
+		return state.Collector.ShaderType == RendererShaderType::Unlit && param.IsRectangleWithUniformColor &&
+			   (param.Billboard == ::Effekseer::BillboardType::Billboard || param.Billboard == ::Effekseer::BillboardType::RotatedBillboard);
+	}
+
+	template <bool FLIP_RGB>
+	void RenderingInstanced_Internal(const efkSpriteNodeParam& parameter,
+									 const efkSpriteInstanceParam& instanceParameter,
+									 const ::Effekseer::SIMD::Mat44f& camera,
+									 uint8_t* data)
+	{
+		auto& v = *reinterpret_cast<SpriteInstanceVertex*>(data);
+
+		Effekseer::SIMD::Mat43f mat_rot = Effekseer::SIMD::Mat43f::Identity;
+		Effekseer::SIMD::Vec3f s;
+		Effekseer::SIMD::Vec3f R;
+		Effekseer::SIMD::Vec3f F;
+
+		if (parameter.EnableViewOffset == true)
+		{
+			Effekseer::SIMD::Mat43f instMat = instanceParameter.SRTMatrix43;
+
+			ApplyViewOffset(instMat, camera, instanceParameter.ViewOffsetDistance);
+
+			CalcBillboard(parameter.Billboard, mat_rot, s, R, F, instMat, m_renderer->GetCameraFrontDirection());
+		}
+		else
+		{
+			CalcBillboard(parameter.Billboard, mat_rot, s, R, F, instanceParameter.SRTMatrix43, m_renderer->GetCameraFrontDirection());
+		}
+
+		ApplyDepthParameters(mat_rot,
+							 m_renderer->GetCameraFrontDirection(),
+							 m_renderer->GetCameraPosition(),
+							 s,
+							 parameter.DepthParameterPtr,
+							 parameter.IsRightHand);
+
+		const auto t = mat_rot.GetTranslation();
+		v.Pos.X = t.GetX();
+		v.Pos.Y = t.GetY();
+		v.Pos.Z = t.GetZ();
+
+		v.SetColor(instanceParameter.Colors[0], FLIP_RGB);
+
+		// a scale by depth parameters is contained because the axis is not normalized
+		const efkVector3D axisX(mat_rot.X.GetX(), mat_rot.Y.GetX(), mat_rot.Z.GetX());
+		v.Rotation[0] = efkVector3D::Dot(axisX, billboardRight_);
+		v.Rotation[1] = efkVector3D::Dot(axisX, billboardUp_);
+
+		v.UV[0] = instanceParameter.UV.X;
+		v.UV[1] = instanceParameter.UV.Y;
+		v.UV[2] = instanceParameter.UV.X + instanceParameter.UV.Width;
+		v.UV[3] = instanceParameter.UV.Y + instanceParameter.UV.Height;
+
+		v.Extent[0] = instanceParameter.Positions[0].GetX() * s.GetX();
+		v.Extent[1] = instanceParameter.Positions[0].GetY() * s.GetY();
+		v.Extent[2] = instanceParameter.Positions[3].GetX() * s.GetX();
+		v.Extent[3] = instanceParameter.Positions[3].GetY() * s.GetY();
+	}
+
 	template <typename VERTEX, bool FLIP_RGB>
 	void Rendering_Internal(const efkSpriteNodeParam& parameter,
 							const efkSpriteInstanceParam& instanceParameter,
-							const ::Effekseer::SIMD::Mat44f& camera)
+							const ::Effekseer::SIMD::Mat44f& camera,
+							uint8_t* data)
 	{
-		if (m_ringBufferData == nullptr)
-			return;
-
-		StrideView<VERTEX> verteies(m_ringBufferData, stride_, 4);
+		StrideView<VERTEX> verteies(data, stride_, 4);
 
 		for (int i = 0; i < 4; i++)
 		{
@@ -379,7 +512,7 @@ protected:
 		// custom parameter
 		if (customData1Count_ > 0)
 		{
-			StrideView<float> custom(m_ringBufferData + sizeof(DynamicVertex), stride_, 4);
+			StrideView<float> custom(data + sizeof(DynamicVertex), stride_, 4);
 			for (int i = 0; i < 4; i++)
 			{
 				auto c = (float*)(&custom[i]);
@@ -389,16 +522,13 @@ protected:
 
 		if (customData2Count_ > 0)
 		{
-			StrideView<float> custom(m_ringBufferData + sizeof(DynamicVertex) + sizeof(float) * customData1Count_, stride_, 4);
+			StrideView<float> custom(data + sizeof(DynamicVertex) + sizeof(float) * customData1Count_, stride_, 4);
 			for (int i = 0; i < 4; i++)
 			{
 				auto c = (float*)(&custom[i]);
 				memcpy(c, instanceParameter.CustomData2.data(), sizeof(float) * customData2Count_);
 			}
 		}
-
-		m_ringBufferData += (stride_ * 4);
-		m_spriteCount++;
 	}
 
 	void EndRendering_(RENDERER* renderer, const efkSpriteNodeParam& param)
@@ -428,17 +558,50 @@ protected:
 				std::sort(instances.begin(), instances.end(), [](const KeyValue& a, const KeyValue& b) -> bool
 						  { return a.Key > b.Key; });
 			}
+		}
 
+		if (param.ZSort != Effekseer::ZSortType::None || isVertexGenerationParallel_)
+		{
+			RenderingInstances(renderer, param);
+		}
+
+		renderer->GetStandardRenderer()->EndRenderingAndRenderingIfRequired();
+	}
+
+	void RenderingInstances(RENDERER* renderer, const efkSpriteNodeParam& param)
+	{
+		const auto camera = m_renderer->GetCameraMatrix();
+		const auto& state = renderer->GetStandardRenderer()->GetState();
+
+		if (!isVertexGenerationParallel_)
+		{
 			for (auto& kv : instances)
 			{
-				auto camera = m_renderer->GetCameraMatrix();
-				const auto& state = renderer->GetStandardRenderer()->GetState();
-
 				RenderingInstance(kv.Value, param, state, camera);
 			}
+			return;
 		}
 
-		renderer->GetStandardRenderer()->EndRenderingAndRenderingIfRequired();
+		if (m_ringBufferData == nullptr)
+			return;
+
+		// each instance is written into its own range, so vertices are same as vertices generated serially
+		const int32_t sizePerInstance = GetVertexSizePerInstance(state);
+		uint8_t* const data = m_ringBufferData;
+
+		m_renderer->GetImpl()->RunVertexGeneration(
+			static_cast<int32_t>(instances.size()),
+			VertexGenerationCountPerThread,
+			[&](int32_t begin, int32_t end)
+			{
+				for (int32_t i = begin; i < end; i++)
+				{
+					RenderingInstance(instances[i].Value, param, state, camera, data + sizePerInstance * i);
+				}
+			});
+
+		m_ringBufferData += sizePerInstance * instances.size();
+		m_spriteCount += static_cast<int32_t>(instances.size());
 	}
 
 public:
@@ -5,6 +5,7 @@
 #include <Effekseer.h>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 #include "EffekseerRenderer.CommonUtils.h"
@@ -62,6 +63,12 @@ struct StandardRendererState
 	int32_t CustomData1Count = 0;
 	int32_t CustomData2Count = 0;
 
+	//! use compact vertices which have half float UVs
+	bool IsCompactVertex = false;
+
+	//! use SpriteInstanceVertex which is expanded into a quad on GPU
+	bool IsInstancedSprite = false;
+
 	ShaderParameterCollector Collector{};
 
 	Effekseer::RefPtr<Effekseer::RenderingUserData> RenderingUserData{};
@@ -188,7 +195,13 @@ struct StandardRendererState
 		if (CustomData1Count != state.CustomData1Count)
 			return true;
 
-		if (CustomData1Count != state.CustomData1Count)
+		if (CustomData2Count != state.CustomData2Count)
+			return true;
+
+		if (IsCompactVertex != state.IsCompactVertex)
+			return true;
+
+		if (IsInstancedSprite != state.IsInstancedSprite)
 			return true;
 
 		if (RenderingUserData == nullptr && state.RenderingUserData != nullptr)
@@ -206,6 +219,47 @@ struct StandardRendererState
 		return false;
 	}
 
+	/**
+		@brief	calculate a hash. states which are equal have the same hash.
+		@note	some parameters which are rarely different are not hashed and they are compared with operator==
+	*/
+	uint64_t CalculateHash() const
+	{
+		Effekseer::HashBuilder hash;
+		const auto combine = [&hash](uint64_t value) { hash.AddValue(value); };
+
+		// -0.0f is equal to 0.0f
+		const auto combineFloat = [&hash](float value) { hash.AddFloat(value); };
+
+		combine(static_cast<uint64_t>(Collector.ShaderType));
+		combine(reinterpret_cast<uintptr_t>(Collector.MaterialRenderDataPtr));
+		combine(reinterpret_cast<uintptr_t>(Collector.MaterialDataPtr.Get()));
+		combine(static_cast<uint64_t>(Collector.TextureCount));
+		for (int32_t i = 0; i < Collector.TextureCount; i++)
+		{
+			combine(reinterpret_cast<uintptr_t>(Collector.Textures[i].Get()));
+			combine(static_cast<uint64_t>(Collector.TextureFilterTypes[i]) << 8 | static_cast<uint64_t>(Collector.TextureWrapTypes[i]));
+		}
+
+		combine(static_cast<uint64_t>(DepthTest) | static_cast<uint64_t>(DepthWrite) << 1 | static_cast<uint64_t>(Distortion) << 2 | static_cast<uint64_t>(Refraction) << 3 | static_cast<uint64_t>(IsAlphaCuttoffEnabled) << 4 | static_cast<uint64_t>(IsCompactVertex) << 5 | static_cast<uint64_t>(IsInstancedSprite) << 6);
+		combine(static_cast<uint64_t>(AlphaBlend) | static_cast<uint64_t>(CullingType) << 8 | static_cast<uint64_t>(MaterialType) << 16);
+		combine(static_cast<uint64_t>(TextureBlendType));
+		combine(static_cast<uint64_t>(Flipbook.FlipbookDivideX) | static_cast<uint64_t>(Flipbook.FlipbookDivideY) << 32);
+
+		combineFloat(DistortionIntensity);
+		combineFloat(UVDistortionIntensity);
+		combineFloat(BlendUVDistortionIntensity);
+		combineFloat(EmissiveScaling);
+		combineFloat(EdgeThreshold);
+		combineFloat(Maginification);
+		combineFloat(LocalTime);
+
+		combine(static_cast<uint64_t>(MaterialUniformCount) | static_cast<uint64_t>(MaterialGradientCount) << 16 | static_cast<uint64_t>(CustomData1Count) << 32 | static_cast<uint64_t>(CustomData2Count) << 48);
+		combine(reinterpret_cast<uintptr_t>(HandleUserData));
+
+		return hash.Get();
+	}
+
 	void CopyMaterialFromParameterToState(
 		EffekseerRenderer::Renderer* renderer,
 		Effekseer::Effect* effect,
@@ -226,6 +280,10 @@ struct StandardRendererState
 		Collector = ShaderParameterCollector();
 		Collector.Collect(renderer, effect, basicParam, false, renderer->GetImpl()->isSoftParticleEnabled);
 
+		// an external shader expects default vertices
+		IsCompactVertex = renderer->GetImpl()->isCompactVertexEnabled && renderer->GetImpl()->isCompactVertexSupported &&
+						  Collector.ShaderType != RendererShaderType::Material && renderer->GetExternalShaderSettings() == nullptr;
+
 		SoftParticleDistanceFar = basicParam->SoftParticleDistanceFar;
 		SoftParticleDistanceNear = basicParam->SoftParticleDistanceNear;
 		SoftParticleDistanceNearOffset = basicParam->SoftParticleDistanceNearOffset;
@@ -258,6 +316,73 @@ struct StandardRendererState
 	}
 };
 
+/**
+	@brief	a table which interns states and gives a small id to each of them
+	@note	equal states have the same id until the table is cleared. it is cleared at the end of rendering, so ids are stable across flushes.
+*/
+class StandardRendererStateTable
+{
+	std::vector<StandardRendererState> states_;
+	std::vector<uint64_t> hashes_;
+
+	//! states which have the same hash are chained from the last one
+	std::vector<int32_t> nextIds_;
+	std::unordered_map<uint64_t, int32_t> lastIds_;
+
+public:
+	int32_t Intern(const StandardRendererState& state)
+	{
+		const auto hash = state.CalculateHash();
+		const auto it = lastIds_.find(hash);
+
+		if (it != lastIds_.end())
+		{
+			for (int32_t id = it->second; id >= 0; id = nextIds_[id])
+			{
+				if (states_[id] == state)
+				{
+					return id;
+				}
+			}
+		}
+
+		const auto id = static_cast<int32_t>(states_.size());
+		states_.emplace_back(state);
+		hashes_.emplace_back(hash);
+
+		if (it != lastIds_.end())
+		{
+			nextIds_.emplace_back(it->second);
+			it->second = id;
+		}
+		else
+		{
+			nextIds_.emplace_back(-1);
+			lastIds_[hash] = id;
+		}
+
+		return id;
+	}
+
+	const StandardRendererState& Get(int32_t id) const
+	{
+		return states_[id];
+	}
+
+	uint64_t GetHash(int32_t id) const
+	{
+		return hashes_[id];
+	}
+
+	void Clear()
+	{
+		states_.clear();
+		hashes_.clear();
+		nextIds_.clear();
+		lastIds_.clear();
+	}
+};
+
 struct StandardRendererVertexBuffer
 {
 	Effekseer::Matrix44 constantVSBuffer[2];
@@ -266,15 +391,64 @@ struct StandardRendererVertexBuffer
 	FlipbookVertexBuffer flipbookParameter;
 };
 
+//! it follows StandardRendererVertexBuffer for SpriteInstanceVertex
+struct SpriteInstanceVertexBuffer
+{
+	float billboardRight[4];
+	float billboardUp[4];
+};
+
 template <typename RENDERER, typename SHADER>
 class StandardRenderer
 {
 private:
 	RENDERER* m_renderer;
 
+	//! only backends which support compact vertices have GetCompactVertexShader
+	template <typename T>
+	static auto GetShader(T* renderer, const StandardRendererState& state) -> decltype(renderer->GetCompactVertexShader(state.Collector.ShaderType))
+	{
+		if (state.IsCompactVertex)
+		{
+			return renderer->GetCompactVertexShader(state.Collector.ShaderType);
+		}
+
+		return renderer->GetShader(state.Collector.ShaderType);
+	}
+
+	template <typename T, typename... Args>
+	static SHADER* GetShader(T* renderer, const StandardRendererState& state, Args...)
+	{
+		return renderer->GetShader(state.Collector.ShaderType);
+	}
+
+	//! only backends which support instanced sprites have GetInstancedSpriteShader and DrawSpritesInstanced
+	template <typename T>
+	static auto GetInstancedSpriteShader(T* renderer) -> decltype(renderer->GetInstancedSpriteShader())
+	{
+		return renderer->GetInstancedSpriteShader();
+	}
+
+	template <typename T, typename... Args>
+	static SHADER* GetInstancedSpriteShader(T* renderer, Args...)
+	{
+		return nullptr;
+	}
+
+	template <typename T>
+	static auto DrawSpritesInstanced(T* renderer, SHADER* shader, int32_t instanceCount, int32_t vertexOffset) -> decltype(renderer->DrawSpritesInstanced(shader, instanceCount, vertexOffset))
+	{
+		renderer->DrawSpritesInstanced(shader, instanceCount, vertexOffset);
+	}
+
+	template <typename T, typename... Args>
+	static void DrawSpritesInstanced(T* renderer, SHADER* shader, int32_t instanceCount, int32_t vertexOffset, Args...)
+	{
+	}
+
 	struct RenderInfo
 	{
-		StandardRendererState state;
+		int32_t stateId;
 		int offset;
 		int size;
 		int stride;
@@ -288,7 +462,20 @@ private:
 	int32_t vertexCacheOffset_ = 0;
 	EffekseerRenderer::VertexBufferBase* lastVb_ = nullptr;
 
+	//! vertices are written into the mapped vertex buffer directly instead of vertexCaches_ if a vertex buffer supports it
+	uint8_t* directVertexBuffer_ = nullptr;
+	int32_t directVertexOffset_ = 0;
+
 	Effekseer::CustomAlignedVector<RenderInfo> renderInfos_;
+
+	//! states which are referred by renderInfos_. they are kept until the end of rendering
+	StandardRendererStateTable stateTable_;
+
+	//! buffers to sort render infos
+	Effekseer::CustomAlignedVector<RenderInfo> sortedRenderInfos_;
+	std::vector<uint64_t> sortKeys_;
+	std::vector<int32_t> sortedIndexes_;
+	std::vector<uint8_t> sortedVertexCaches_;
 	int32_t gpuTimerCount_ = 0;
 
 	void ColorToFloat4(::Effekseer::Color color, float fc[4])
@@ -317,10 +504,45 @@ public:
 	{
 	}
 
+	//! it must be called when the size of vertex buffers is changed
+	void ResetVertexCacheMaxSize()
+	{
+		vertexCacheMaxSize_ = m_renderer->GetVertexBuffer()->GetMaxSize();
+		vertexCaches_.reserve(m_renderer->GetVertexBuffer()->GetMaxSize());
+	}
+
 	static int32_t CalculateCurrentStride(const StandardRendererState& state)
 	{
 		const auto renderingMode = state.Collector.ShaderType;
 		size_t stride = 0;
+
+		if (state.IsInstancedSprite)
+		{
+			return static_cast<int32_t>(sizeof(SpriteInstanceVertex));
+		}
+
+		if (state.IsCompactVertex)
+		{
+			if (renderingMode == RendererShaderType::Lit || renderingMode == RendererShaderType::BackDistortion)
+			{
+				stride = sizeof(CompactLightingVertex);
+			}
+			else if (renderingMode == RendererShaderType::Unlit)
+			{
+				stride = sizeof(CompactSimpleVertex);
+			}
+			else if (renderingMode == RendererShaderType::AdvancedLit || renderingMode == RendererShaderType::AdvancedBackDistortion)
+			{
+				stride = sizeof(CompactAdvancedLightingVertex);
+			}
+			else if (renderingMode == RendererShaderType::AdvancedUnlit)
+			{
+				stride = sizeof(CompactAdvancedSimpleVertex);
+			}
+
+			return static_cast<int32_t>(stride);
+		}
+
 		if (renderingMode == RendererShaderType::Material)
 		{
 			stride = sizeof(DynamicVertex);
@@ -366,13 +588,17 @@ public:
 		const int32_t requiredSize = count * stride;
 		const auto spriteStride = stride * 4;
 		const auto maxVertexCount = m_renderer->GetSquareMaxCount() * 4;
+		const auto squareCount = state.IsInstancedSprite ? count : count / 4;
 
 		if (requiredSize > vertexCacheMaxSize_ || requiredSize == 0)
 		{
+			m_renderer->GetImpl()->ReportSquareCount(squareCount, 0);
 			data = nullptr;
 			return;
 		}
 
+		m_renderer->GetImpl()->ReportSquareCount(squareCount, squareCount);
+
 		if (requiredSize + EffekseerRenderer::VertexBufferBase::GetNextAliginedVertexRingOffset(vertexCacheOffset_, spriteStride) > vertexCacheMaxSize_ || count > maxVertexCount)
 		{
 			Rendering();
@@ -394,20 +620,36 @@ public:
 			{
 				vertexCacheOffset_ = 0;
 			}
+
+			vertexCacheOffset_ = EffekseerRenderer::VertexBufferBase::GetNextAliginedVertexRingOffset(vertexCacheOffset_, spriteStride);
+
+			// sorting reads all vertices back, so they are written into vertexCaches_ instead of a mapped memory which may be uncached
+			directVertexBuffer_ = m_renderer->GetImpl()->isStateSortingEnabled ? nullptr : vb->MapRingBufferDirect(vertexCacheOffset_);
+			directVertexOffset_ = vertexCacheOffset_;
 		}
 
 		vertexCacheOffset_ = EffekseerRenderer::VertexBufferBase::GetNextAliginedVertexRingOffset(vertexCacheOffset_, spriteStride);
 
 		const auto oldOffset = vertexCacheOffset_;
 		vertexCacheOffset_ += requiredSize;
-		if (vertexCaches_.size() < vertexCacheOffset_)
+
+		if (directVertexBuffer_ != nullptr)
+		{
+			data = (directVertexBuffer_ + (oldOffset - directVertexOffset_));
+		}
+		else
 		{
-			vertexCaches_.resize(vertexCacheOffset_);
+			if (vertexCaches_.size() < vertexCacheOffset_)
+			{
+				vertexCaches_.resize(vertexCacheOffset_);
+			}
+
+			data = (vertexCaches_.data() + oldOffset);
 		}
 
-		data = (vertexCaches_.data() + oldOffset);
+		const auto stateId = stateTable_.Intern(state);
 
-		if (renderInfos_.size() > 0 && renderInfos_.back().state == state && (renderInfos_.back().size + requiredSize) / spriteStride <= m_renderer->GetSquareMaxCount())
+		if (renderInfos_.size() > 0 && renderInfos_.back().stateId == stateId && (renderInfos_.back().size + requiredSize) / spriteStride <= m_renderer->GetSquareMaxCount())
 		{
 			RenderInfo& renderInfo = renderInfos_.back();
 			renderInfo.size += requiredSize;
@@ -415,7 +657,7 @@ public:
 		else
 		{
 			RenderInfo renderInfo;
-			renderInfo.state = state;
+			renderInfo.stateId = stateId;
 			renderInfo.size = requiredSize;
 			renderInfo.offset = oldOffset;
 			renderInfo.stride = stride;
@@ -438,10 +680,179 @@ public:
 		Rendering();
 	}
 
-	StandardRendererState& GetState()
+	/**
+		@brief	release states which are interned while rendering
+		@note	it is called at the end of rendering after queued batches are rendered
+	*/
+	void ClearStates()
+	{
+		assert(renderInfos_.size() == 0);
+		stateTable_.Clear();
+	}
+
+	const StandardRendererState& GetState() const
 	{
 		assert(renderInfos_.size() > 0);
-		return renderInfos_.back().state;
+		return stateTable_.Get(renderInfos_.back().stateId);
+	}
+
+	/**
+		@brief	get a group of render infos which can be reordered each other without changing a result
+		@note	0 means that the order must be kept
+	*/
+	int32_t GetReorderableGroup(const RenderInfo& info) const
+	{
+		const auto& state = stateTable_.Get(info.stateId);
+
+		if (info.hasDistortion || state.Distortion || state.Refraction || state.Collector.IsBackgroundRequiredOnFirstPass)
+		{
+			return 0;
+		}
+
+		if (state.AlphaBlend == ::Effekseer::AlphaBlendType::Opacity)
+		{
+			// a result is decided by a depth test
+			return (state.DepthTest && state.DepthWrite) ? 1 : 0;
+		}
+
+		// a depth written by the previous draw changes a result
+		if (state.DepthWrite)
+		{
+			return 0;
+		}
+
+		// a blend with the same operator is commutative even if a color is saturated
+		if (state.AlphaBlend == ::Effekseer::AlphaBlendType::Add)
+		{
+			return 2;
+		}
+
+		if (state.AlphaBlend == ::Effekseer::AlphaBlendType::Sub)
+		{
+			return 3;
+		}
+
+		if (state.AlphaBlend == ::Effekseer::AlphaBlendType::Mul)
+		{
+			return 4;
+		}
+
+		return 0;
+	}
+
+	uint64_t CalculateSortKey(int32_t stateId) const
+	{
+		const auto& state = stateTable_.Get(stateId);
+
+		// blend and shader are the most expensive to change
+		const auto blend = static_cast<uint64_t>(state.AlphaBlend) & 0xF;
+		const auto shader = static_cast<uint64_t>(state.Collector.ShaderType) & 0xF;
+		return (blend << 60) | (shader << 56) | (stateTable_.GetHash(stateId) & 0x00FFFFFFFFFFFFFFULL);
+	}
+
+	/**
+		@brief	reorder render infos by states where the order doesn't change a result, and merge the same states
+		@note	vertices in [start, end) are moved to keep a merged render info contiguous
+	*/
+	void SortAndMergeRenderInfos(uint8_t* vertexBuffer, int32_t start, int32_t& end)
+	{
+		const auto count = static_cast<int32_t>(renderInfos_.size());
+
+		sortKeys_.resize(count);
+		sortedIndexes_.resize(count);
+
+		for (int32_t i = 0; i < count; i++)
+		{
+			sortKeys_[i] = CalculateSortKey(renderInfos_[i].stateId);
+			sortedIndexes_[i] = i;
+		}
+
+		bool isReordered = false;
+
+		for (int32_t runStart = 0; runStart < count;)
+		{
+			const auto group = GetReorderableGroup(renderInfos_[runStart]);
+			int32_t runEnd = runStart + 1;
+
+			if (group != 0)
+			{
+				while (runEnd < count && GetReorderableGroup(renderInfos_[runEnd]) == group)
+				{
+					runEnd++;
+				}
+
+				if (runEnd - runStart > 1)
+				{
+					std::stable_sort(sortedIndexes_.begin() + runStart, sortedIndexes_.begin() + runEnd, [this](int32_t a, int32_t b) {
+						return sortKeys_[a] < sortKeys_[b];
+					});
+
+					for (int32_t i = runStart; i < runEnd; i++)
+					{
+						isReordered |= sortedIndexes_[i] != i;
+					}
+				}
+			}
+
+			runStart = runEnd;
+		}
+
+		if (!isReordered)
+		{
+			return;
+		}
+
+		// layout vertices in the sorted order
+		const auto squareMaxCount = m_renderer->GetSquareMaxCount();
+		sortedRenderInfos_.clear();
+
+		int32_t offset = start;
+		for (int32_t i = 0; i < count; i++)
+		{
+			auto info = renderInfos_[sortedIndexes_[i]];
+			const auto spriteStride = info.stride * 4;
+			offset = EffekseerRenderer::VertexBufferBase::GetNextAliginedVertexRingOffset(offset, spriteStride);
+
+			if (sortedRenderInfos_.size() > 0)
+			{
+				auto& last = sortedRenderInfos_.back();
+				if (last.offset + last.size == offset && last.stateId == info.stateId && (last.size + info.size) / spriteStride <= squareMaxCount)
+				{
+					last.size += info.size;
+					offset += info.size;
+					continue;
+				}
+			}
+
+			info.offset = offset;
+			sortedRenderInfos_.emplace_back(info);
+			offset += info.size;
+		}
+
+		// padding may make it overflow
+		if (offset > vertexCacheMaxSize_)
+		{
+			return;
+		}
+
+		if (sortedVertexCaches_.size() < static_cast<size_t>(offset - start))
+		{
+			sortedVertexCaches_.resize(offset - start);
+		}
+
+		int32_t dst = start;
+		for (int32_t i = 0; i < count; i++)
+		{
+			const auto& info = renderInfos_[sortedIndexes_[i]];
+			dst = EffekseerRenderer::VertexBufferBase::GetNextAliginedVertexRingOffset(dst, info.stride * 4);
+			memcpy(sortedVertexCaches_.data() + (dst - start), vertexBuffer + info.offset, info.size);
+			dst += info.size;
+		}
+
+		memcpy(vertexBuffer + start, sortedVertexCaches_.data(), offset - start);
+
+		std::swap(renderInfos_, sortedRenderInfos_);
+		end = offset;
 	}
 
 	void Rendering()
@@ -460,6 +871,16 @@ public:
 			cpuBufEnd = Effekseer::Max(cpuBufEnd, info.offset + info.size);
 		}
 
+		// the ring buffer is aligned with the first render info before sorting
+		const int32_t alignment = renderInfos_.begin()->stride * 4;
+
+		if (m_renderer->GetImpl()->isStateSortingEnabled && renderInfos_.size() > 1)
+		{
+			assert(directVertexBuffer_ == nullptr);
+			vertexCaches_.resize(Effekseer::Max(static_cast<int32_t>(vertexCaches_.size()), vertexCacheMaxSize_));
+			SortAndMergeRenderInfos(vertexCaches_.data(), cpuBufStart, cpuBufEnd);
+		}
+
 		const int cpuBufSize = cpuBufEnd - cpuBufStart;
 
 		{
@@ -468,8 +889,21 @@ public:
 
 			void* vbData = nullptr;
 			int32_t vbOffset = 0;
+			bool isUploaded = false;
 
-			if (vb->RingBufferLock(cpuBufSize, vbOffset, vbData, renderInfos_.begin()->stride * 4))
+			if (directVertexBuffer_ != nullptr)
+			{
+				// vertices are only in the mapped memory, so they are lost if they cannot be committed
+				directVertexBuffer_ = nullptr;
+				isUploaded = vb->CommitRingBufferDirect(cpuBufSize, vbOffset, alignment);
+				assert(!isUploaded || vbOffset == cpuBufStart);
+
+				if (isUploaded)
+				{
+					m_renderer->GetImpl()->vertexBufferUsedSize += cpuBufSize;
+				}
+			}
+			else if (vb->RingBufferLock(cpuBufSize, vbOffset, vbData, alignment))
 			{
 				assert(vbData != nullptr);
 				assert(vbOffset == cpuBufStart);
@@ -477,9 +911,24 @@ public:
 				const auto dst = (reinterpret_cast<uint8_t*>(vbData));
 				memcpy(dst, vertexCaches_.data() + cpuBufStart, cpuBufSize);
 				vb->Unlock();
+
+				m_renderer->GetImpl()->stagingVertexSize += cpuBufSize;
+				m_renderer->GetImpl()->vertexBufferUsedSize += cpuBufSize;
+				isUploaded = true;
 			}
-			else
+
+			if (!isUploaded)
 			{
+				// report squares which cannot be uploaded instead of losing them silently
+				for (const auto& info : renderInfos_)
+				{
+					const auto vertexCount = info.size / info.stride;
+					const auto squareCount = stateTable_.Get(info.stateId).IsInstancedSprite ? vertexCount : vertexCount / 4;
+					m_renderer->GetImpl()->ReportSquareCount(squareCount, 0);
+				}
+
+				renderInfos_.clear();
+
 				m_renderer->GetImpl()->CurrentRingBufferIndex++;
 				m_renderer->GetImpl()->CurrentRingBufferIndex %= m_renderer->GetImpl()->RingBufferCount;
 				return;
@@ -488,7 +937,7 @@ public:
 
 		for (auto& info : renderInfos_)
 		{
-			const auto& state = info.state;
+			const auto& state = stateTable_.Get(info.stateId);
 
 			const auto& mProj = m_renderer->GetProjectionMatrix();
 
@@ -614,9 +1063,13 @@ public:
 				shader_ = (SHADER*)renderState.Collector.MaterialDataPtr->UserPtr;
 			}
 		}
+		else if (renderState.IsInstancedSprite)
+		{
+			shader_ = GetInstancedSpriteShader(m_renderer);
+		}
 		else
 		{
-			shader_ = m_renderer->GetShader(renderState.Collector.ShaderType);
+			shader_ = GetShader(m_renderer, renderState);
 		}
 
 		// validate
@@ -864,6 +1317,25 @@ public:
 
 			m_renderer->SetVertexBufferToShader(&vcb, sizeof(StandardRendererVertexBuffer), 0);
 
+			if (renderState.IsInstancedSprite)
+			{
+				::Effekseer::SIMD::Vec3f right;
+				::Effekseer::SIMD::Vec3f up;
+				CalcBillboardAxes(right, up, m_renderer->GetCameraFrontDirection());
+
+				SpriteInstanceVertexBuffer sivb;
+				sivb.billboardRight[0] = right.GetX();
+				sivb.billboardRight[1] = right.GetY();
+				sivb.billboardRight[2] = right.GetZ();
+				sivb.billboardRight[3] = 0.0f;
+				sivb.billboardUp[0] = up.GetX();
+				sivb.billboardUp[1] = up.GetY();
+				sivb.billboardUp[2] = up.GetZ();
+				sivb.billboardUp[3] = 0.0f;
+
+				m_renderer->SetVertexBufferToShader(&sivb, sizeof(SpriteInstanceVertexBuffer), sizeof(StandardRendererVertexBuffer));
+			}
+
 			if (distortion)
 			{
 				PixelConstantBufferDistortion pcb;
@@ -945,10 +1417,19 @@ public:
 
 		m_renderer->SetVertexBuffer(m_renderer->GetVertexBuffer(), stride);
 		m_renderer->SetIndexBuffer(m_renderer->GetIndexBuffer());
-		m_renderer->SetLayout(shader_);
 		m_renderer->GetImpl()->CurrentRenderingUserData = renderState.RenderingUserData;
 		m_renderer->GetImpl()->CurrentHandleUserData = renderState.HandleUserData;
-		m_renderer->DrawSprites(bufferSize / stride / 4, vbOffset / stride);
+
+		if (renderState.IsInstancedSprite)
+		{
+			// a layout is enabled with an offset of instances in DrawSpritesInstanced
+			DrawSpritesInstanced(m_renderer, shader_, bufferSize / stride, vbOffset);
+		}
+		else
+		{
+			m_renderer->SetLayout(shader_);
+			m_renderer->DrawSprites(bufferSize / stride / 4, vbOffset / stride);
+		}
 
 		m_renderer->EndShader(shader_);
 
@@ -41,6 +41,7 @@ protected:
 	Effekseer::CustomAlignedVector<Effekseer::SIMD::Quaternionf> rotations_temp_;
 	Effekseer::CustomAlignedVector<Effekseer::SIMD::Quaternionf> rotations_;
 	Effekseer::SplineGenerator spline;
+	Effekseer::CustomAlignedVector<Effekseer::SIMD::Vec3f> spline_values_;
 
 	int32_t vertexCount_ = 0;
 	int32_t stride_ = 0;
@@ -529,6 +530,8 @@ protected:
 			}
 
 			spline.Calculate();
+
+			spline_values_.resize(parameter.SplineDivision);
 		}
 
 		StrideView<VERTEX> verteies(m_ringBufferData, stride_, vertexCount_);
@@ -537,6 +540,12 @@ protected:
 		{
 			auto& param = instances[loop];
 
+			// evaluate a segment at once
+			if (parameter.SplineDivision > 1)
+			{
+				spline.GetValues(param.InstanceIndex, parameter.SplineDivision, spline_values_.data());
+			}
+
 			for (int32_t sploop = 0; sploop < parameter.SplineDivision; sploop++)
 			{
 				auto mat = param.SRTMatrix43;
@@ -656,7 +665,7 @@ protected:
 
 				if (parameter.SplineDivision > 1)
 				{
-					v[1].Pos = ToStruct(spline.GetValue(param.InstanceIndex + sploop / (float)parameter.SplineDivision));
+					v[1].Pos = ToStruct(spline_values_[sploop]);
 				}
 				else
 				{
@@ -947,7 +956,26 @@ protected:
 		const auto& state = m_renderer->GetStandardRenderer()->GetState();
 		const ShaderParameterCollector& collector = state.Collector;
 
-		if (collector.ShaderType == RendererShaderType::Material)
+		if (state.IsCompactVertex)
+		{
+			if (collector.ShaderType == RendererShaderType::AdvancedLit || collector.ShaderType == RendererShaderType::AdvancedBackDistortion)
+			{
+				Rendering_Internal<CompactAdvancedLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+			else if (collector.ShaderType == RendererShaderType::AdvancedUnlit)
+			{
+				Rendering_Internal<CompactAdvancedSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+			else if (collector.ShaderType == RendererShaderType::Lit || collector.ShaderType == RendererShaderType::BackDistortion)
+			{
+				Rendering_Internal<CompactLightingVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+			else
+			{
+				Rendering_Internal<CompactSimpleVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
+			}
+		}
+		else if (collector.ShaderType == RendererShaderType::Material)
 		{
 			Rendering_Internal<DynamicVertex, FLIP_RGB_FLAG>(parameter, instanceParameter, camera);
 		}
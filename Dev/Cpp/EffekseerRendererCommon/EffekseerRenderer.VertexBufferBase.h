@@ -41,6 +41,24 @@ public:
 	virtual bool TryRingBufferLock(int32_t size, int32_t& offset, void*& data, int32_t alignment) = 0;
 
 	virtual void Unlock() = 0;
+
+	/**
+		@brief	map the ring buffer from offset and get a memory which vertices are written into directly. if it is not supported, it returns nullptr.
+		@note	offset must be the aligned ring offset of the next CommitRingBufferDirect. the memory may be uncached, so reading it back is slow.
+	*/
+	virtual uint8_t* MapRingBufferDirect(int32_t offset)
+	{
+		return nullptr;
+	}
+
+	/**
+		@brief	unmap the memory of MapRingBufferDirect() and use size bytes of it as the ring buffer. if it fails, written vertices are lost.
+	*/
+	virtual bool CommitRingBufferDirect(int32_t size, int32_t& offset, int32_t alignment)
+	{
+		return false;
+	}
+
 	virtual void Push(const void* buffer, int size);
 	virtual int GetMaxSize() const;
 	virtual int GetSize() const;
@@ -23,6 +23,12 @@ public:
 	Effekseer::ModelRef Load(const void* data, int32_t size) override;
 
 	void Unload(Effekseer::ModelRef data) override;
+
+	//! models are only parsed and they are stored on GPU when they are rendered
+	bool GetIsThreadSafe() const override
+	{
+		return true;
+	}
 };
 
 } // namespace EffekseerRenderer
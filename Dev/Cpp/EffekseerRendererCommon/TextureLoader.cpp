@@ -4,6 +4,11 @@
 #include "EffekseerRenderer.DDSTextureLoader.h"
 #include "EffekseerRenderer.PngTextureLoader.h"
 #include "EffekseerRenderer.TGATextureLoader.h"
+#include <Effekseer/Effekseer.WorkerThread.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #endif
 
 namespace EffekseerRenderer
@@ -42,6 +47,107 @@ public:
 }
 
 #ifndef __DISABLED_DEFAULT_TEXTURE_LOADER__
+
+namespace
+{
+
+//! a texture which is decoded on CPU and is not created on GPU yet
+struct DecodedTexture
+{
+	::Effekseer::Backend::TextureParameter param;
+	Effekseer::CustomVector<uint8_t> data;
+};
+
+//! decode a file into pixels. It doesn't touch a graphics device, so it can be called on any thread.
+bool DecodeTexture(DecodedTexture& decoded, const void* data, int32_t size, Effekseer::TextureType textureType, bool isMipMapEnabled, ::Effekseer::ColorSpaceType colorSpaceType)
+{
+	auto size_texture = size;
+	auto data_texture = (uint8_t*)data;
+
+	::Effekseer::Backend::TextureFormatType format;
+	if (colorSpaceType == ::Effekseer::ColorSpaceType::Linear && textureType == Effekseer::TextureType::Color)
+	{
+		format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM_SRGB;
+	}
+	else
+	{
+		format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM;
+	}
+
+	auto& param = decoded.param;
+
+	if (size_texture < 4)
+	{
+	}
+	else if (data_texture[1] == 'P' && data_texture[2] == 'N' && data_texture[3] == 'G')
+	{
+		::EffekseerRenderer::PngTextureLoader pngTextureLoader;
+		if (pngTextureLoader.Load(data_texture, size_texture, false))
+		{
+			param.Size[0] = pngTextureLoader.GetWidth();
+			param.Size[1] = pngTextureLoader.GetHeight();
+			param.Format = format;
+			param.MipLevelCount = isMipMapEnabled ? 0 : 1;
+			param.Dimension = 2;
+
+			decoded.data.assign(pngTextureLoader.GetData().begin(), pngTextureLoader.GetData().end());
+			return true;
+		}
+	}
+	else if (data_texture[0] == 'D' && data_texture[1] == 'D' && data_texture[2] == 'S' && data_texture[3] == ' ')
+	{
+		::EffekseerRenderer::DDSTextureLoader ddsTextureLoader;
+		if (ddsTextureLoader.Load(data_texture, size_texture))
+		{
+			param.Size[0] = ddsTextureLoader.GetTextures().at(0).Width;
+			param.Size[1] = ddsTextureLoader.GetTextures().at(0).Height;
+			param.Dimension = 2;
+			param.Format = ddsTextureLoader.GetBackendTextureFormat();
+			param.MipLevelCount = 1; // TODO : Support nomipmap
+
+			decoded.data.assign(ddsTextureLoader.GetTextures().at(0).Data.begin(), ddsTextureLoader.GetTextures().at(0).Data.end());
+			return true;
+		}
+	}
+	else
+	{
+		::EffekseerRenderer::TGATextureLoader tgaTextureLoader;
+		if (tgaTextureLoader.Load(data_texture, size_texture) == true)
+		{
+			param.Size[0] = tgaTextureLoader.GetWidth();
+			param.Size[1] = tgaTextureLoader.GetHeight();
+			param.Format = format;
+			param.MipLevelCount = isMipMapEnabled ? 0 : 1;
+			param.Dimension = 2;
+
+			decoded.data.assign(tgaTextureLoader.GetData().begin(), tgaTextureLoader.GetData().end());
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//! create a decoded texture on GPU. If texture is specified, the backend is set into it instead of a new texture.
+Effekseer::TextureRef CreateDecodedTexture(const ::Effekseer::Backend::GraphicsDeviceRef& graphicsDevice, const DecodedTexture& decoded, Effekseer::TextureRef texture = nullptr)
+{
+	auto backend = graphicsDevice->CreateTexture(decoded.param, decoded.data);
+	if (backend == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (texture == nullptr)
+	{
+		texture = ::Effekseer::MakeRefPtr<::Effekseer::Texture>();
+	}
+
+	texture->SetBackend(backend);
+	return texture;
+}
+
+} // namespace
+
 class TextureLoader::Impl
 {
 public:
@@ -80,116 +186,19 @@ public:
 
 	Effekseer::TextureRef Load(const void* data, int32_t size, Effekseer::TextureType textureType, bool isMipMapEnabled)
 	{
-		auto size_texture = size;
-		auto data_texture = (uint8_t*)data;
-
-		if (size_texture < 4)
-		{
-		}
-		else if (data_texture[1] == 'P' && data_texture[2] == 'N' && data_texture[3] == 'G')
-		{
-			if (pngTextureLoader_.Load(data_texture, size_texture, false))
-			{
-				// Newbackend
-				{
-					::Effekseer::Backend::TextureFormatType format;
-					if (colorSpaceType_ == ::Effekseer::ColorSpaceType::Linear && textureType == Effekseer::TextureType::Color)
-					{
-						format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM_SRGB;
-					}
-					else
-					{
-						format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM;
-					}
-
-					::Effekseer::Backend::TextureParameter param;
-					param.Size[0] = pngTextureLoader_.GetWidth();
-					param.Size[1] = pngTextureLoader_.GetHeight();
-					param.Format = format;
-					param.MipLevelCount = isMipMapEnabled ? 0 : 1;
-					param.Dimension = 2;
-
-					Effekseer::CustomVector<uint8_t> initialData;
-					initialData.assign(pngTextureLoader_.GetData().begin(), pngTextureLoader_.GetData().end());
-
-					auto texture = ::Effekseer::MakeRefPtr<::Effekseer::Texture>();
-					texture->SetBackend(graphicsDevice_->CreateTexture(param, initialData));
-					return texture;
-				}
-			}
-		}
-		else if (data_texture[0] == 'D' && data_texture[1] == 'D' && data_texture[2] == 'S' && data_texture[3] == ' ')
-		{
-			// Newbackend
-			if (ddsTextureLoader_.Load(data_texture, size_texture))
-			{
-				::Effekseer::Backend::TextureFormatType format;
-				if (colorSpaceType_ == ::Effekseer::ColorSpaceType::Linear && textureType == Effekseer::TextureType::Color)
-				{
-					format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM_SRGB;
-				}
-				else
-				{
-					format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM;
-				}
-
-				::Effekseer::Backend::TextureParameter param;
-				param.Size[0] = ddsTextureLoader_.GetTextures().at(0).Width;
-				param.Size[1] = ddsTextureLoader_.GetTextures().at(0).Height;
-				param.Dimension = 2;
-				param.Format = ddsTextureLoader_.GetBackendTextureFormat();
-
-				Effekseer::CustomVector<uint8_t> initialData;
-				initialData.assign(ddsTextureLoader_.GetTextures().at(0).Data.begin(), ddsTextureLoader_.GetTextures().at(0).Data.end());
-				param.MipLevelCount = 1; // TODO : Support nomipmap
-
-				auto texture = ::Effekseer::MakeRefPtr<::Effekseer::Texture>();
-				texture->SetBackend(graphicsDevice_->CreateTexture(param, initialData));
-				return texture;
-			}
-		}
-		else
+		DecodedTexture decoded;
+		if (!DecodeTexture(decoded, data, size, textureType, isMipMapEnabled, colorSpaceType_))
 		{
-			if (tgaTextureLoader_.Load(data_texture, size_texture) == true)
-			{
-				// Newbackend
-				{
-					::Effekseer::Backend::TextureFormatType format;
-					if (colorSpaceType_ == ::Effekseer::ColorSpaceType::Linear && textureType == Effekseer::TextureType::Color)
-					{
-						format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM_SRGB;
-					}
-					else
-					{
-						format = ::Effekseer::Backend::TextureFormatType::R8G8B8A8_UNORM;
-					}
-
-					::Effekseer::Backend::TextureParameter param;
-					param.Size[0] = tgaTextureLoader_.GetWidth();
-					param.Size[1] = tgaTextureLoader_.GetHeight();
-					param.Format = format;
-					param.MipLevelCount = isMipMapEnabled ? 0 : 1;
-					param.Dimension = 2;
-					Effekseer::CustomVector<uint8_t> initialData;
-					initialData.assign(tgaTextureLoader_.GetData().begin(), tgaTextureLoader_.GetData().end());
-
-					auto texture = ::Effekseer::MakeRefPtr<::Effekseer::Texture>();
-					texture->SetBackend(graphicsDevice_->CreateTexture(param, initialData));
-					return texture;
-				}
-			}
+			return nullptr;
 		}
 
-		return nullptr;
+		return CreateDecodedTexture(graphicsDevice_, decoded);
 	}
 
 private:
 	::Effekseer::Backend::GraphicsDeviceRef graphicsDevice_;
 	::Effekseer::FileInterfaceRef fileInterface_;
 	::Effekseer::ColorSpaceType colorSpaceType_;
-	::EffekseerRenderer::PngTextureLoader pngTextureLoader_;
-	::EffekseerRenderer::DDSTextureLoader ddsTextureLoader_;
-	::EffekseerRenderer::TGATextureLoader tgaTextureLoader_;
 };
 
 TextureLoader::TextureLoader(::Effekseer::Backend::GraphicsDeviceRef graphicsDevice,
@@ -209,6 +218,282 @@ Effekseer::TextureRef TextureLoader::Load(const void* data, int32_t size, Effeks
 	return impl_->Load(data, size, textureType, isMipMapEnabled);
 }
 
+class StreamingTextureLoaderImplemented : public StreamingTextureLoader
+{
+private:
+	struct Request
+	{
+		Effekseer::TextureRef texture;
+		Effekseer::TextureType textureType;
+		bool isMipMapEnabled = true;
+
+		//! a path to be read on a worker thread. If it is empty, fileData is decoded.
+		std::u16string path;
+		std::vector<uint8_t> fileData;
+
+		DecodedTexture decoded;
+		bool isDecoded = false;
+
+		//! it is set in Unload while the request is decoded or waits for creating. It is protected by mutex_.
+		bool isUnloaded = false;
+	};
+
+	::Effekseer::Backend::GraphicsDeviceRef graphicsDevice_;
+	::Effekseer::FileInterfaceRef fileInterface_;
+	::Effekseer::ColorSpaceType colorSpaceType_;
+
+	std::vector<Effekseer::WorkerThread> workerThreads_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable requestCV_;
+	std::condition_variable decodedCV_;
+
+	//! requests which are waiting for decoding
+	std::deque<std::unique_ptr<Request>> requests_;
+
+	//! requests which are decoded by worker threads now
+	std::vector<Request*> decodingRequests_;
+
+	//! requests which are decoded and waiting for creating on GPU
+	std::deque<std::unique_ptr<Request>> decodedRequests_;
+
+	//! the number of requests which are not created yet. It is changed only on the calling thread.
+	int32_t pendingCount_ = 0;
+
+	bool isQuitRequested_ = false;
+
+	void Decode()
+	{
+		for (;;)
+		{
+			std::unique_ptr<Request> request;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				requestCV_.wait(lock, [this]() { return isQuitRequested_ || !requests_.empty(); });
+				if (isQuitRequested_)
+				{
+					return;
+				}
+
+				request = std::move(requests_.front());
+				requests_.pop_front();
+				decodingRequests_.emplace_back(request.get());
+			}
+
+			if (!request->path.empty())
+			{
+				auto reader = fileInterface_->OpenRead(request->path.c_str());
+				if (reader != nullptr)
+				{
+					request->fileData.resize(reader->GetLength());
+					reader->Read(request->fileData.data(), request->fileData.size());
+				}
+			}
+
+			request->isDecoded = DecodeTexture(request->decoded,
+											   request->fileData.data(),
+											   static_cast<int32_t>(request->fileData.size()),
+											   request->textureType,
+											   request->isMipMapEnabled,
+											   colorSpaceType_);
+
+			// the file is not needed anymore while the request waits for creating
+			request->fileData.clear();
+			request->fileData.shrink_to_fit();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				decodingRequests_.erase(std::find(decodingRequests_.begin(), decodingRequests_.end(), request.get()));
+				decodedRequests_.emplace_back(std::move(request));
+			}
+			decodedCV_.notify_all();
+		}
+	}
+
+	Effekseer::TextureRef Enqueue(std::unique_ptr<Request> request)
+	{
+		auto texture = ::Effekseer::MakeRefPtr<::Effekseer::Texture>();
+		request->texture = texture;
+		pendingCount_++;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			requests_.emplace_back(std::move(request));
+		}
+		requestCV_.notify_one();
+
+		return texture;
+	}
+
+public:
+	StreamingTextureLoaderImplemented(::Effekseer::Backend::GraphicsDeviceRef graphicsDevice,
+									  ::Effekseer::FileInterfaceRef fileInterface,
+									  ::Effekseer::ColorSpaceType colorSpaceType,
+									  int32_t threadCount)
+		: graphicsDevice_(graphicsDevice)
+		, fileInterface_(fileInterface)
+		, colorSpaceType_(colorSpaceType)
+	{
+		if (fileInterface_ == nullptr)
+		{
+			fileInterface_ = Effekseer::MakeRefPtr<Effekseer::DefaultFileInterface>();
+		}
+
+		// the calling thread renders, so it doesn't decode
+		if (threadCount <= 0)
+		{
+			threadCount = std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()) - 1);
+		}
+
+		workerThreads_.resize(threadCount);
+		for (auto& worker : workerThreads_)
+		{
+			worker.Launch();
+			worker.RunAsync([this]() { Decode(); });
+		}
+	}
+
+	~StreamingTextureLoaderImplemented() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isQuitRequested_ = true;
+		}
+		requestCV_.notify_all();
+
+		for (auto& worker : workerThreads_)
+		{
+			worker.WaitForComplete();
+			worker.Shutdown();
+		}
+	}
+
+	Effekseer::TextureRef Load(const char16_t* path, ::Effekseer::TextureType textureType) override
+	{
+		auto request = std::make_unique<Request>();
+		request->textureType = textureType;
+		request->path = path;
+		request->isMipMapEnabled = Effekseer::TextureLoaderHelper::GetIsMipmapEnabled(request->path);
+		return Enqueue(std::move(request));
+	}
+
+	Effekseer::TextureRef Load(const void* data, int32_t size, Effekseer::TextureType textureType, bool isMipMapEnabled) override
+	{
+		auto request = std::make_unique<Request>();
+		request->textureType = textureType;
+		request->isMipMapEnabled = isMipMapEnabled;
+		request->fileData.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+		return Enqueue(std::move(request));
+	}
+
+	void Unload(Effekseer::TextureRef data) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto it = requests_.begin(); it != requests_.end(); it++)
+		{
+			if ((*it)->texture == data)
+			{
+				requests_.erase(it);
+				pendingCount_--;
+				return;
+			}
+		}
+
+		// requests which are decoded now or already are dropped in Update
+		for (auto request : decodingRequests_)
+		{
+			if (request->texture == data)
+			{
+				request->isUnloaded = true;
+				return;
+			}
+		}
+
+		for (auto& request : decodedRequests_)
+		{
+			if (request->texture == data)
+			{
+				request->isUnloaded = true;
+				return;
+			}
+		}
+	}
+
+	int32_t Update(int32_t byteBudget) override
+	{
+		int32_t createdCount = 0;
+		int32_t createdSize = 0;
+
+		for (;;)
+		{
+			if (byteBudget > 0 && createdCount > 0 && createdSize >= byteBudget)
+			{
+				break;
+			}
+
+			std::unique_ptr<Request> request;
+			bool isUnloaded = false;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (decodedRequests_.empty())
+				{
+					break;
+				}
+
+				request = std::move(decodedRequests_.front());
+				decodedRequests_.pop_front();
+				isUnloaded = request->isUnloaded;
+			}
+
+			pendingCount_--;
+
+			if (!request->isDecoded || isUnloaded)
+			{
+				continue;
+			}
+
+			if (CreateDecodedTexture(graphicsDevice_, request->decoded, request->texture) == nullptr)
+			{
+				continue;
+			}
+
+			createdCount++;
+			createdSize += static_cast<int32_t>(request->decoded.data.size());
+		}
+
+		return createdCount;
+	}
+
+	void Flush() override
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			decodedCV_.wait(lock, [this]() { return static_cast<int32_t>(decodedRequests_.size()) == pendingCount_; });
+		}
+
+		Update(0);
+	}
+
+	int32_t GetPendingCount() const override
+	{
+		return pendingCount_;
+	}
+};
+
+#endif
+
+StreamingTextureLoaderRef CreateStreamingTextureLoader(::Effekseer::Backend::GraphicsDeviceRef graphicsDevice,
+													   ::Effekseer::FileInterfaceRef fileInterface,
+													   ::Effekseer::ColorSpaceType colorSpaceType,
+													   int32_t threadCount)
+{
+#ifdef __DISABLED_DEFAULT_TEXTURE_LOADER__
+	return nullptr;
+#else
+	return ::Effekseer::MakeRefPtr<StreamingTextureLoaderImplemented>(graphicsDevice, fileInterface, colorSpaceType, threadCount);
 #endif
+}
 
 } // namespace EffekseerRenderer
@@ -10,6 +10,72 @@ namespace EffekseerRenderer
 												  ::Effekseer::FileInterfaceRef fileInterface = nullptr,
 												  ::Effekseer::ColorSpaceType colorSpaceType = ::Effekseer::ColorSpaceType::Gamma);
 
+/**
+	@brief
+	\~English	A texture loader which reads and decodes textures on worker threads and creates them on GPU in Update
+	\~Japanese	ワーカースレッドでテクスチャを読み込んでデコードし、UpdateでGPU上に生成するテクスチャローダー
+	@note
+	\~English
+	Load returns a texture immediately. Its backend is null until it is created in Update, so it is drawn as no texture until then.
+	Update must be called on a thread which can use the graphics device, for example once per frame before rendering.
+	Files are opened and read with the FileInterface on worker threads, so the FileInterface must be thread safe.
+	If it is not, read files on the calling thread and load them with Load(data, size, ...).
+	\~Japanese
+	Loadはテクスチャを即座に返す。Updateで生成されるまでバックエンドはnullであり、それまではテクスチャ無しとして描画される。
+	Updateはグラフィックスデバイスを使用できるスレッドで、例えば毎フレーム描画前に呼ぶ必要がある。
+	ファイルはワーカースレッドでFileInterfaceにより開かれ読み込まれるため、FileInterfaceはスレッドセーフである必要がある。
+	そうでない場合、呼び出し元のスレッドでファイルを読み込み、Load(data, size, ...)で読み込むこと。
+*/
+class StreamingTextureLoader : public ::Effekseer::TextureLoader
+{
+public:
+	StreamingTextureLoader() = default;
+
+	virtual ~StreamingTextureLoader() override = default;
+
+	/**
+		@brief
+		\~English	Create decoded textures on GPU until the total size of created textures reaches byteBudget
+		\~Japanese	生成されたテクスチャの合計サイズがbyteBudgetに達するまで、デコードされたテクスチャをGPU上に生成する。
+		@param	byteBudget
+		\~English	the size of textures which are created in this call. At least one texture is created. If it is 0 or less, all decoded textures are created.
+		\~Japanese	この呼び出しで生成されるテクスチャのサイズ。少なくとも1つのテクスチャが生成される。0以下の場合、デコードされた全てのテクスチャが生成される。
+		@return
+		\~English	the number of created textures
+		\~Japanese	生成されたテクスチャの数
+	*/
+	virtual int32_t Update(int32_t byteBudget) = 0;
+
+	/**
+		@brief
+		\~English	Wait until all requested textures are decoded and create them on GPU
+		\~Japanese	要求された全てのテクスチャのデコードを待ち、GPU上に生成する。
+	*/
+	virtual void Flush() = 0;
+
+	/**
+		@brief
+		\~English	Get the number of requested textures which are not created yet
+		\~Japanese	要求されたテクスチャのうち、まだ生成されていないものの数を取得する。
+	*/
+	virtual int32_t GetPendingCount() const = 0;
+};
+
+using StreamingTextureLoaderRef = ::Effekseer::RefPtr<StreamingTextureLoader>;
+
+/**
+	@param	fileInterface
+	\~English	an interface to read files on worker threads. It must be thread safe. If it is null, the default one is used.
+	\~Japanese	ワーカースレッドでファイルを読み込むインターフェース。スレッドセーフである必要がある。nullの場合、デフォルトのものが使用される。
+	@param	threadCount
+	\~English	the number of worker threads. If it is 0 or less, the number is decided by the hardware.
+	\~Japanese	ワーカースレッドの数。0以下の場合、ハードウェアに応じて決定される。
+*/
+StreamingTextureLoaderRef CreateStreamingTextureLoader(::Effekseer::Backend::GraphicsDeviceRef graphicsDevice,
+													   ::Effekseer::FileInterfaceRef fileInterface = nullptr,
+													   ::Effekseer::ColorSpaceType colorSpaceType = ::Effekseer::ColorSpaceType::Gamma,
+													   int32_t threadCount = 0);
+
 } // namespace EffekseerRenderer
 
 #endif // __EFFEKSEERRENDERER_TEXTURELOADER_H__
@@ -510,6 +510,7 @@ bool RendererImplemented::EndRendering()
 
 	// reset a renderer
 	m_standardRenderer->ResetAndRenderingIfRequired();
+	m_standardRenderer->ClearStates();
 
 	// restore states
 	if (m_restorationOfStates)
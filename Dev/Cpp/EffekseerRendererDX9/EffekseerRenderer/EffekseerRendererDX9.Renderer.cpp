@@ -452,6 +452,7 @@ bool RendererImplemented::EndRendering()
 {
 	// レンダラーリセット
 	m_standardRenderer->ResetAndRenderingIfRequired();
+	m_standardRenderer->ClearStates();
 
 	// ステートを復元する
 	if (m_restorationOfStates)
@@ -18,6 +18,11 @@ public:
 	DeviceObject(Backend::GraphicsDevice* graphicsDevice);
 	virtual ~DeviceObject();
 
+	Backend::GraphicsDevice* GetGraphicsDevice() const
+	{
+		return graphicsDevice_;
+	}
+
 public:
 	virtual void OnLostDevice() = 0;
 	virtual void OnResetDevice() = 0;
@@ -89,6 +89,18 @@ typedef void(EFK_STDCALL* FP_glDrawElementsInstanced)(GLenum mode,
 													  const void* indices,
 													  GLsizei primcount);
 
+typedef void(EFK_STDCALL* FP_glVertexAttribDivisor)(GLuint index, GLuint divisor);
+
+typedef void(EFK_STDCALL* FP_glDrawElementsBaseVertex)(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex);
+
+typedef void*(EFK_STDCALL* FP_glFenceSync)(GLenum condition, GLbitfield flags);
+typedef void(EFK_STDCALL* FP_glDeleteSync)(void* sync);
+typedef GLenum(EFK_STDCALL* FP_glClientWaitSync)(void* sync, GLbitfield flags, uint64_t timeout);
+
+typedef void(EFK_STDCALL* FP_glGetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void(EFK_STDCALL* FP_glProgramBinary)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void(EFK_STDCALL* FP_glProgramParameteri)(GLuint program, GLenum pname, GLint value);
+
 typedef void(EFK_STDCALL* FP_glCompressedTexImage2D)(
 	GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data);
 
@@ -180,6 +192,18 @@ static FP_glUnmapBuffer g_glUnmapBuffer = nullptr;
 
 static FP_glDrawElementsInstanced g_glDrawElementsInstanced = nullptr;
 
+static FP_glVertexAttribDivisor g_glVertexAttribDivisor = nullptr;
+
+static FP_glDrawElementsBaseVertex g_glDrawElementsBaseVertex = nullptr;
+
+static FP_glFenceSync g_glFenceSync = nullptr;
+static FP_glDeleteSync g_glDeleteSync = nullptr;
+static FP_glClientWaitSync g_glClientWaitSync = nullptr;
+
+static FP_glGetProgramBinary g_glGetProgramBinary = nullptr;
+static FP_glProgramBinary g_glProgramBinary = nullptr;
+static FP_glProgramParameteri g_glProgramParameteri = nullptr;
+
 static FP_glCompressedTexImage2D g_glCompressedTexImage2D = nullptr;
 
 static FP_glGenFramebuffers g_glGenFramebuffers = nullptr;
@@ -221,6 +245,8 @@ typedef void(EFK_STDCALL* FP_glDrawElementsInstancedANGLE)(GLenum mode,
 														   const void* indices,
 														   GLsizei primcount);
 
+typedef void(EFK_STDCALL* FP_glVertexAttribDivisorANGLE)(GLuint index, GLuint divisor);
+
 #endif
 
 static FP_glGenVertexArraysOES g_glGenVertexArraysOES = nullptr;
@@ -233,6 +259,7 @@ static FP_glUnmapBufferOES g_glUnmapBufferOES = nullptr;
 
 #ifdef __EMSCRIPTEN__
 static FP_glDrawElementsInstancedANGLE g_glDrawElementsInstancedANGLE = nullptr;
+static FP_glVertexAttribDivisorANGLE g_glVertexAttribDivisorANGLE = nullptr;
 #endif
 
 #endif
@@ -264,6 +291,9 @@ static bool g_isSupportedVertexArray = false;
 static bool g_isSurrpotedBufferRange = false;
 static bool g_isSurrpotedMapBuffer = false;
 static bool g_isSupportedQueries = false;
+static bool g_isSupportedSync = false;
+static bool g_isSupportedProgramBinary = false;
+static bool g_isSupportedDrawBaseVertex = false;
 static OpenGLDeviceType g_deviceType = OpenGLDeviceType::OpenGL2;
 
 #if _WIN32
@@ -385,6 +415,18 @@ bool Initialize(OpenGLDeviceType deviceType, bool isExtensionsEnabled)
 
 	GET_PROC_REQ(glDrawElementsInstanced);
 
+	GET_PROC(glVertexAttribDivisor);
+
+	GET_PROC(glDrawElementsBaseVertex);
+
+	GET_PROC(glFenceSync);
+	GET_PROC(glDeleteSync);
+	GET_PROC(glClientWaitSync);
+
+	GET_PROC(glGetProgramBinary);
+	GET_PROC(glProgramBinary);
+	GET_PROC(glProgramParameteri);
+
 	GET_PROC_REQ(glCompressedTexImage2D);
 
 	GET_PROC_REQ(glGenFramebuffers);
@@ -412,6 +454,9 @@ bool Initialize(OpenGLDeviceType deviceType, bool isExtensionsEnabled)
 	g_isSupportedVertexArray = (g_glGenVertexArrays && g_glDeleteVertexArrays && g_glBindVertexArray);
 	g_isSurrpotedBufferRange = (g_glMapBufferRange && g_glUnmapBuffer);
 	g_isSurrpotedMapBuffer = (g_glMapBuffer && g_glUnmapBuffer);
+	g_isSupportedSync = (g_glFenceSync && g_glDeleteSync && g_glClientWaitSync);
+	g_isSupportedProgramBinary = (g_glGetProgramBinary && g_glProgramBinary && g_glProgramParameteri);
+	g_isSupportedDrawBaseVertex = g_glDrawElementsBaseVertex != nullptr;
 #endif
 
 #if defined(_WIN32) || defined(__EFFEKSEER_RENDERER_GL__) || defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GLES3__)
@@ -457,6 +502,7 @@ bool Initialize(OpenGLDeviceType deviceType, bool isExtensionsEnabled)
 	if (isExtensionsEnabled)
 	{
 		GET_PROC(glDrawElementsInstancedANGLE);
+		GET_PROC(glVertexAttribDivisorANGLE);
 	}
 
 	g_isSupportedVertexArray = (g_glGenVertexArraysOES && g_glDeleteVertexArraysOES && g_glBindVertexArrayOES &&
@@ -497,8 +543,42 @@ bool Initialize(OpenGLDeviceType deviceType, bool isExtensionsEnabled)
 		g_isSurrpotedMapBuffer = true;
 	}
 
+#if !defined(_WIN32) && !defined(__EFFEKSEER_RENDERER_GL2__) && !defined(__EMSCRIPTEN__)
+	if (deviceType == OpenGLDeviceType::OpenGL3 || deviceType == OpenGLDeviceType::OpenGLES3)
+	{
+		g_isSupportedSync = true;
+		g_isSupportedProgramBinary = true;
+	}
+#endif
+
+#if !defined(_WIN32) && !defined(__EFFEKSEER_RENDERER_GL2__) && !defined(__EFFEKSEER_RENDERER_GLES3__) && !defined(__EMSCRIPTEN__)
+	// glDrawElementsBaseVertex is a core function since OpenGL 3.2
+	if (deviceType == OpenGLDeviceType::OpenGL3)
+	{
+		GLint majorVersion = 0;
+		GLint minorVersion = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+		glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+		g_isSupportedDrawBaseVertex = majorVersion > 3 || (majorVersion == 3 && minorVersion >= 2);
+	}
 #endif
 
+#endif
+
+	// a driver may support no binary format
+	if (g_isSupportedProgramBinary)
+	{
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		g_isSupportedProgramBinary = formatCount > 0;
+
+		if (!g_isSupportedProgramBinary)
+		{
+			// discard GL_INVALID_ENUM on old drivers
+			glGetError();
+		}
+	}
+
 	g_isInitialized = true;
 	return true;
 }
@@ -523,6 +603,36 @@ bool IsSupportedQueries()
 	return g_isSupportedQueries;
 }
 
+bool IsSupportedVertexAttribDivisor()
+{
+#if _WIN32
+	return g_glVertexAttribDivisor != nullptr;
+#elif defined(__EFFEKSEER_RENDERER_GLES2__)
+
+#ifdef __EMSCRIPTEN__
+	return g_glVertexAttribDivisorANGLE != nullptr;
+#endif
+	return false;
+#else
+	return true;
+#endif
+}
+
+bool IsSupportedSync()
+{
+	return g_isSupportedSync;
+}
+
+bool IsSupportedProgramBinary()
+{
+	return g_isSupportedProgramBinary;
+}
+
+bool IsSupportedDrawBaseVertex()
+{
+	return g_isSupportedDrawBaseVertex;
+}
+
 void MakeMapBufferInvalid()
 {
 	g_isSurrpotedMapBuffer = false;
@@ -946,6 +1056,101 @@ void glDrawElementsInstanced(GLenum mode,
 #endif
 }
 
+void glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+#if _WIN32
+	g_glVertexAttribDivisor(index, divisor);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__)
+
+#ifdef __EMSCRIPTEN__
+	g_glVertexAttribDivisorANGLE(index, divisor);
+#endif
+	return;
+#else
+	::glVertexAttribDivisor(index, divisor);
+#endif
+}
+
+void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+#if _WIN32
+	g_glDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GLES3__) || defined(__EFFEKSEER_RENDERER_GL2__) || defined(__EMSCRIPTEN__)
+	return;
+#else
+	::glDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+#endif
+}
+
+void* glFenceSync(GLenum condition, GLbitfield flags)
+{
+#if _WIN32
+	return g_glFenceSync(condition, flags);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GL2__) || defined(__EMSCRIPTEN__)
+	return nullptr;
+#else
+	return reinterpret_cast<void*>(::glFenceSync(condition, flags));
+#endif
+}
+
+void glDeleteSync(void* sync)
+{
+#if _WIN32
+	g_glDeleteSync(sync);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GL2__) || defined(__EMSCRIPTEN__)
+	return;
+#else
+	::glDeleteSync(reinterpret_cast<GLsync>(sync));
+#endif
+}
+
+GLenum glClientWaitSync(void* sync, GLbitfield flags, uint64_t timeout)
+{
+#if _WIN32
+	return g_glClientWaitSync(sync, flags, timeout);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GL2__) || defined(__EMSCRIPTEN__)
+	return GL_WAIT_FAILED;
+#else
+	return ::glClientWaitSync(reinterpret_cast<GLsync>(sync), flags, timeout);
+#endif
+}
+
+void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary)
+{
+#if _WIN32
+	g_glGetProgramBinary(program, bufSize, length, binaryFormat, binary);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GL2__) || defined(__EMSCRIPTEN__)
+	if (length != nullptr)
+	{
+		*length = 0;
+	}
+#else
+	::glGetProgramBinary(program, bufSize, length, binaryFormat, binary);
+#endif
+}
+
+void glProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)
+{
+#if _WIN32
+	g_glProgramBinary(program, binaryFormat, binary, length);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GL2__) || defined(__EMSCRIPTEN__)
+	return;
+#else
+	::glProgramBinary(program, binaryFormat, binary, length);
+#endif
+}
+
+void glProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+#if _WIN32
+	g_glProgramParameteri(program, pname, value);
+#elif defined(__EFFEKSEER_RENDERER_GLES2__) || defined(__EFFEKSEER_RENDERER_GL2__) || defined(__EMSCRIPTEN__)
+	return;
+#else
+	::glProgramParameteri(program, pname, value);
+#endif
+}
+
 void glCompressedTexImage2D(
 	GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
 {
@@ -184,6 +184,21 @@ typedef char GLchar;
 #define GL_QUERY_RESULT           0x8866
 #define GL_QUERY_RESULT_AVAILABLE 0x8867
 
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+#endif
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
 namespace EffekseerRendererGL
 {
 namespace GLExt
@@ -195,6 +210,10 @@ bool IsSupportedVertexArray();
 bool IsSupportedBufferRange();
 bool IsSupportedMapBuffer();
 bool IsSupportedQueries();
+bool IsSupportedVertexAttribDivisor();
+bool IsSupportedSync();
+bool IsSupportedProgramBinary();
+bool IsSupportedDrawBaseVertex();
 
 //! for some devices to avoid a bug
 void MakeMapBufferInvalid();
@@ -250,6 +269,19 @@ void glDrawElementsInstanced(GLenum mode,
 							 const void* indices,
 							 GLsizei primcount);
 
+void glVertexAttribDivisor(GLuint index, GLuint divisor);
+
+void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex);
+
+//! a sync object is passed as a pointer because GLsync is not defined on some platforms
+void* glFenceSync(GLenum condition, GLbitfield flags);
+void glDeleteSync(void* sync);
+GLenum glClientWaitSync(void* sync, GLbitfield flags, uint64_t timeout);
+
+void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+void glProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+void glProgramParameteri(GLuint program, GLenum pname, GLint value);
+
 void glCompressedTexImage2D(
 	GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data);
 
@@ -20,6 +20,7 @@
 
 #include "ShaderHeader/model_distortion_ps.h"
 #include "ShaderHeader/model_distortion_vs.h"
+#include "ShaderHeader/model_instanced_unlit_vs.h"
 #include "ShaderHeader/model_lit_ps.h"
 #include "ShaderHeader/model_lit_vs.h"
 #include "ShaderHeader/model_unlit_ps.h"
@@ -116,6 +117,38 @@ void ModelRenderer::InitRenderer()
 	}
 }
 
+void ModelRenderer::InitInstanceBufferShader()
+{
+	// instance buffers require attribute divisors which are supported since OpenGL 3.3 and OpenGL ES 3.0
+	if (!GLExt::IsSupportedVertexAttribDivisor())
+	{
+		return;
+	}
+
+	ShaderCodeView vs(get_model_instanced_unlit_vs(m_renderer->GetDeviceType()));
+	ShaderCodeView ps(get_model_unlit_ps(m_renderer->GetDeviceType()));
+
+	// a vertex constant buffer is shared with the other shaders but matrices, UVs and colors in it are not used
+	Effekseer::CustomVector<Effekseer::Backend::UniformLayoutElement> uniformLayoutElements;
+	AddModelVertexUniformLayout(uniformLayoutElements, false, true, InstanceCount);
+	AddPixelUniformLayout(uniformLayoutElements);
+
+	auto uniformLayout = Effekseer::MakeRefPtr<Effekseer::Backend::UniformLayout>(GetTextureLocations(EffekseerRenderer::RendererShaderType::Unlit), uniformLayoutElements);
+	auto shader = graphicsDevice_->CreateShaderFromCodes({vs}, {ps}, uniformLayout).DownCast<Backend::Shader>();
+
+	shader_unlit_instance_buffer_ = Shader::Create(graphicsDevice_, shader, "ModelRendererUnlitInstanceBuffer");
+	if (shader_unlit_instance_buffer_ == nullptr)
+	{
+		return;
+	}
+
+	shader_unlit_instance_buffer_->SetVertexLayout(EffekseerRenderer::GetModelRendererVertexLayout(graphicsDevice_).DownCast<Backend::VertexLayout>());
+	shader_unlit_instance_buffer_->SetInstanceVertexLayout(EffekseerRenderer::GetModelRendererInstanceVertexLayout(graphicsDevice_).DownCast<Backend::VertexLayout>());
+	shader_unlit_instance_buffer_->SetVertexConstantBufferSize(sizeof(::EffekseerRenderer::ModelRendererVertexConstantBuffer<InstanceCount>));
+	shader_unlit_instance_buffer_->SetPixelConstantBufferSize(sizeof(::EffekseerRenderer::PixelConstantBuffer));
+	shader_unlit_instance_buffer_->SetIsTransposeEnabled(true);
+}
+
 ModelRenderer::ModelRenderer(RendererImplemented* renderer,
 							 Shader* shader_ad_lit,
 							 Shader* shader_ad_unlit,
@@ -136,6 +169,7 @@ ModelRenderer::ModelRenderer(RendererImplemented* renderer,
 	{
 		VertexType = EffekseerRenderer::ModelRendererVertexType::Instancing;
 		InitRenderer<InstanceCount>();
+		InitInstanceBufferShader();
 	}
 	else
 	{
@@ -155,6 +189,8 @@ ModelRenderer::~ModelRenderer()
 	ES_SAFE_DELETE(shader_ad_unlit_);
 	ES_SAFE_DELETE(shader_ad_lit_);
 	ES_SAFE_DELETE(shader_ad_distortion_);
+
+	ES_SAFE_DELETE(shader_unlit_instance_buffer_);
 }
 
 //----------------------------------------------------------------------------------
@@ -337,7 +373,7 @@ void ModelRenderer::EndRendering(const efkModelNodeParam& parameter, void* userD
 	if (VertexType == EffekseerRenderer::ModelRendererVertexType::Instancing)
 	{
 		EndRendering_<RendererImplemented, Shader, Effekseer::Model, true, InstanceCount>(
-			m_renderer, shader_ad_lit_, shader_ad_unlit_, shader_ad_distortion_, shader_lit_, shader_unlit_, shader_distortion_, parameter, userData);
+			m_renderer, shader_ad_lit_, shader_ad_unlit_, shader_ad_distortion_, shader_lit_, shader_unlit_, shader_distortion_, parameter, userData, shader_unlit_instance_buffer_);
 	}
 	else
 	{
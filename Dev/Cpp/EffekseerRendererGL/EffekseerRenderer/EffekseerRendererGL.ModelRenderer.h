@@ -46,11 +46,16 @@ private:
 	Shader* shader_unlit_ = nullptr;
 	Shader* shader_distortion_ = nullptr;
 
+	//! a shader which reads matrices, UVs and colors of instances from a vertex buffer
+	Shader* shader_unlit_instance_buffer_ = nullptr;
+
 	Backend::GraphicsDeviceRef graphicsDevice_ = nullptr;
 
 	template <int N>
 	void InitRenderer();
 
+	void InitInstanceBufferShader();
+
 	ModelRenderer(RendererImplemented* renderer,
 				  Shader* shader_ad_lit,
 				  Shader* shader_ad_unlit,
@@ -41,6 +41,11 @@ RenderState::~RenderState()
 {
 	if (m_renderer->GetDeviceType() == OpenGLDeviceType::OpenGL3 || m_renderer->GetDeviceType() == OpenGLDeviceType::OpenGLES3)
 	{
+		for (auto sampler : m_samplers)
+		{
+			m_renderer->GetInternalGraphicsDevice()->GetStateCache().OnSamplerDeleted(sampler);
+		}
+
 		GLExt::glDeleteSamplers(Effekseer::TextureSlotMax, m_samplers.data());
 	}
 }
@@ -52,23 +57,19 @@ void RenderState::Update(bool forced)
 {
 	GLCheckError();
 
+	// calls are skipped by the cache if states are not changed actually
+	auto& stateCache = m_renderer->GetInternalGraphicsDevice()->GetStateCache();
+
 	if (m_active.DepthTest != m_next.DepthTest || forced)
 	{
-		if (m_next.DepthTest)
-		{
-			glEnable(GL_DEPTH_TEST);
-		}
-		else
-		{
-			glDisable(GL_DEPTH_TEST);
-		}
+		stateCache.SetEnabled(GL_DEPTH_TEST, m_next.DepthTest);
 	}
 
 	GLCheckError();
 
 	if (m_active.DepthWrite != m_next.DepthWrite || forced)
 	{
-		glDepthMask(m_next.DepthWrite);
+		stateCache.DepthMask(m_next.DepthWrite);
 	}
 
 	GLCheckError();
@@ -79,36 +80,36 @@ void RenderState::Update(bool forced)
 		{
 			if (m_next.CullingType == Effekseer::CullingType::Front)
 			{
-				glEnable(GL_CULL_FACE);
-				glCullFace(GL_FRONT);
+				stateCache.SetEnabled(GL_CULL_FACE, true);
+				stateCache.CullFace(GL_FRONT);
 			}
 			else if (m_next.CullingType == Effekseer::CullingType::Back)
 			{
-				glEnable(GL_CULL_FACE);
-				glCullFace(GL_BACK);
+				stateCache.SetEnabled(GL_CULL_FACE, true);
+				stateCache.CullFace(GL_BACK);
 			}
 			else if (m_next.CullingType == Effekseer::CullingType::Double)
 			{
-				glDisable(GL_CULL_FACE);
-				glCullFace(GL_FRONT_AND_BACK);
+				stateCache.SetEnabled(GL_CULL_FACE, false);
+				stateCache.CullFace(GL_FRONT_AND_BACK);
 			}
 		}
 		else
 		{
 			if (m_next.CullingType == Effekseer::CullingType::Front)
 			{
-				glEnable(GL_CULL_FACE);
-				glCullFace(GL_BACK);
+				stateCache.SetEnabled(GL_CULL_FACE, true);
+				stateCache.CullFace(GL_BACK);
 			}
 			else if (m_next.CullingType == Effekseer::CullingType::Back)
 			{
-				glEnable(GL_CULL_FACE);
-				glCullFace(GL_FRONT);
+				stateCache.SetEnabled(GL_CULL_FACE, true);
+				stateCache.CullFace(GL_FRONT);
 			}
 			else if (m_next.CullingType == Effekseer::CullingType::Double)
 			{
-				glDisable(GL_CULL_FACE);
-				glCullFace(GL_FRONT_AND_BACK);
+				stateCache.SetEnabled(GL_CULL_FACE, false);
+				stateCache.CullFace(GL_FRONT_AND_BACK);
 			}
 		}
 	}
@@ -118,46 +119,46 @@ void RenderState::Update(bool forced)
 	if (m_active.AlphaBlend != m_next.AlphaBlend || forced)
 	{
 		{
-			glEnable(GL_BLEND);
+			stateCache.SetEnabled(GL_BLEND, true);
 
 			if (m_next.AlphaBlend == ::Effekseer::AlphaBlendType::Opacity)
 			{
-				GLExt::glBlendEquationSeparate(GL_FUNC_ADD, GL_MAX);
-				GLExt::glBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ONE);
+				stateCache.BlendEquationSeparate(GL_FUNC_ADD, GL_MAX);
+				stateCache.BlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ONE);
 			}
 			else if (m_next.AlphaBlend == ::Effekseer::AlphaBlendType::Sub)
 			{
-				GLExt::glBlendEquationSeparate(GL_FUNC_REVERSE_SUBTRACT, GL_FUNC_ADD);
-				GLExt::glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE);
+				stateCache.BlendEquationSeparate(GL_FUNC_REVERSE_SUBTRACT, GL_FUNC_ADD);
+				stateCache.BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE);
 			}
 			else
 			{
-				GLExt::glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+				stateCache.BlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
 				if (m_next.AlphaBlend == ::Effekseer::AlphaBlendType::Blend)
 				{
 					if (m_renderer->GetImpl()->IsPremultipliedAlphaEnabled)
 					{
-						GLExt::glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+						stateCache.BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 					}
 					else
 					{
-						GLExt::glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE);
+						stateCache.BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE);
 					}
 				}
 				else if (m_next.AlphaBlend == ::Effekseer::AlphaBlendType::Add)
 				{
 					if (m_renderer->GetImpl()->IsPremultipliedAlphaEnabled)
 					{
-						GLExt::glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE);
+						stateCache.BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE);
 					}
 					else
 					{
-						GLExt::glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ONE);
+						stateCache.BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ONE);
 					}
 				}
 				else if (m_next.AlphaBlend == ::Effekseer::AlphaBlendType::Mul)
 				{
-					GLExt::glBlendFuncSeparate(GL_ZERO, GL_SRC_COLOR, GL_ZERO, GL_ONE);
+					stateCache.BlendFuncSeparate(GL_ZERO, GL_SRC_COLOR, GL_ZERO, GL_ONE);
 				}
 			}
 		}
@@ -170,115 +171,32 @@ void RenderState::Update(bool forced)
 	static const GLint glfilterMag[] = {GL_NEAREST, GL_LINEAR};
 	static const GLint glwrap[] = {GL_REPEAT, GL_CLAMP_TO_EDGE};
 
-	if (m_renderer->GetDeviceType() == OpenGLDeviceType::OpenGL3 || m_renderer->GetDeviceType() == OpenGLDeviceType::OpenGLES3)
-	{
-		for (int32_t i = 0; i < (int32_t)m_renderer->GetCurrentTextures().size(); i++)
-		{
-			// If a texture is not assigned, skip it.
-			const auto& texture = m_renderer->GetCurrentTextures()[i];
-			if (texture == nullptr)
-				continue;
-
-			if (m_active.TextureFilterTypes[i] != m_next.TextureFilterTypes[i] || forced || m_active.TextureIDs[i] != m_next.TextureIDs[i])
-			{
-				GLExt::glActiveTexture(GL_TEXTURE0 + i);
-
-				// for webngl
-#ifndef NDEBUG
-				// GLint bound = 0;
-				// glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
-				// assert(bound > 0);
-#endif
-
-				int32_t filter_ = (int32_t)m_next.TextureFilterTypes[i];
-
-				GLExt::glSamplerParameteri(m_samplers[i], GL_TEXTURE_MAG_FILTER, glfilterMag[filter_]);
-
-				if (texture->GetParameter().MipLevelCount != 1)
-				{
-					GLExt::glSamplerParameteri(m_samplers[i], GL_TEXTURE_MIN_FILTER, glfilterMin[filter_]);
-				}
-				else
-				{
-					GLExt::glSamplerParameteri(m_samplers[i], GL_TEXTURE_MIN_FILTER, glfilterMin_NoneMipmap[filter_]);
-				}
-
-				// glSamplerParameteri( m_samplers[i],  GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-				// glSamplerParameteri( m_samplers[i],  GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-
-				GLExt::glBindSampler(i, m_samplers[i]);
-			}
+	const bool isSamplerEnabled = m_renderer->GetDeviceType() == OpenGLDeviceType::OpenGL3 || m_renderer->GetDeviceType() == OpenGLDeviceType::OpenGLES3;
 
-			if (m_active.TextureWrapTypes[i] != m_next.TextureWrapTypes[i] || forced || m_active.TextureIDs[i] != m_next.TextureIDs[i])
-			{
-				GLExt::glActiveTexture(GL_TEXTURE0 + i);
+	for (int32_t i = 0; i < (int32_t)m_renderer->GetCurrentTextures().size(); i++)
+	{
+		// If a texture is not assigned, skip it.
+		const auto& texture = m_renderer->GetCurrentTextures()[i];
+		if (texture == nullptr)
+			continue;
 
-				int32_t wrap_ = (int32_t)m_next.TextureWrapTypes[i];
-				GLExt::glSamplerParameteri(m_samplers[i], GL_TEXTURE_WRAP_S, glwrap[wrap_]);
-				GLExt::glSamplerParameteri(m_samplers[i], GL_TEXTURE_WRAP_T, glwrap[wrap_]);
+		const int32_t filter_ = (int32_t)m_next.TextureFilterTypes[i];
+		const int32_t wrap_ = (int32_t)m_next.TextureWrapTypes[i];
+		const GLint filterMin = texture->GetParameter().MipLevelCount != 1 ? glfilterMin[filter_] : glfilterMin_NoneMipmap[filter_];
 
-				GLExt::glBindSampler(i, m_samplers[i]);
-			}
+		if (isSamplerEnabled)
+		{
+			stateCache.SetSamplerParameters(m_samplers[i], filterMin, glfilterMag[filter_], glwrap[wrap_]);
+			stateCache.BindSampler(i, m_samplers[i]);
 		}
-	}
-	else
-	{
-		GLCheckError();
-		for (int32_t i = 0; i < (int32_t)m_renderer->GetCurrentTextures().size(); i++)
+		else
 		{
-			// If a texture is not assigned, skip it.
-			const auto& texture = m_renderer->GetCurrentTextures()[i];
-			if (texture == nullptr)
-				continue;
-
-			// always changes because a flag is assigned into a texture
-			// if (m_active.TextureFilterTypes[i] != m_next.TextureFilterTypes[i] || forced)
-			{
-				GLExt::glActiveTexture(GL_TEXTURE0 + i);
-				GLCheckError();
-
-				// for webngl
-#ifndef NDEBUG
-				GLint bound = 0;
-				glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
-				assert(bound > 0);
-#endif
-
-				int32_t filter_ = (int32_t)m_next.TextureFilterTypes[i];
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glfilterMag[filter_]);
-				GLCheckError();
-
-				if (texture->GetParameter().MipLevelCount != 1)
-				{
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glfilterMin[filter_]);
-				}
-				else
-				{
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glfilterMin_NoneMipmap[filter_]);
-				}
-			}
-
-			// always changes because a flag is assigned into a texture
-			// if (m_active.TextureWrapTypes[i] != m_next.TextureWrapTypes[i] || forced)
-			{
-				GLExt::glActiveTexture(GL_TEXTURE0 + i);
-				GLCheckError();
-
-				int32_t wrap_ = (int32_t)m_next.TextureWrapTypes[i];
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, glwrap[wrap_]);
-				GLCheckError();
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, glwrap[wrap_]);
-				GLCheckError();
-			}
+			// parameters are cached per texture because they are assigned into a texture
+			const auto textureGL = static_cast<Backend::Texture*>(texture.Get());
+			stateCache.SetTextureParameters(i, GL_TEXTURE_2D, textureGL->GetBuffer(), filterMin, glfilterMag[filter_], glwrap[wrap_]);
 		}
-		GLCheckError();
 	}
 
-	GLExt::glActiveTexture(GL_TEXTURE0);
-
 	m_active = m_next;
 
 	GLCheckError();
@@ -35,6 +35,7 @@
 #include "ShaderHeader/model_unlit_ps.h"
 #include "ShaderHeader/sprite_distortion_vs.h"
 #include "ShaderHeader/sprite_lit_vs.h"
+#include "ShaderHeader/sprite_instanced_unlit_vs.h"
 #include "ShaderHeader/sprite_unlit_vs.h"
 
 #include "GraphicsDevice.h"
@@ -72,6 +73,12 @@ Effekseer::Backend::TextureRef CreateTexture(Effekseer::Backend::GraphicsDeviceR
 	return gd->CreateTexture(buffer, hasMipmap, onDisposed);
 }
 
+void SetProgramBinaryCacheDirectory(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, const char16_t* directory, ::Effekseer::FileInterfaceRef fileInterface)
+{
+	auto gd = graphicsDevice.DownCast<Backend::GraphicsDevice>();
+	gd->SetProgramBinaryCacheDirectory(directory, fileInterface);
+}
+
 TextureProperty GetTextureProperty(::Effekseer::Backend::TextureRef texture)
 {
 	if (texture != nullptr)
@@ -118,6 +125,12 @@ RendererRef Renderer::Create(Effekseer::Backend::GraphicsDeviceRef graphicsDevic
 
 int32_t RendererImplemented::GetIndexSpriteCount() const
 {
+	// indices are shared by all draws which start from any vertex
+	if (isBaseVertexEnabled_)
+	{
+		return m_squareMaxCount;
+	}
+
 	int vsSize = EffekseerRenderer::GetMaximumVertexSizeInAllTypes() * m_squareMaxCount * 4;
 
 	size_t size = sizeof(EffekseerRenderer::SimpleVertex);
@@ -167,6 +180,16 @@ RendererImplemented::~RendererImplemented()
 	ES_SAFE_DELETE(shader_ad_lit_);
 	ES_SAFE_DELETE(shader_ad_distortion_);
 
+	ES_SAFE_DELETE(shader_unlit_compact_);
+	ES_SAFE_DELETE(shader_distortion_compact_);
+	ES_SAFE_DELETE(shader_lit_compact_);
+	ES_SAFE_DELETE(shader_ad_unlit_compact_);
+	ES_SAFE_DELETE(shader_ad_lit_compact_);
+	ES_SAFE_DELETE(shader_ad_distortion_compact_);
+	ES_SAFE_DELETE(shader_instanced_sprite_);
+
+	modelInstanceBuffer_.Reset();
+
 	ES_SAFE_DELETE(m_renderState);
 
 	// NOTE : It is better to reset on a same context where Rendering method runs
@@ -232,11 +255,6 @@ bool RendererImplemented::Initialize()
 		}
 	}
 
-	if (GetIndexSpriteCount() * 4 > 65536)
-	{
-		indexBufferStride_ = Effekseer::Backend::IndexBufferStrideType::Stride4;
-	}
-
 	GLCheckError();
 
 	m_renderState = new RenderState(this);
@@ -366,6 +384,8 @@ bool RendererImplemented::Initialize()
 		shader->SetPixelConstantBufferSize(sizeof(EffekseerRenderer::PixelConstantBuffer));
 	}
 
+	isBaseVertexEnabled_ = GLExt::IsSupportedDrawBaseVertex();
+
 	SetSquareMaxCount(m_squareMaxCount);
 
 	m_standardRenderer =
@@ -387,6 +407,74 @@ bool RendererImplemented::Initialize()
 		shader_ad_distortion_->SetIsTransposeEnabled(true);
 	}
 
+	// Half float attributes are supported since OpenGL 3.0 and OpenGL ES 3.0
+	if (GetDeviceType() == OpenGLDeviceType::OpenGL3 || GetDeviceType() == OpenGLDeviceType::OpenGLES3)
+	{
+		const auto createCompact = [this](const Backend::ShaderRef& backendShader, EffekseerRenderer::RendererShaderType type, const char* name, int32_t pixelBufferSize) -> Shader* {
+			auto shader = Shader::Create(GetInternalGraphicsDevice(), backendShader, name);
+			if (shader == nullptr)
+			{
+				return nullptr;
+			}
+
+			shader->SetVertexLayout(EffekseerRenderer::GetCompactVertexLayout(graphicsDevice_, type).DownCast<Backend::VertexLayout>());
+			shader->SetVertexConstantBufferSize(sizeof(EffekseerRenderer::StandardRendererVertexBuffer));
+			shader->SetPixelConstantBufferSize(pixelBufferSize);
+			shader->SetIsTransposeEnabled(true);
+			return shader;
+		};
+
+		shader_unlit_compact_ = createCompact(shader_unlit, EffekseerRenderer::RendererShaderType::Unlit, "UnlitCompact", sizeof(EffekseerRenderer::PixelConstantBuffer));
+		shader_lit_compact_ = createCompact(shader_lit, EffekseerRenderer::RendererShaderType::Lit, "LitCompact", sizeof(EffekseerRenderer::PixelConstantBuffer));
+		shader_distortion_compact_ = createCompact(shader_distortion, EffekseerRenderer::RendererShaderType::BackDistortion, "DistCompact", sizeof(EffekseerRenderer::PixelConstantBufferDistortion));
+		shader_ad_unlit_compact_ = createCompact(shader_unlit_ad, EffekseerRenderer::RendererShaderType::AdvancedUnlit, "UnlitAdCompact", sizeof(EffekseerRenderer::PixelConstantBuffer));
+		shader_ad_lit_compact_ = createCompact(shader_lit_ad, EffekseerRenderer::RendererShaderType::AdvancedLit, "LitAdCompact", sizeof(EffekseerRenderer::PixelConstantBuffer));
+		shader_ad_distortion_compact_ = createCompact(shader_distortion_ad, EffekseerRenderer::RendererShaderType::AdvancedBackDistortion, "DistAdCompact", sizeof(EffekseerRenderer::PixelConstantBufferDistortion));
+
+		GetImpl()->isCompactVertexSupported =
+			shader_unlit_compact_ != nullptr && shader_lit_compact_ != nullptr && shader_distortion_compact_ != nullptr &&
+			shader_ad_unlit_compact_ != nullptr && shader_ad_lit_compact_ != nullptr && shader_ad_distortion_compact_ != nullptr;
+	}
+
+	// Instanced sprites require gl_VertexID and attribute divisors
+	if ((GetDeviceType() == OpenGLDeviceType::OpenGL3 || GetDeviceType() == OpenGLDeviceType::OpenGLES3) && GLExt::IsSupportedVertexAttribDivisor())
+	{
+		using Effekseer::Backend::ShaderStageType;
+		using Effekseer::Backend::UniformBufferLayoutElementType;
+		using Effekseer::Backend::UniformLayoutElement;
+
+		Effekseer::CustomVector<UniformLayoutElement> uniformLayoutElementsInstanced;
+		AddVertexUniformLayout(uniformLayoutElementsInstanced);
+
+		const int32_t billboardOffset = sizeof(EffekseerRenderer::StandardRendererVertexBuffer);
+		uniformLayoutElementsInstanced.emplace_back(UniformLayoutElement{ShaderStageType::Vertex, "CBVS0.mBillboardRight", UniformBufferLayoutElementType::Vector4, 1, billboardOffset});
+		uniformLayoutElementsInstanced.emplace_back(UniformLayoutElement{ShaderStageType::Vertex, "CBVS0.mBillboardUp", UniformBufferLayoutElementType::Vector4, 1, billboardOffset + static_cast<int32_t>(sizeof(float[4]))});
+		AddPixelUniformLayout(uniformLayoutElementsInstanced);
+
+		ShaderCodeView instanced_vs(get_sprite_instanced_unlit_vs(GetDeviceType()));
+		auto uniformLayoutInstanced = Effekseer::MakeRefPtr<Effekseer::Backend::UniformLayout>(texLocUnlit, uniformLayoutElementsInstanced);
+		auto shader_instanced = graphicsDevice_->CreateShaderFromCodes({instanced_vs}, {unlit_ps}, uniformLayoutInstanced).DownCast<Backend::Shader>();
+
+		if (shader_instanced != nullptr)
+		{
+			shader_instanced_sprite_ = Shader::Create(GetInternalGraphicsDevice(), shader_instanced, "UnlitInstanced");
+		}
+
+		if (shader_instanced_sprite_ != nullptr)
+		{
+			shader_instanced_sprite_->SetVertexLayout(EffekseerRenderer::GetSpriteInstanceVertexLayout(graphicsDevice_).DownCast<Backend::VertexLayout>());
+			shader_instanced_sprite_->SetIsInstancedLayout(true);
+			shader_instanced_sprite_->SetVertexConstantBufferSize(sizeof(EffekseerRenderer::StandardRendererVertexBuffer) + sizeof(EffekseerRenderer::SpriteInstanceVertexBuffer));
+			shader_instanced_sprite_->SetPixelConstantBufferSize(sizeof(EffekseerRenderer::PixelConstantBuffer));
+			shader_instanced_sprite_->SetIsTransposeEnabled(true);
+			GetImpl()->isInstancedSpriteSupported = true;
+		}
+		else
+		{
+			Effekseer::Log(Effekseer::LogType::Info, "Instanced sprites are disabled because UnlitInstanced is not compiled");
+		}
+	}
+
 	if (initVAO != nullptr)
 	{
 		initVAO.reset();
@@ -401,6 +489,9 @@ bool RendererImplemented::Initialize()
 	GLExt::glBindBuffer(GL_ARRAY_BUFFER, arrayBufferBinding);
 	GLExt::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementArrayBufferBinding);
 
+	// states are restored without the cache
+	graphicsDevice_->GetStateCache().Invalidate();
+
 	GLCheckError();
 	return true;
 }
@@ -417,6 +508,12 @@ bool RendererImplemented::BeginRendering()
 {
 	GLCheckError();
 
+	// grow vertex buffers so that squares dropped in previous frames are drawn
+	if (isSquareMaxCountGrowthEnabled_ && GetImpl()->GetRequiredSquareMaxCount() > m_squareMaxCount)
+	{
+		SetSquareMaxCount(GetImpl()->GetRequiredSquareMaxCount());
+	}
+
 	impl->CalculateCameraProjectionMatrix();
 
 	// store state
@@ -457,18 +554,22 @@ bool RendererImplemented::BeginRendering()
 		}
 	}
 
+	// states may be changed by an application after the last frame
+	auto& stateCache = graphicsDevice_->GetStateCache();
+	stateCache.Invalidate();
+
 	if (GLExt::IsSupportedVertexArray())
 	{
 		if (renderingVAO_ == nullptr)
 		{
 			renderingVAO_ = std::make_unique<EffekseerRendererGL::Backend::VertexArrayObject>();
 		}
-		GLExt::glBindVertexArray(renderingVAO_->GetVAO());
+		stateCache.BindVertexArray(renderingVAO_->GetVAO());
 	}
 
-	glDepthFunc(GL_LEQUAL);
-	glEnable(GL_BLEND);
-	glDisable(GL_CULL_FACE);
+	stateCache.DepthFunc(GL_LEQUAL);
+	stateCache.SetEnabled(GL_BLEND, true);
+	stateCache.SetEnabled(GL_CULL_FACE, false);
 
 	currentTextures_.clear();
 	m_renderState->GetActiveState().Reset();
@@ -493,10 +594,32 @@ bool RendererImplemented::EndRendering()
 
 	// reset renderer
 	m_standardRenderer->ResetAndRenderingIfRequired();
+	m_standardRenderer->ClearStates();
+
+	// vertex buffers used in this frame can be rewritten without orphaning after the fence is signaled
+	auto fence = graphicsDevice_->CreateFence();
+	for (auto& rv : ringVs_)
+	{
+		rv->vertexBuffer->OnFrameEnd(fence);
+	}
+
+	// attributes, shaders and buffers are unbound once in a frame instead of after each draw
+	auto& stateCache = graphicsDevice_->GetStateCache();
+
+	// an element array buffer is unbound from the VAO which is not cached
+	if (renderingVAO_ != nullptr)
+	{
+		stateCache.BindVertexArray(renderingVAO_->GetVAO());
+	}
+
+	stateCache.ResetVertexAttribArrays();
+	stateCache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	stateCache.BindBuffer(GL_ARRAY_BUFFER, 0);
+	stateCache.UseProgram(0);
 
 	if (GLExt::IsSupportedVertexArray())
 	{
-		GLExt::glBindVertexArray(0);
+		stateCache.BindVertexArray(0);
 	}
 
 	// restore states
@@ -556,6 +679,9 @@ bool RendererImplemented::EndRendering()
 
 	currentndexBuffer_ = nullptr;
 
+	// states are restored without the cache and may be changed by an application
+	stateCache.Invalidate();
+
 	GLCheckError();
 
 	return true;
@@ -589,6 +715,22 @@ int32_t RendererImplemented::GetSquareMaxCount() const
 //----------------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------------
+int32_t RendererImplemented::GetRingBufferCount() const
+{
+	return static_cast<int32_t>(ringVs_.size());
+}
+
+void RendererImplemented::SetRingBufferCount(int32_t count)
+{
+	ringBufferCount_ = Effekseer::Max(count, 1);
+	SetSquareMaxCount(m_squareMaxCount);
+}
+
+void RendererImplemented::SetSquareMaxCountGrowthEnabled(bool enabled)
+{
+	isSquareMaxCountGrowthEnabled_ = enabled;
+}
+
 void RendererImplemented::SetSquareMaxCount(int32_t count)
 {
 	int arrayBufferBinding = 0;
@@ -603,7 +745,17 @@ void RendererImplemented::SetSquareMaxCount(int32_t count)
 	// ES_SAFE_DELETE(m_indexBuffer);
 	ringVs_.clear();
 	GetImpl()->CurrentRingBufferIndex = 0;
-	GetImpl()->RingBufferCount = setting.ringBufferCount;
+	GetImpl()->RingBufferCount = ringBufferCount_ > 0 ? ringBufferCount_ : setting.ringBufferCount;
+
+	// the stride is chosen again because the count may be decreased
+	if (GetIndexSpriteCount() * 4 > 65536)
+	{
+		indexBufferStride_ = Effekseer::Backend::IndexBufferStrideType::Stride4;
+	}
+	else
+	{
+		indexBufferStride_ = Effekseer::Backend::IndexBufferStrideType::Stride2;
+	}
 
 	int vertexBufferSize = EffekseerRenderer::GetMaximumVertexSizeInAllTypes() * m_squareMaxCount * 4;
 
@@ -633,8 +785,13 @@ void RendererImplemented::SetSquareMaxCount(int32_t count)
 		ringVs_.emplace_back(rv);
 	}
 
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, arrayBufferBinding);
-	GLExt::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementArrayBufferBinding);
+	if (m_standardRenderer != nullptr)
+	{
+		m_standardRenderer->ResetVertexCacheMaxSize();
+	}
+
+	graphicsDevice_->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, arrayBufferBinding);
+	graphicsDevice_->GetStateCache().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementArrayBufferBinding);
 }
 
 //----------------------------------------------------------------------------------
@@ -731,6 +888,21 @@ void RendererImplemented::SetBackground(GLuint background, bool hasMipmap)
 
 EffekseerRenderer::DistortingCallback* RendererImplemented::GetDistortingCallback()
 {
+	// the callback is called after it is got and may change states
+	if (m_distortingCallback != nullptr)
+	{
+		auto& stateCache = graphicsDevice_->GetStateCache();
+
+		// cached VAOs must not be changed by the callback
+		if (renderingVAO_ != nullptr)
+		{
+			stateCache.BindVertexArray(renderingVAO_->GetVAO());
+		}
+
+		stateCache.ResetVertexAttribArrays();
+		stateCache.Invalidate();
+	}
+
 	return m_distortingCallback;
 }
 
@@ -745,7 +917,7 @@ void RendererImplemented::SetDistortingCallback(EffekseerRenderer::DistortingCal
 //----------------------------------------------------------------------------------
 void RendererImplemented::SetVertexBuffer(VertexBuffer* vertexBuffer, int32_t size)
 {
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer->GetInterface());
+	SetVertexBuffer(vertexBuffer->GetInterface(), size);
 }
 
 //----------------------------------------------------------------------------------
@@ -753,7 +925,8 @@ void RendererImplemented::SetVertexBuffer(VertexBuffer* vertexBuffer, int32_t si
 //----------------------------------------------------------------------------------
 void RendererImplemented::SetVertexBuffer(GLuint vertexBuffer, int32_t size)
 {
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	currentVertexBuffer_ = vertexBuffer;
+	graphicsDevice_->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
 }
 
 void RendererImplemented::SetVertexBuffer(const Effekseer::Backend::VertexBufferRef& vertexBuffer, int32_t size)
@@ -764,9 +937,14 @@ void RendererImplemented::SetVertexBuffer(const Effekseer::Backend::VertexBuffer
 
 void RendererImplemented::SetIndexBuffer(const Effekseer::Backend::IndexBufferRef& indexBuffer)
 {
-	auto ib = static_cast<Backend::IndexBuffer*>(indexBuffer.Get());
 	currentndexBuffer_ = indexBuffer;
-	GLExt::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib->GetBuffer());
+
+	// an index buffer is recorded into a VAO and bound when a draw is issued
+	if (!GLExt::IsSupportedVertexArray())
+	{
+		auto ib = static_cast<Backend::IndexBuffer*>(indexBuffer.Get());
+		graphicsDevice_->GetStateCache().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib->GetBuffer());
+	}
 }
 
 //----------------------------------------------------------------------------------
@@ -776,10 +954,29 @@ void RendererImplemented::SetLayout(Shader* shader)
 {
 	GLCheckError();
 
+	// a VAO is decided with an instance buffer which may be specified when a draw is issued
+	if (GLExt::IsSupportedVertexArray())
+	{
+		layoutShader_ = shader;
+		return;
+	}
+
 	shader->EnableAttribs();
 	GLCheckError();
 }
 
+void RendererImplemented::ApplyLayout(GLuint instanceBuffer)
+{
+	if (layoutShader_ == nullptr)
+	{
+		return;
+	}
+
+	auto ib = static_cast<Backend::IndexBuffer*>(currentndexBuffer_.Get());
+	layoutShader_->BindVertexArray(currentVertexBuffer_, ib->GetBuffer(), instanceBuffer);
+	layoutShader_ = nullptr;
+}
+
 //----------------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------------
@@ -790,6 +987,9 @@ void RendererImplemented::DrawSprites(int32_t spriteCount, int32_t vertexOffset)
 	impl->drawcallCount++;
 	impl->drawvertexCount += spriteCount * 4;
 
+	ApplyLayout();
+	graphicsDevice_->GetStateCache().FlushVertexAttribArrays();
+
 	GLsizei stride = GL_UNSIGNED_SHORT;
 	int32_t strideSize = 2;
 
@@ -799,7 +999,18 @@ void RendererImplemented::DrawSprites(int32_t spriteCount, int32_t vertexOffset)
 		strideSize = 4;
 	}
 
-	if (GetRenderMode() == ::Effekseer::RenderMode::Normal)
+	if (isBaseVertexEnabled_)
+	{
+		if (GetRenderMode() == ::Effekseer::RenderMode::Normal)
+		{
+			GLExt::glDrawElementsBaseVertex(GL_TRIANGLES, spriteCount * 6, stride, nullptr, vertexOffset);
+		}
+		else if (GetRenderMode() == ::Effekseer::RenderMode::Wireframe)
+		{
+			GLExt::glDrawElementsBaseVertex(GL_LINES, spriteCount * 8, stride, nullptr, vertexOffset);
+		}
+	}
+	else if (GetRenderMode() == ::Effekseer::RenderMode::Normal)
 	{
 		glDrawElements(GL_TRIANGLES, spriteCount * 6, stride, (void*)((size_t)vertexOffset / 4 * 6 * strideSize));
 	}
@@ -821,6 +1032,9 @@ void RendererImplemented::DrawPolygon(int32_t vertexCount, int32_t indexCount)
 	impl->drawcallCount++;
 	impl->drawvertexCount += vertexCount;
 
+	ApplyLayout();
+	graphicsDevice_->GetStateCache().FlushVertexAttribArrays();
+
 	if (GetRenderMode() == ::Effekseer::RenderMode::Normal)
 	{
 		glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
@@ -840,6 +1054,9 @@ void RendererImplemented::DrawPolygonInstanced(int32_t vertexCount, int32_t inde
 	impl->drawcallCount++;
 	impl->drawvertexCount += vertexCount * instanceCount;
 
+	ApplyLayout();
+	graphicsDevice_->GetStateCache().FlushVertexAttribArrays();
+
 	if (GetRenderMode() == ::Effekseer::RenderMode::Normal)
 	{
 		GLExt::glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
@@ -851,6 +1068,82 @@ void RendererImplemented::DrawPolygonInstanced(int32_t vertexCount, int32_t inde
 	GLCheckError();
 }
 
+void RendererImplemented::DrawSpritesInstanced(Shader* shader, int32_t instanceCount, int32_t vertexOffset)
+{
+	GLCheckError();
+
+	impl->drawcallCount++;
+	impl->drawvertexCount += instanceCount * 4;
+
+	// offsets change every draw, so attributes are specified with the VAO which is not cached
+	if (renderingVAO_ != nullptr)
+	{
+		auto& stateCache = graphicsDevice_->GetStateCache();
+		auto ib = static_cast<Backend::IndexBuffer*>(currentndexBuffer_.Get());
+		stateCache.BindVertexArray(renderingVAO_->GetVAO());
+		stateCache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib->GetBuffer());
+	}
+
+	// every attribute advances per instance, so the first instance is selected by offsets of attributes
+	shader->EnableAttribs(vertexOffset);
+	graphicsDevice_->GetStateCache().FlushVertexAttribArrays();
+
+	GLsizei stride = GL_UNSIGNED_SHORT;
+	if (currentndexBuffer_->GetStrideType() == Effekseer::Backend::IndexBufferStrideType::Stride4)
+	{
+		stride = GL_UNSIGNED_INT;
+	}
+
+	if (GetRenderMode() == ::Effekseer::RenderMode::Normal)
+	{
+		GLExt::glDrawElementsInstanced(GL_TRIANGLES, 6, stride, nullptr, instanceCount);
+	}
+	else if (GetRenderMode() == ::Effekseer::RenderMode::Wireframe)
+	{
+		GLExt::glDrawElementsInstanced(GL_LINES, 8, stride, nullptr, instanceCount);
+	}
+
+	GLCheckError();
+}
+
+void RendererImplemented::DrawPolygonInstancedWithBuffer(Shader* shader, const EffekseerRenderer::ModelRendererInstanceVertex* instances, int32_t vertexCount, int32_t indexCount, int32_t instanceCount)
+{
+	GLCheckError();
+
+	const int32_t size = static_cast<int32_t>(sizeof(EffekseerRenderer::ModelRendererInstanceVertex)) * instanceCount;
+
+	if (modelInstanceBuffer_ == nullptr || modelInstanceBufferSize_ < size)
+	{
+		modelInstanceBufferSize_ = Effekseer::Max(size, modelInstanceBufferSize_ * 2);
+		modelInstanceBuffer_ = graphicsDevice_->CreateVertexBuffer(modelInstanceBufferSize_, nullptr, true);
+
+		if (modelInstanceBuffer_ == nullptr)
+		{
+			modelInstanceBufferSize_ = 0;
+			return;
+		}
+	}
+
+	auto vb = static_cast<Backend::VertexBuffer*>(modelInstanceBuffer_.Get());
+	graphicsDevice_->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, vb->GetBuffer());
+
+	// orphan the buffer not to wait for previous draws which read it
+	GLExt::glBufferData(GL_ARRAY_BUFFER, modelInstanceBufferSize_, nullptr, GL_STREAM_DRAW);
+	GLExt::glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances);
+
+	if (layoutShader_ != nullptr)
+	{
+		assert(layoutShader_ == shader);
+		ApplyLayout(vb->GetBuffer());
+	}
+	else
+	{
+		shader->EnableInstanceAttribs();
+	}
+
+	DrawPolygonInstanced(vertexCount, indexCount, instanceCount);
+}
+
 Shader* RendererImplemented::GetShader(::EffekseerRenderer::RendererShaderType type) const
 {
 	if (type == ::EffekseerRenderer::RendererShaderType::AdvancedBackDistortion)
@@ -890,6 +1183,37 @@ Shader* RendererImplemented::GetShader(::EffekseerRenderer::RendererShaderType t
 	return shader_unlit_;
 }
 
+Shader* RendererImplemented::GetCompactVertexShader(::EffekseerRenderer::RendererShaderType type) const
+{
+	if (type == ::EffekseerRenderer::RendererShaderType::AdvancedBackDistortion)
+	{
+		return shader_ad_distortion_compact_;
+	}
+	else if (type == ::EffekseerRenderer::RendererShaderType::AdvancedLit)
+	{
+		return shader_ad_lit_compact_;
+	}
+	else if (type == ::EffekseerRenderer::RendererShaderType::AdvancedUnlit)
+	{
+		return shader_ad_unlit_compact_;
+	}
+	else if (type == ::EffekseerRenderer::RendererShaderType::BackDistortion)
+	{
+		return shader_distortion_compact_;
+	}
+	else if (type == ::EffekseerRenderer::RendererShaderType::Lit)
+	{
+		return shader_lit_compact_;
+	}
+
+	return shader_unlit_compact_;
+}
+
+Shader* RendererImplemented::GetInstancedSpriteShader() const
+{
+	return shader_instanced_sprite_;
+}
+
 //----------------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------------
@@ -912,20 +1236,13 @@ void RendererImplemented::EndShader(Shader* shader)
 {
 	assert(currentShader == shader);
 	currentShader = nullptr;
+	layoutShader_ = nullptr;
 
 	GLCheckError();
 
+	// attributes are disabled lazily so that a next draw with the same layout doesn't enable them again
 	shader->DisableAttribs();
 	GLCheckError();
-
-	GLExt::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-	GLCheckError();
-
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, 0);
-	GLCheckError();
-
-	shader->EndScene();
-	GLCheckError();
 }
 
 void RendererImplemented::SetVertexBufferToShader(const void* data, int32_t size, int32_t dstOffset)
@@ -962,8 +1279,7 @@ void RendererImplemented::SetTextures(Shader* shader, Effekseer::Backend::Textur
 			id = texture->GetBuffer();
 		}
 
-		GLExt::glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, id);
+		graphicsDevice_->GetStateCache().BindTexture(i, GL_TEXTURE_2D, id);
 
 		if (textures[i] != nullptr)
 		{
@@ -978,10 +1294,9 @@ void RendererImplemented::SetTextures(Shader* shader, Effekseer::Backend::Textur
 
 		if (shader->GetTextureSlotEnable(i))
 		{
-			GLExt::glUniform1i(shader->GetTextureSlot(i), i);
+			shader->SetTextureUnit(i);
 		}
 	}
-	GLExt::glActiveTexture(GL_TEXTURE0);
 
 	GLCheckError();
 }
@@ -991,6 +1306,7 @@ void RendererImplemented::SetTextures(Shader* shader, Effekseer::Backend::Textur
 //----------------------------------------------------------------------------------
 void RendererImplemented::ResetRenderState()
 {
+	graphicsDevice_->GetStateCache().Invalidate();
 	m_renderState->GetActiveState().Reset();
 	m_renderState->Update(true);
 }
@@ -1000,6 +1316,11 @@ bool RendererImplemented::IsVertexArrayObjectSupported() const
 	return GLExt::IsSupportedVertexArray();
 }
 
+void RendererImplemented::InvalidateStateCache()
+{
+	graphicsDevice_->GetStateCache().Invalidate();
+}
+
 void AddVertexUniformLayout(Effekseer::CustomVector<Effekseer::Backend::UniformLayoutElement>& uniformLayout)
 {
 	using namespace Effekseer::Backend;
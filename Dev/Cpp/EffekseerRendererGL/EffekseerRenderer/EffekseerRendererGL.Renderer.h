@@ -25,6 +25,22 @@ namespace EffekseerRendererGL
 
 Effekseer::Backend::TextureRef CreateTexture(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, GLuint buffer, bool hasMipmap, const std::function<void()>& onDisposed);
 
+/**
+	@brief
+	\~English	Specify a directory to cache linked shader programs between runs. Programs are keyed by their codes and the driver. It does nothing if the driver doesn't support program binaries.
+	\~Japanese	実行間でリンクされたシェーダープログラムをキャッシュするディレクトリを指定する。プログラムはコードとドライバで識別される。ドライバがプログラムバイナリに対応していない場合は何もしない。
+	@param	directory
+	\~English	a directory which ends with a separator. The cache is disabled if it is empty.
+	\~Japanese	区切り文字で終わるディレクトリ。空の場合、キャッシュは無効になる。
+	@param	fileInterface
+	\~English	a file interface. DefaultFileInterface is used if it is null.
+	\~Japanese	ファイルインターフェース。nullの場合、DefaultFileInterfaceが使用される。
+	@note
+	\~English	Call it before a renderer is created with the device to cache built-in shaders too.
+	\~Japanese	組み込みのシェーダーもキャッシュするには、このデバイスでレンダラーを生成する前に呼ぶ。
+*/
+void SetProgramBinaryCacheDirectory(Effekseer::Backend::GraphicsDeviceRef graphicsDevice, const char16_t* directory, ::Effekseer::FileInterfaceRef fileInterface = nullptr);
+
 /**
 		@brief	\~English	Properties in a texture
 				\~Japanese	テクスチャ内のプロパティ
@@ -86,6 +102,33 @@ public:
 	*/
 	virtual void SetSquareMaxCount(int32_t count) = 0;
 
+	/**
+	@brief
+	\~english	Get the number of vertex buffers which are used in turn
+	\~japanese	交互に使用される頂点バッファの数を取得する。
+	*/
+	virtual int32_t GetRingBufferCount() const = 0;
+
+	/**
+	@brief
+	\~english	Specify the number of vertex buffers which are used in turn. Vertex buffers are recreated.
+	\~japanese	交互に使用される頂点バッファの数を設定する。頂点バッファは再生成される。
+	@note
+	\~english	It cannot be called while rendering.
+	\~japanese	描画している時は使用できない。
+	*/
+	virtual void SetRingBufferCount(int32_t count) = 0;
+
+	/**
+	@brief
+	\~english	Specify whether squareMaxCount grows at BeginRendering when squares are dropped because of the lack of vertex buffers
+	\~japanese	頂点バッファが足りずに四角形が描画されなかった場合に、BeginRenderingでsquareMaxCountを増やすかどうかを設定する。
+	@note
+	\~english	It grows up to EffekseerRenderer::Renderer::GetRequiredSquareMaxCount. Reset it with ResetDroppedSquareCount to shrink a requirement.
+	\~japanese	EffekseerRenderer::Renderer::GetRequiredSquareMaxCountまで増加する。要求を減らすにはResetDroppedSquareCountでリセットする。
+	*/
+	virtual void SetSquareMaxCountGrowthEnabled(bool enabled) = 0;
+
 	/**
 	@brief
 	\~english	Specify a background.
@@ -106,6 +149,16 @@ public:
 	\~japanese VAOがサポートされているか取得する。
 	*/
 	virtual bool IsVertexArrayObjectSupported() const = 0;
+
+	/**
+	@brief
+	\~english	Notify that states of OpenGL are changed by an application between BeginRendering and EndRendering.
+	\~japanese	BeginRenderingとEndRenderingの間でアプリケーションがOpenGLのステートを変更したことを通知する。
+	@note
+	\~english	The renderer skips calls which don't change states with a cache of states. It is invalidated automatically at BeginRendering and before DistortingCallback is called.
+	\~japanese	レンダラーはステートのキャッシュを用いて、ステートを変更しない呼び出しを省略する。キャッシュはBeginRenderingとDistortingCallbackの呼び出し前に自動的に無効化される。
+	*/
+	virtual void InvalidateStateCache() = 0;
 };
 
 } // namespace EffekseerRendererGL
@@ -73,6 +73,11 @@ private:
 
 	int32_t m_squareMaxCount;
 
+	//! the number of vertex buffers which are used in turn. If it is 0, it is decided by a platform.
+	int32_t ringBufferCount_ = 0;
+
+	bool isSquareMaxCountGrowthEnabled_ = false;
+
 	Shader* shader_unlit_ = nullptr;
 	Shader* shader_distortion_ = nullptr;
 	Shader* shader_lit_ = nullptr;
@@ -80,6 +85,21 @@ private:
 	Shader* shader_ad_lit_ = nullptr;
 	Shader* shader_ad_distortion_ = nullptr;
 
+	//! shaders which share programs with above shaders but read compact vertices
+	Shader* shader_unlit_compact_ = nullptr;
+	Shader* shader_distortion_compact_ = nullptr;
+	Shader* shader_lit_compact_ = nullptr;
+	Shader* shader_ad_unlit_compact_ = nullptr;
+	Shader* shader_ad_lit_compact_ = nullptr;
+	Shader* shader_ad_distortion_compact_ = nullptr;
+
+	//! a shader which expands a SpriteInstanceVertex into a quad
+	Shader* shader_instanced_sprite_ = nullptr;
+
+	//! a buffer for instances of models. It is orphaned whenever it is updated.
+	Effekseer::Backend::VertexBufferRef modelInstanceBuffer_;
+	int32_t modelInstanceBufferSize_ = 0;
+
 	Shader* currentShader = nullptr;
 
 	EffekseerRenderer::StandardRenderer<RendererImplemented, Shader>* m_standardRenderer;
@@ -102,11 +122,23 @@ private:
 
 	std::unique_ptr<::EffekseerRendererGL::Backend::VertexArrayObject> renderingVAO_;
 
+	//! a vertex buffer which is specified currently
+	GLuint currentVertexBuffer_ = 0;
+
+	//! a shader whose layout is bound with a cached VAO when a next draw is issued
+	Shader* layoutShader_ = nullptr;
+
+	//! the first vertex of sprites is specified with a base vertex instead of an offset of indices
+	bool isBaseVertexEnabled_ = false;
+
 	static PlatformSetting GetPlatformSetting();
 
-	//! because gleDrawElements has only index offset
+	//! because gleDrawElements has only index offset unless a base vertex is supported
 	int32_t GetIndexSpriteCount() const;
 
+	//! bind a cached VAO of a shader which is specified with SetLayout
+	void ApplyLayout(GLuint instanceBuffer = 0);
+
 public:
 	RendererImplemented(int32_t squareMaxCount, Backend::GraphicsDeviceRef graphicsDevice);
 
@@ -148,6 +180,12 @@ public:
 
 	void SetSquareMaxCount(int32_t count) override;
 
+	int32_t GetRingBufferCount() const override;
+
+	void SetRingBufferCount(int32_t count) override;
+
+	void SetSquareMaxCountGrowthEnabled(bool enabled) override;
+
 	::EffekseerRenderer::RenderStateBase* GetRenderState();
 
 	/**
@@ -213,8 +251,12 @@ public:
 	void DrawSprites(int32_t spriteCount, int32_t vertexOffset);
 	void DrawPolygon(int32_t vertexCount, int32_t indexCount);
 	void DrawPolygonInstanced(int32_t vertexCount, int32_t indexCount, int32_t instanceCount);
+	void DrawSpritesInstanced(Shader* shader, int32_t instanceCount, int32_t vertexOffset);
+	void DrawPolygonInstancedWithBuffer(Shader* shader, const EffekseerRenderer::ModelRendererInstanceVertex* instances, int32_t vertexCount, int32_t indexCount, int32_t instanceCount);
 
 	Shader* GetShader(::EffekseerRenderer::RendererShaderType type) const;
+	Shader* GetCompactVertexShader(::EffekseerRenderer::RendererShaderType type) const;
+	Shader* GetInstancedSpriteShader() const;
 	void BeginShader(Shader* shader);
 	void EndShader(Shader* shader);
 
@@ -238,6 +280,8 @@ public:
 
 	bool IsVertexArrayObjectSupported() const override;
 
+	void InvalidateStateCache() override;
+
 	Backend::GraphicsDeviceRef& GetInternalGraphicsDevice()
 	{
 		return graphicsDevice_;
@@ -143,6 +143,11 @@ void Shader::AssignAttribs()
 		attribs_ = Backend::GetVertexAttribLocations(vertexLayout_, shader);
 	}
 
+	if (instanceVertexLayout_ != nullptr)
+	{
+		instanceAttribs_ = Backend::GetVertexAttribLocations(instanceVertexLayout_, shader);
+	}
+
 	baseInstance_ = GLExt::glGetUniformLocation(shader->GetProgram(), "SPIRV_Cross_BaseInstance");
 }
 
@@ -189,31 +194,87 @@ void Shader::OverrideShader(::Effekseer::Backend::ShaderRef shader)
 
 void Shader::SetVertexLayout(Backend::VertexLayoutRef vertexLayout)
 {
+	// a released layout may be allocated again at the same address as a key of VAOs
+	if (vertexLayout_ != nullptr)
+	{
+		graphicsDevice_->GetStateCache().ReleaseVertexArrays(GetCurrentShader()->GetProgram());
+	}
+
 	vertexLayout_ = vertexLayout;
 	AssignAttribs();
 }
 
+void Shader::SetInstanceVertexLayout(Backend::VertexLayoutRef vertexLayout)
+{
+	if (instanceVertexLayout_ != nullptr)
+	{
+		graphicsDevice_->GetStateCache().ReleaseVertexArrays(GetCurrentShader()->GetProgram());
+	}
+
+	instanceVertexLayout_ = vertexLayout;
+	AssignAttribs();
+}
+
 void Shader::BeginScene()
 {
-	GLExt::glUseProgram(GetCurrentShader()->GetProgram());
+	graphicsDevice_->GetStateCache().UseProgram(GetCurrentShader()->GetProgram());
 }
 
-void Shader::EndScene()
+void Shader::EnableAttribs(int32_t baseOffset)
 {
-	GLExt::glUseProgram(0);
+	GLCheckError();
+	Backend::EnableLayouts(graphicsDevice_->GetStateCache(), vertexLayout_, attribs_, baseOffset, isInstancedLayout_ ? 1 : 0);
+	GLCheckError();
 }
 
-void Shader::EnableAttribs()
+void Shader::EnableInstanceAttribs()
 {
 	GLCheckError();
-	Backend::EnableLayouts(vertexLayout_, attribs_);
+	Backend::EnableLayouts(graphicsDevice_->GetStateCache(), instanceVertexLayout_, instanceAttribs_, 0, 1);
 	GLCheckError();
 }
 
 void Shader::DisableAttribs()
 {
 	GLCheckError();
-	Backend::DisableLayouts(attribs_);
+	Backend::DisableLayouts(graphicsDevice_->GetStateCache(), attribs_);
+
+	if (instanceVertexLayout_ != nullptr)
+	{
+		Backend::DisableLayouts(graphicsDevice_->GetStateCache(), instanceAttribs_);
+	}
+	GLCheckError();
+}
+
+void Shader::BindVertexArray(GLuint vertexBuffer, GLuint indexBuffer, GLuint instanceBuffer)
+{
+	GLCheckError();
+
+	auto& stateCache = graphicsDevice_->GetStateCache();
+
+	Backend::VertexArrayKey key;
+	key.Program = GetCurrentShader()->GetProgram();
+	key.Layout = vertexLayout_.Get();
+	key.VertexBuffer = vertexBuffer;
+	key.IndexBuffer = indexBuffer;
+
+	if (instanceBuffer != 0)
+	{
+		key.InstanceLayout = instanceVertexLayout_.Get();
+		key.InstanceBuffer = instanceBuffer;
+	}
+
+	stateCache.BindCachedVertexArray(key, [&]() {
+		stateCache.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+		EnableAttribs();
+
+		if (instanceBuffer != 0)
+		{
+			stateCache.BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+			EnableInstanceAttribs();
+		}
+	});
+
 	GLCheckError();
 }
 
@@ -249,6 +310,11 @@ bool Shader::GetTextureSlotEnable(int32_t index)
 	return index < GetCurrentShader()->GetTextureLocations().size();
 }
 
+void Shader::SetTextureUnit(int32_t index)
+{
+	GetCurrentShader()->SetTextureUnit(index, index);
+}
+
 bool Shader::IsValid() const
 {
 	return GetCurrentShader()->GetProgram() != 0;
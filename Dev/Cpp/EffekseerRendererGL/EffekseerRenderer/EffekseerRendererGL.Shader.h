@@ -34,6 +34,9 @@ private:
 	Backend::ShaderRef shaderOverride_;
 	Backend::VertexLayoutRef vertexLayout_;
 
+	//! a layout of attributes which are read from another buffer per instance
+	Backend::VertexLayoutRef instanceVertexLayout_;
+
 	int32_t m_vertexSize;
 
 	Backend::UniformBufferRef vertexConstantBuffer_;
@@ -42,9 +45,13 @@ private:
 	std::string name_;
 
 	Effekseer::CustomVector<GLint> attribs_;
+	Effekseer::CustomVector<GLint> instanceAttribs_;
 
 	bool isTransposeEnabled_ = false;
 
+	//! attributes advance once per instance
+	bool isInstancedLayout_ = false;
+
 	GLint baseInstance_ = -1;
 
 	Backend::ShaderRef& GetCurrentShader();
@@ -94,11 +101,29 @@ public:
 
 	void SetVertexLayout(Backend::VertexLayoutRef vertexLayout);
 
+	void SetInstanceVertexLayout(Backend::VertexLayoutRef vertexLayout);
+
 	void BeginScene();
-	void EndScene();
-	void EnableAttribs();
+
+	/**
+		@param	baseOffset	an offset of the first vertex in bytes
+	*/
+	void EnableAttribs(int32_t baseOffset = 0);
+
+	/**
+		@brief	enable attributes of an instance layout with a buffer which is bound currently
+	*/
+	void EnableInstanceAttribs();
 	void DisableAttribs();
 
+	/**
+		@brief	bind a VAO in which attributes are enabled with buffers
+		@param	instanceBuffer	a buffer of an instance layout. Instance attributes are not enabled if it is 0.
+		@note
+		VAOs are cached per a combination of a program, layouts and buffers so that attributes are specified only once.
+	*/
+	void BindVertexArray(GLuint vertexBuffer, GLuint indexBuffer, GLuint instanceBuffer = 0);
+
 	void SetVertexConstantBufferSize(int32_t size) override;
 	void SetPixelConstantBufferSize(int32_t size) override;
 
@@ -116,11 +141,19 @@ public:
 	GLint GetTextureSlot(int32_t index);
 	bool GetTextureSlotEnable(int32_t index);
 
+	//! assign a texture unit whose index is same as the slot. The shader must be in use.
+	void SetTextureUnit(int32_t index);
+
 	void SetIsTransposeEnabled(bool isTransposeEnabled)
 	{
 		isTransposeEnabled_ = isTransposeEnabled;
 	}
 
+	void SetIsInstancedLayout(bool isInstancedLayout)
+	{
+		isInstancedLayout_ = isInstancedLayout;
+	}
+
 	bool IsValid() const;
 };
 
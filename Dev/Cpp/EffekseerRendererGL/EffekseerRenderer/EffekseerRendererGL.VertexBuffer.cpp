@@ -34,15 +34,17 @@ VertexBuffer::VertexBuffer(const Backend::GraphicsDeviceRef& graphicsDevice, boo
 
 	m_resource = nullptr;
 
+	auto& stateCache = GetGraphicsDevice()->GetStateCache();
+
 	GLExt::glGenBuffers(1, &m_buffer);
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+	stateCache.BindBuffer(GL_ARRAY_BUFFER, m_buffer);
 
 	if (isRingEnabled_)
 	{
 		GLExt::glBufferData(GL_ARRAY_BUFFER, m_size, storage_->buffer.data(), GL_STREAM_DRAW);
 	}
 
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, 0);
+	stateCache.BindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 //-----------------------------------------------------------------------------------
@@ -50,6 +52,7 @@ VertexBuffer::VertexBuffer(const Backend::GraphicsDeviceRef& graphicsDevice, boo
 //-----------------------------------------------------------------------------------
 VertexBuffer::~VertexBuffer()
 {
+	GetGraphicsDevice()->GetStateCache().OnBufferDeleted(m_buffer);
 	GLExt::glDeleteBuffers(1, &m_buffer);
 }
 
@@ -71,6 +74,8 @@ GLuint VertexBuffer::GetInterface()
 //-----------------------------------------------------------------------------------
 void VertexBuffer::OnLostDevice()
 {
+	directMapped_ = nullptr;
+	GetGraphicsDevice()->GetStateCache().OnBufferDeleted(m_buffer);
 	GLExt::glDeleteBuffers(1, &m_buffer);
 	m_buffer = 0;
 }
@@ -83,14 +88,16 @@ void VertexBuffer::OnResetDevice()
 	if (IsValid())
 		return;
 
+	auto& stateCache = GetGraphicsDevice()->GetStateCache();
+
 	GLExt::glGenBuffers(1, &m_buffer);
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+	stateCache.BindBuffer(GL_ARRAY_BUFFER, m_buffer);
 
 #ifndef __ANDROID__
 	GLExt::glBufferData(GL_ARRAY_BUFFER, m_size, storage_->buffer.data(), GL_STREAM_DRAW);
 #endif // !__ANDROID__
 
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, 0);
+	stateCache.BindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 //-----------------------------------------------------------------------------------
@@ -158,10 +165,16 @@ bool VertexBuffer::TryRingBufferLock(int32_t size, int32_t& offset, void*& data,
 void VertexBuffer::Unlock()
 {
 	assert(m_isLock || m_ringBufferLock);
+	assert(directMapped_ == nullptr);
 
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+	// the buffer is kept bound because it is bound again to draw
+	GetGraphicsDevice()->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, m_buffer);
 
-	if (GLExt::IsSupportedBufferRange() && m_vertexRingStart > 0)
+	// the head of the buffer can be rewritten without orphaning if GPU has finished all frames which used it
+	const bool isReusable = isRingEnabled_ && m_vertexRingStart == 0 && !isUsedInFrame_ && fence_ != nullptr && fence_->IsCompleted();
+	isUsedInFrame_ = true;
+
+	if (GLExt::IsSupportedBufferRange() && (m_vertexRingStart > 0 || isReusable))
 	{
 		if (!isRingEnabled_)
 		{
@@ -234,18 +247,68 @@ void VertexBuffer::Unlock()
 		}
 	}
 
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, 0);
-
 	m_isLock = false;
 	m_ringBufferLock = false;
 	m_resource = nullptr;
 }
 
+uint8_t* VertexBuffer::MapRingBufferDirect(int32_t offset)
+{
+	assert(!m_isLock && !m_ringBufferLock);
+	assert(directMapped_ == nullptr);
+
+	if (!m_isDynamic || !isRingEnabled_ || !GLExt::IsSupportedBufferRange() || offset >= m_size)
+	{
+		return nullptr;
+	}
+
+	GetGraphicsDevice()->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+	// same as Unlock, the head of the buffer is orphaned unless GPU has finished all frames which used it
+	const bool isReusable = !isUsedInFrame_ && fence_ != nullptr && fence_->IsCompleted();
+	const GLbitfield access = (offset > 0 || isReusable) ? (GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT) : (GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+	directMapped_ = static_cast<uint8_t*>(GLExt::glMapBufferRange(GL_ARRAY_BUFFER, offset, m_size - offset, access));
+	directMappedOffset_ = offset;
+	return directMapped_;
+}
+
+bool VertexBuffer::CommitRingBufferDirect(int32_t size, int32_t& offset, int32_t alignment)
+{
+	if (directMapped_ == nullptr)
+	{
+		return false;
+	}
+
+	void* data = nullptr;
+	const bool isLocked = RingBufferLock(size, offset, data, alignment);
+
+	GetGraphicsDevice()->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, m_buffer);
+	const bool isUnmapped = GLExt::glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+
+	directMapped_ = nullptr;
+	isUsedInFrame_ = true;
+	m_ringBufferLock = false;
+	m_resource = nullptr;
+
+	// the contents of the buffer are undefined if unmapping fails
+	return isLocked && isUnmapped && offset == directMappedOffset_;
+}
+
 bool VertexBuffer::IsValid()
 {
 	return m_buffer != 0;
 }
 
+void VertexBuffer::OnFrameEnd(const Effekseer::Backend::FenceRef& fence)
+{
+	if (isUsedInFrame_)
+	{
+		fence_ = fence;
+		isUsedInFrame_ = false;
+	}
+}
+
 //-----------------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------------
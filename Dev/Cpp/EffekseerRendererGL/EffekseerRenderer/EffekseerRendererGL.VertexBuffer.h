@@ -31,6 +31,14 @@ private:
 	uint32_t m_vertexRingStart;
 	bool m_ringBufferLock;
 
+	//! a fence after the last frame which used this buffer
+	Effekseer::Backend::FenceRef fence_;
+	bool isUsedInFrame_ = false;
+
+	//! a memory which is mapped by MapRingBufferDirect
+	uint8_t* directMapped_ = nullptr;
+	int32_t directMappedOffset_ = 0;
+
 	VertexBuffer(const Backend::GraphicsDeviceRef& graphicsDevice, bool isRingEnabled, int size, bool isDynamic, std::shared_ptr<SharedVertexTempStorage> storage = nullptr);
 
 public:
@@ -51,7 +59,13 @@ public:
 
 	void Unlock();
 
+	uint8_t* MapRingBufferDirect(int32_t offset) override;
+	bool CommitRingBufferDirect(int32_t size, int32_t& offset, int32_t alignment) override;
+
 	bool IsValid();
+
+	//! it is called at the end of a frame with a fence after the frame
+	void OnFrameEnd(const Effekseer::Backend::FenceRef& fence);
 };
 
 //-----------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 #include "GraphicsDevice.h"
 #include "EffekseerRendererGL.Base.h"
 #include "EffekseerRendererGL.GLExtension.h"
+#include <Effekseer/Utils/Effekseer.CacheFile.h>
 
 #ifdef __ANDROID__
 
@@ -38,7 +39,7 @@ Effekseer::CustomVector<GLint> GetVertexAttribLocations(const VertexLayoutRef& v
 	return ret;
 }
 
-void EnableLayouts(const VertexLayoutRef& vertexLayout, const Effekseer::CustomVector<GLint>& locations)
+void EnableLayouts(StateCache& stateCache, const VertexLayoutRef& vertexLayout, const Effekseer::CustomVector<GLint>& locations, int32_t baseOffset, GLuint divisor)
 {
 	int32_t vertexSize = 0;
 	for (size_t i = 0; i < vertexLayout->GetElements().size(); i++)
@@ -47,7 +48,7 @@ void EnableLayouts(const VertexLayoutRef& vertexLayout, const Effekseer::CustomV
 		vertexSize += Effekseer::Backend::GetVertexLayoutFormatSize(element.Format);
 	}
 
-	uint32_t offset = 0;
+	uint32_t offset = static_cast<uint32_t>(baseOffset);
 	for (size_t i = 0; i < vertexLayout->GetElements().size(); i++)
 	{
 		const auto& element = vertexLayout->GetElements()[i];
@@ -88,6 +89,16 @@ void EnableLayouts(const VertexLayoutRef& vertexLayout, const Effekseer::CustomV
 			count = 4;
 			type = GL_FLOAT;
 		}
+		else if (element.Format == Effekseer::Backend::VertexLayoutFormat::R16G16_FLOAT)
+		{
+			count = 2;
+			type = GL_HALF_FLOAT;
+		}
+		else if (element.Format == Effekseer::Backend::VertexLayoutFormat::R16G16B16A16_FLOAT)
+		{
+			count = 4;
+			type = GL_HALF_FLOAT;
+		}
 		else
 		{
 			assert(0);
@@ -95,7 +106,7 @@ void EnableLayouts(const VertexLayoutRef& vertexLayout, const Effekseer::CustomV
 
 		if (loc >= 0)
 		{
-			GLExt::glEnableVertexAttribArray(loc);
+			stateCache.EnableVertexAttribArray(loc, divisor);
 			GLExt::glVertexAttribPointer(loc,
 										 count,
 										 type,
@@ -108,16 +119,11 @@ void EnableLayouts(const VertexLayoutRef& vertexLayout, const Effekseer::CustomV
 	}
 }
 
-void DisableLayouts(const Effekseer::CustomVector<GLint>& locations)
+void DisableLayouts(StateCache& stateCache, const Effekseer::CustomVector<GLint>& locations)
 {
 	for (size_t i = 0; i < locations.size(); i++)
 	{
-		auto loc = locations[i];
-
-		if (loc >= 0)
-		{
-			GLExt::glDisableVertexAttribArray(loc);
-		}
+		stateCache.DisableVertexAttribArray(locations[i]);
 	}
 }
 
@@ -172,6 +178,542 @@ void StoreUniforms(const ShaderRef& shader, const UniformBufferRef& vertexUnifor
 	}
 }
 
+const int32_t StateCache::VertexAttribMax;
+const GLuint StateCache::UnknownValue;
+
+StateCache::StateCache()
+{
+	Invalidate();
+	divisors_.fill(0);
+}
+
+StateCache::~StateCache()
+{
+	ClearVertexArrays();
+}
+
+int32_t* StateCache::GetCapability(GLenum cap)
+{
+	if (cap == GL_BLEND)
+	{
+		return &blend_;
+	}
+	else if (cap == GL_CULL_FACE)
+	{
+		return &cullFace_;
+	}
+	else if (cap == GL_DEPTH_TEST)
+	{
+		return &depthTest_;
+	}
+
+	return nullptr;
+}
+
+void StateCache::Invalidate()
+{
+	program_ = UnknownValue;
+	vao_ = UnknownValue;
+	arrayBuffer_ = UnknownValue;
+	elementArrayBuffer_ = UnknownValue;
+	activeTextureUnit_ = UnknownValue;
+	textures_.fill(TextureBinding{UnknownValue, UnknownValue});
+	samplers_.fill(UnknownValue);
+	samplerParameters_.clear();
+	textureParameters_.clear();
+
+	blend_ = -1;
+	cullFace_ = -1;
+	depthTest_ = -1;
+	depthMask_ = -1;
+	depthFunc_ = UnknownValue;
+	cullFaceMode_ = UnknownValue;
+	blendEquation_.fill(UnknownValue);
+	blendFunc_.fill(UnknownValue);
+
+	staleAttribs_ |= enabledAttribs_ | pendingDisabledAttribs_;
+	enabledAttribs_ = 0;
+	pendingDisabledAttribs_ = 0;
+	isVertexArrayCached_ = false;
+}
+
+void StateCache::UseProgram(GLuint program)
+{
+	if (program_ == program)
+	{
+		return;
+	}
+
+	GLExt::glUseProgram(program);
+	program_ = program;
+}
+
+void StateCache::BindVertexArray(GLuint vao)
+{
+	if (vao_ == vao)
+	{
+		return;
+	}
+
+	if (vao_ != UnknownValue && !isVertexArrayCached_)
+	{
+		ResetVertexAttribArrays();
+	}
+
+	GLExt::glBindVertexArray(vao);
+	vao_ = vao;
+
+	// an element array buffer and attributes are states of VAO
+	auto it = vertexArrayIndexBuffers_.find(vao);
+	isVertexArrayCached_ = it != vertexArrayIndexBuffers_.end();
+	elementArrayBuffer_ = isVertexArrayCached_ ? it->second : UnknownValue;
+	enabledAttribs_ = 0;
+	pendingDisabledAttribs_ = 0;
+	staleAttribs_ = 0;
+	divisors_.fill(0);
+}
+
+void StateCache::BindCachedVertexArray(const VertexArrayKey& key, const std::function<void()>& setAttributes)
+{
+	auto it = vertexArrays_.find(key);
+	if (it != vertexArrays_.end())
+	{
+		BindVertexArray(it->second);
+		return;
+	}
+
+	if (vertexArrays_.size() >= VertexArrayMax)
+	{
+		ClearVertexArrays();
+	}
+
+	GLuint vao = 0;
+	GLExt::glGenVertexArrays(1, &vao);
+
+	// the VAO is bound as an uncached one to record attributes
+	BindVertexArray(vao);
+	elementArrayBuffer_ = 0;
+	BindBuffer(GL_ELEMENT_ARRAY_BUFFER, key.IndexBuffer);
+	setAttributes();
+	FlushVertexAttribArrays();
+
+	vertexArrays_[key] = vao;
+	vertexArrayIndexBuffers_[vao] = key.IndexBuffer;
+
+	// attributes belong to the VAO from now
+	isVertexArrayCached_ = true;
+	enabledAttribs_ = 0;
+	staleAttribs_ = 0;
+	divisors_.fill(0);
+}
+
+template <typename PREDICATE>
+void StateCache::ReleaseVertexArrays(PREDICATE predicate)
+{
+	for (auto it = vertexArrays_.begin(); it != vertexArrays_.end();)
+	{
+		if (!predicate(it->first))
+		{
+			++it;
+			continue;
+		}
+
+		const GLuint vao = it->second;
+
+		// a binding is reset to zero when a bound VAO is deleted
+		if (vao_ == vao)
+		{
+			vao_ = UnknownValue;
+			elementArrayBuffer_ = UnknownValue;
+			isVertexArrayCached_ = false;
+		}
+
+		GLExt::glDeleteVertexArrays(1, &vao);
+		vertexArrayIndexBuffers_.erase(vao);
+		it = vertexArrays_.erase(it);
+	}
+}
+
+void StateCache::ReleaseVertexArrays(GLuint program)
+{
+	ReleaseVertexArrays([program](const VertexArrayKey& key) { return key.Program == program; });
+}
+
+void StateCache::ClearVertexArrays()
+{
+	ReleaseVertexArrays([](const VertexArrayKey&) { return true; });
+}
+
+void StateCache::BindBuffer(GLenum target, GLuint buffer)
+{
+	GLuint* current = nullptr;
+
+	if (target == GL_ARRAY_BUFFER)
+	{
+		current = &arrayBuffer_;
+	}
+	else if (target == GL_ELEMENT_ARRAY_BUFFER)
+	{
+		current = &elementArrayBuffer_;
+	}
+
+	if (current == nullptr)
+	{
+		GLExt::glBindBuffer(target, buffer);
+		return;
+	}
+
+	if (*current == buffer)
+	{
+		return;
+	}
+
+	GLExt::glBindBuffer(target, buffer);
+	*current = buffer;
+}
+
+void StateCache::ActiveTexture(int32_t unit)
+{
+	if (activeTextureUnit_ == static_cast<GLuint>(unit))
+	{
+		return;
+	}
+
+	GLExt::glActiveTexture(GL_TEXTURE0 + unit);
+	activeTextureUnit_ = static_cast<GLuint>(unit);
+}
+
+void StateCache::BindTexture(int32_t unit, GLenum target, GLuint texture)
+{
+	if (unit >= Effekseer::TextureSlotMax)
+	{
+		ActiveTexture(unit);
+		glBindTexture(target, texture);
+		return;
+	}
+
+	auto& binding = textures_[unit];
+	if (binding.Target == target && binding.Texture == texture)
+	{
+		return;
+	}
+
+	ActiveTexture(unit);
+	glBindTexture(target, texture);
+	binding.Target = target;
+	binding.Texture = texture;
+}
+
+void StateCache::BindSampler(int32_t unit, GLuint sampler)
+{
+	if (unit >= Effekseer::TextureSlotMax)
+	{
+		GLExt::glBindSampler(unit, sampler);
+		return;
+	}
+
+	if (samplers_[unit] == sampler)
+	{
+		return;
+	}
+
+	GLExt::glBindSampler(unit, sampler);
+	samplers_[unit] = sampler;
+}
+
+void StateCache::SetSamplerParameters(GLuint sampler, GLint filterMin, GLint filterMag, GLint wrap)
+{
+	const SamplingParameter param{filterMin, filterMag, wrap};
+
+	auto it = samplerParameters_.find(sampler);
+	if (it != samplerParameters_.end() && it->second == param)
+	{
+		return;
+	}
+
+	const bool isKnown = it != samplerParameters_.end();
+
+	if (!isKnown || it->second.FilterMag != filterMag)
+	{
+		GLExt::glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, filterMag);
+	}
+
+	if (!isKnown || it->second.FilterMin != filterMin)
+	{
+		GLExt::glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, filterMin);
+	}
+
+	if (!isKnown || it->second.Wrap != wrap)
+	{
+		GLExt::glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, wrap);
+		GLExt::glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, wrap);
+	}
+
+	samplerParameters_[sampler] = param;
+}
+
+void StateCache::SetTextureParameters(int32_t unit, GLenum target, GLuint texture, GLint filterMin, GLint filterMag, GLint wrap)
+{
+	BindTexture(unit, target, texture);
+
+	const SamplingParameter param{filterMin, filterMag, wrap};
+
+	auto it = textureParameters_.find(texture);
+	if (it != textureParameters_.end() && it->second == param)
+	{
+		return;
+	}
+
+	const bool isKnown = it != textureParameters_.end();
+
+	ActiveTexture(unit);
+
+	if (!isKnown || it->second.FilterMag != filterMag)
+	{
+		glTexParameteri(target, GL_TEXTURE_MAG_FILTER, filterMag);
+	}
+
+	if (!isKnown || it->second.FilterMin != filterMin)
+	{
+		glTexParameteri(target, GL_TEXTURE_MIN_FILTER, filterMin);
+	}
+
+	if (!isKnown || it->second.Wrap != wrap)
+	{
+		glTexParameteri(target, GL_TEXTURE_WRAP_S, wrap);
+		glTexParameteri(target, GL_TEXTURE_WRAP_T, wrap);
+	}
+
+	textureParameters_[texture] = param;
+}
+
+void StateCache::SetEnabled(GLenum cap, bool enabled)
+{
+	auto current = GetCapability(cap);
+
+	if (current != nullptr && *current == (enabled ? 1 : 0))
+	{
+		return;
+	}
+
+	if (enabled)
+	{
+		glEnable(cap);
+	}
+	else
+	{
+		glDisable(cap);
+	}
+
+	if (current != nullptr)
+	{
+		*current = enabled ? 1 : 0;
+	}
+}
+
+void StateCache::DepthMask(bool enabled)
+{
+	if (depthMask_ == (enabled ? 1 : 0))
+	{
+		return;
+	}
+
+	glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	depthMask_ = enabled ? 1 : 0;
+}
+
+void StateCache::DepthFunc(GLenum func)
+{
+	if (depthFunc_ == func)
+	{
+		return;
+	}
+
+	glDepthFunc(func);
+	depthFunc_ = func;
+}
+
+void StateCache::CullFace(GLenum mode)
+{
+	if (cullFaceMode_ == mode)
+	{
+		return;
+	}
+
+	glCullFace(mode);
+	cullFaceMode_ = mode;
+}
+
+void StateCache::BlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+{
+	if (blendEquation_[0] == modeRGB && blendEquation_[1] == modeAlpha)
+	{
+		return;
+	}
+
+	GLExt::glBlendEquationSeparate(modeRGB, modeAlpha);
+	blendEquation_ = {modeRGB, modeAlpha};
+}
+
+void StateCache::BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+	if (blendFunc_[0] == srcRGB && blendFunc_[1] == dstRGB && blendFunc_[2] == srcAlpha && blendFunc_[3] == dstAlpha)
+	{
+		return;
+	}
+
+	GLExt::glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+	blendFunc_ = {srcRGB, dstRGB, srcAlpha, dstAlpha};
+}
+
+void StateCache::EnableVertexAttribArray(GLint location, GLuint divisor)
+{
+	if (location < 0)
+	{
+		return;
+	}
+
+	if (location >= VertexAttribMax)
+	{
+		GLExt::glEnableVertexAttribArray(location);
+		if (divisor != 0)
+		{
+			GLExt::glVertexAttribDivisor(location, divisor);
+		}
+		return;
+	}
+
+	const uint32_t bit = 1u << location;
+	const bool isStale = (staleAttribs_ & bit) != 0;
+
+	if ((pendingDisabledAttribs_ & bit) != 0)
+	{
+		pendingDisabledAttribs_ &= ~bit;
+	}
+	else if ((enabledAttribs_ & bit) == 0)
+	{
+		GLExt::glEnableVertexAttribArray(location);
+	}
+
+	enabledAttribs_ |= bit;
+	staleAttribs_ &= ~bit;
+
+	if (divisors_[location] != divisor || (isStale && divisor != 0))
+	{
+		GLExt::glVertexAttribDivisor(location, divisor);
+		divisors_[location] = divisor;
+	}
+}
+
+void StateCache::DisableVertexAttribArray(GLint location)
+{
+	if (location < 0)
+	{
+		return;
+	}
+
+	if (location >= VertexAttribMax)
+	{
+		if (GLExt::IsSupportedVertexAttribDivisor())
+		{
+			GLExt::glVertexAttribDivisor(location, 0);
+		}
+		GLExt::glDisableVertexAttribArray(location);
+		return;
+	}
+
+	const uint32_t bit = 1u << location;
+
+	if ((enabledAttribs_ & bit) != 0)
+	{
+		enabledAttribs_ &= ~bit;
+		pendingDisabledAttribs_ |= bit;
+	}
+}
+
+void StateCache::FlushVertexAttribArrays()
+{
+	for (int32_t i = 0; pendingDisabledAttribs_ != 0; i++)
+	{
+		const uint32_t bit = 1u << i;
+		if ((pendingDisabledAttribs_ & bit) == 0)
+		{
+			continue;
+		}
+
+		// a divisor remains after an attribute is disabled
+		if (divisors_[i] != 0)
+		{
+			GLExt::glVertexAttribDivisor(i, 0);
+			divisors_[i] = 0;
+		}
+
+		GLExt::glDisableVertexAttribArray(i);
+		pendingDisabledAttribs_ &= ~bit;
+	}
+}
+
+void StateCache::ResetVertexAttribArrays()
+{
+	pendingDisabledAttribs_ |= enabledAttribs_ | staleAttribs_;
+	enabledAttribs_ = 0;
+	staleAttribs_ = 0;
+	FlushVertexAttribArrays();
+}
+
+void StateCache::OnBufferDeleted(GLuint buffer)
+{
+	// a binding is reset to zero when a bound buffer is deleted
+	if (arrayBuffer_ == buffer)
+	{
+		arrayBuffer_ = 0;
+	}
+
+	if (elementArrayBuffer_ == buffer)
+	{
+		elementArrayBuffer_ = 0;
+	}
+
+	// a name of the buffer may be reused by another buffer
+	ReleaseVertexArrays([buffer](const VertexArrayKey& key) { return key.VertexBuffer == buffer || key.IndexBuffer == buffer || key.InstanceBuffer == buffer; });
+}
+
+void StateCache::OnTextureDeleted(GLuint texture)
+{
+	for (auto& binding : textures_)
+	{
+		if (binding.Texture == texture)
+		{
+			binding.Texture = 0;
+		}
+	}
+
+	textureParameters_.erase(texture);
+}
+
+void StateCache::OnSamplerDeleted(GLuint sampler)
+{
+	for (auto& s : samplers_)
+	{
+		if (s == sampler)
+		{
+			s = 0;
+		}
+	}
+
+	samplerParameters_.erase(sampler);
+}
+
+void StateCache::OnProgramDeleted(GLuint program)
+{
+	if (program_ == program)
+	{
+		program_ = UnknownValue;
+	}
+
+	ReleaseVertexArrays(program);
+}
+
 void DeviceObject::OnLostDevice()
 {
 }
@@ -249,6 +791,7 @@ void VertexBuffer::Deallocate()
 {
 	if (buffer_ != 0)
 	{
+		graphicsDevice_->GetStateCache().OnBufferDeleted(buffer_);
 		GLExt::glDeleteBuffers(1, &buffer_);
 		buffer_ = 0;
 	}
@@ -341,6 +884,7 @@ void IndexBuffer::Deallocate()
 {
 	if (buffer_ != 0)
 	{
+		graphicsDevice_->GetStateCache().OnBufferDeleted(buffer_);
 		GLExt::glDeleteBuffers(1, &buffer_);
 		buffer_ = 0;
 	}
@@ -413,6 +957,11 @@ Texture::Texture(GraphicsDevice* graphicsDevice)
 
 Texture::~Texture()
 {
+	if (buffer_ > 0)
+	{
+		graphicsDevice_->GetStateCache().OnTextureDeleted(buffer_);
+	}
+
 	if (onDisposed_)
 	{
 		onDisposed_();
@@ -778,6 +1327,33 @@ Shader::~Shader()
 
 bool Shader::Compile()
 {
+	const bool isProgramBinaryCacheEnabled = graphicsDevice_->GetIsProgramBinaryCacheEnabled();
+	uint64_t programBinaryKey = 0;
+	uint64_t sourceLength = 0;
+
+	if (isProgramBinaryCacheEnabled)
+	{
+		programBinaryKey = graphicsDevice_->CalculateProgramBinaryKey(vsCodes_, psCodes_);
+
+		for (const auto& codes : {&vsCodes_, &psCodes_})
+		{
+			for (const auto& code : *codes)
+			{
+				sourceLength += code.size();
+			}
+		}
+
+		auto program = GLExt::glCreateProgram();
+		if (graphicsDevice_->LoadProgramBinary(programBinaryKey, sourceLength, program))
+		{
+			program_ = program;
+			UpdateLocations();
+			return true;
+		}
+
+		GLExt::glDeleteProgram(program);
+	}
+
 	std::array<GLchar*, elementMax> vsCodePtr;
 	std::array<GLchar*, elementMax> psCodePtr;
 	std::array<GLint, elementMax> vsCodeLen;
@@ -812,6 +1388,11 @@ bool Shader::Compile()
 	GLExt::glAttachShader(program, vert_shader);
 	GLExt::glAttachShader(program, frag_shader);
 
+	if (isProgramBinaryCacheEnabled)
+	{
+		GLExt::glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
 	// link shaders
 	GLExt::glLinkProgram(program);
 	GLExt::glGetProgramiv(program, GL_LINK_STATUS, &res_link);
@@ -854,6 +1435,18 @@ bool Shader::Compile()
 
 	program_ = program;
 
+	if (isProgramBinaryCacheEnabled)
+	{
+		graphicsDevice_->SaveProgramBinary(programBinaryKey, sourceLength, program_);
+	}
+
+	UpdateLocations();
+
+	return true;
+}
+
+void Shader::UpdateLocations()
+{
 	if (layout_ != nullptr)
 	{
 		textureLocations_.reserve(layout_->GetTextures().size());
@@ -862,24 +1455,26 @@ bool Shader::Compile()
 			textureLocations_.emplace_back(GLExt::glGetUniformLocation(program_, layout_->GetTextures()[i].c_str()));
 		}
 
+		textureUnits_.assign(textureLocations_.size(), -1);
+
 		uniformLocations_.reserve(layout_->GetElements().size());
 		for (size_t i = 0; i < layout_->GetElements().size(); i++)
 		{
 			uniformLocations_.emplace_back(GLExt::glGetUniformLocation(program_, layout_->GetElements()[i].Name.c_str()));
 		}
 	}
-
-	return true;
 }
 
 void Shader::Reset()
 {
 	if (program_ > 0)
 	{
+		graphicsDevice_->GetStateCache().OnProgramDeleted(program_);
 		GLExt::glDeleteProgram(program_);
 	}
 
 	textureLocations_.clear();
+	textureUnits_.clear();
 	uniformLocations_.clear();
 }
 
@@ -941,6 +1536,17 @@ const Effekseer::CustomVector<GLint>& Shader::GetUniformLocations() const
 	return uniformLocations_;
 }
 
+void Shader::SetTextureUnit(int32_t index, GLint unit)
+{
+	if (index >= static_cast<int32_t>(textureLocations_.size()) || textureLocations_[index] < 0 || textureUnits_[index] == unit)
+	{
+		return;
+	}
+
+	GLExt::glUniform1i(textureLocations_[index], unit);
+	textureUnits_[index] = unit;
+}
+
 bool PipelineState::Init(const Effekseer::Backend::PipelineStateParameter& param)
 {
 	param_ = param;
@@ -1027,6 +1633,44 @@ bool RenderPass::Init(Effekseer::FixedSizeVector<Effekseer::Backend::TextureRef,
 	return true;
 }
 
+Fence::~Fence()
+{
+	if (sync_ != nullptr)
+	{
+		GLExt::glDeleteSync(sync_);
+		sync_ = nullptr;
+	}
+}
+
+bool Fence::Init()
+{
+	if (!GLExt::IsSupportedSync())
+	{
+		return false;
+	}
+
+	sync_ = GLExt::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	return sync_ != nullptr;
+}
+
+bool Fence::IsCompleted()
+{
+	return Wait(0);
+}
+
+bool Fence::Wait(uint64_t timeoutNanoseconds)
+{
+	if (isCompleted_)
+	{
+		return true;
+	}
+
+	// flush commands so that the fence is signaled even if nothing is issued later
+	const auto result = GLExt::glClientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds);
+	isCompleted_ = result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+	return isCompleted_;
+}
+
 GraphicsDevice::GraphicsDevice(OpenGLDeviceType deviceType, bool isExtensionsEnabled)
 	: deviceType_(deviceType)
 {
@@ -1071,11 +1715,6 @@ GraphicsDevice::GraphicsDevice(OpenGLDeviceType deviceType, bool isExtensionsEna
 	}
 
 	GLExt::glGenFramebuffers(1, &frameBufferTemp_);
-
-	if (GLExt::IsSupportedVertexArray())
-	{
-		vao_ = std::make_unique<VertexArrayObject>();
-	}
 }
 
 GraphicsDevice::~GraphicsDevice()
@@ -1107,16 +1746,26 @@ void GraphicsDevice::LostDevice()
 	{
 		o->OnLostDevice();
 	}
+
+	stateCache_.ClearVertexArrays();
+	stateCache_.Invalidate();
 }
 
 void GraphicsDevice::ResetDevice()
 {
+	stateCache_.Invalidate();
+
 	for (auto& o : objects_)
 	{
 		o->OnResetDevice();
 	}
 }
 
+StateCache& GraphicsDevice::GetStateCache()
+{
+	return stateCache_;
+}
+
 OpenGLDeviceType GraphicsDevice::GetDeviceType() const
 {
 	return deviceType_;
@@ -1223,13 +1872,13 @@ bool GraphicsDevice::CopyTexture(Effekseer::Backend::TextureRef& dst, Effekseer:
 
 	if (dstgl->GetTarget() == GL_TEXTURE_2D)
 	{
-		glBindTexture(dstgl->GetTarget(), dstgl->GetBuffer());
+		stateCache_.BindTexture(0, dstgl->GetTarget(), dstgl->GetBuffer());
 		glCopyTexSubImage2D(dstgl->GetTarget(), 0, dstPos[0], dstPos[1], srcPos[0], srcPos[1], size[0], size[1]);
 		GLCheckError();
 	}
 	else
 	{
-		glBindTexture(dstgl->GetTarget(), dstgl->GetBuffer());
+		stateCache_.BindTexture(0, dstgl->GetTarget(), dstgl->GetBuffer());
 		GLExt::glCopyTexSubImage3D(dstgl->GetTarget(), 0, dstPos[0], dstPos[1], dstPos[2] + dstLayer, srcPos[0], srcPos[1], size[0], size[1]);
 		GLCheckError();
 	}
@@ -1277,6 +1926,18 @@ Effekseer::Backend::RenderPassRef GraphicsDevice::CreateRenderPass(Effekseer::Fi
 	return ret;
 }
 
+Effekseer::Backend::FenceRef GraphicsDevice::CreateFence()
+{
+	auto ret = Effekseer::MakeRefPtr<Fence>();
+
+	if (!ret->Init())
+	{
+		return nullptr;
+	}
+
+	return ret;
+}
+
 Effekseer::Backend::PipelineStateRef GraphicsDevice::CreatePipelineState(const Effekseer::Backend::PipelineStateParameter& param)
 {
 	auto ret = Effekseer::MakeRefPtr<PipelineState>();
@@ -1332,15 +1993,32 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 
 	GLint currentVAO = 0;
 
+	const auto vertexBuffer = static_cast<VertexBuffer*>(drawParam.VertexBufferPtr.Get())->GetBuffer();
+	const auto indexBuffer = static_cast<IndexBuffer*>(drawParam.IndexBufferPtr.Get())->GetBuffer();
+
 	if (GLExt::IsSupportedVertexArray())
 	{
 		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &currentVAO);
-		GLExt::glBindVertexArray(vao_->GetVAO());
+
+		// layouts are recorded into a VAO once per a combination of a pipeline and buffers
+		VertexArrayKey key;
+		key.Program = shader->GetProgram();
+		key.Layout = vertexLayout;
+		key.VertexBuffer = vertexBuffer;
+		key.IndexBuffer = indexBuffer;
+
+		stateCache_.BindCachedVertexArray(key, [&]() {
+			stateCache_.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+			EnableLayouts(stateCache_, pip->GetParam().VertexLayoutPtr.DownCast<Backend::VertexLayout>(), pip->GetAttribLocations());
+		});
+	}
+	else
+	{
+		stateCache_.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+		stateCache_.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
 	}
 
-	GLExt::glBindBuffer(GL_ARRAY_BUFFER, static_cast<VertexBuffer*>(drawParam.VertexBufferPtr.Get())->GetBuffer());
-	GLExt::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_cast<IndexBuffer*>(drawParam.IndexBufferPtr.Get())->GetBuffer());
-	GLExt::glUseProgram(shader->GetProgram());
+	stateCache_.UseProgram(shader->GetProgram());
 
 	// textures
 	const auto textureCount = std::min(static_cast<int32_t>(shader->GetLayout()->GetTextures().size()), drawParam.TextureCount);
@@ -1354,13 +2032,12 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 			continue;
 		}
 
-		GLExt::glUniform1i(textureSlot, i);
+		shader->SetTextureUnit(i, i);
 
 		auto texture = static_cast<Texture*>(drawParam.TexturePtrs[i].Get());
 		if (texture != nullptr)
 		{
-			GLExt::glActiveTexture(GL_TEXTURE0 + i);
-			glBindTexture(texture->GetTarget(), texture->GetBuffer());
+			stateCache_.BindTexture(i, texture->GetTarget(), texture->GetBuffer());
 
 			GLCheckError();
 
@@ -1409,18 +2086,12 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 
 			if (deviceType_ == OpenGLDeviceType::OpenGL3 || deviceType_ == OpenGLDeviceType::OpenGLES3)
 			{
-				GLExt::glSamplerParameteri(samplers_[i], GL_TEXTURE_MAG_FILTER, filterMag);
-				GLExt::glSamplerParameteri(samplers_[i], GL_TEXTURE_MIN_FILTER, filterMin);
-				GLExt::glSamplerParameteri(samplers_[i], GL_TEXTURE_WRAP_S, wrap);
-				GLExt::glSamplerParameteri(samplers_[i], GL_TEXTURE_WRAP_T, wrap);
-				GLExt::glBindSampler(i, samplers_[i]);
+				stateCache_.SetSamplerParameters(samplers_[i], filterMin, filterMag, wrap);
+				stateCache_.BindSampler(i, samplers_[i]);
 			}
 			else
 			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filterMag);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filterMin);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+				stateCache_.SetTextureParameters(i, GL_TEXTURE_2D, texture->GetBuffer(), filterMin, filterMag, wrap);
 			}
 
 			GLCheckError();
@@ -1438,8 +2109,12 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 	GLCheckError();
 
 	// layouts
-	auto vl = pip->GetParam().VertexLayoutPtr;
-	EnableLayouts(vl.DownCast<Backend::VertexLayout>(), pip->GetAttribLocations());
+	if (!GLExt::IsSupportedVertexArray())
+	{
+		auto vl = pip->GetParam().VertexLayoutPtr;
+		EnableLayouts(stateCache_, vl.DownCast<Backend::VertexLayout>(), pip->GetAttribLocations());
+		stateCache_.FlushVertexAttribArrays();
+	}
 
 	GLCheckError();
 
@@ -1451,36 +2126,36 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 	{
 		if (pip->GetParam().Culling == Effekseer::Backend::CullingType::Clockwise)
 		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(GL_BACK);
+			stateCache_.SetEnabled(GL_CULL_FACE, true);
+			stateCache_.CullFace(GL_BACK);
 		}
 		else if (pip->GetParam().Culling == Effekseer::Backend::CullingType::CounterClockwise)
 		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(GL_FRONT);
+			stateCache_.SetEnabled(GL_CULL_FACE, true);
+			stateCache_.CullFace(GL_FRONT);
 		}
 		else if (pip->GetParam().Culling == Effekseer::Backend::CullingType::DoubleSide)
 		{
-			glDisable(GL_CULL_FACE);
-			glCullFace(GL_FRONT_AND_BACK);
+			stateCache_.SetEnabled(GL_CULL_FACE, false);
+			stateCache_.CullFace(GL_FRONT_AND_BACK);
 		}
 	}
 	else
 	{
 		if (pip->GetParam().Culling == Effekseer::Backend::CullingType::Clockwise)
 		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(GL_FRONT);
+			stateCache_.SetEnabled(GL_CULL_FACE, true);
+			stateCache_.CullFace(GL_FRONT);
 		}
 		else if (pip->GetParam().Culling == Effekseer::Backend::CullingType::CounterClockwise)
 		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(GL_BACK);
+			stateCache_.SetEnabled(GL_CULL_FACE, true);
+			stateCache_.CullFace(GL_BACK);
 		}
 		else if (pip->GetParam().Culling == Effekseer::Backend::CullingType::DoubleSide)
 		{
-			glDisable(GL_CULL_FACE);
-			glCullFace(GL_FRONT_AND_BACK);
+			stateCache_.SetEnabled(GL_CULL_FACE, false);
+			stateCache_.CullFace(GL_FRONT_AND_BACK);
 		}
 	}
 
@@ -1489,11 +2164,11 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 	{
 		if (pip->GetParam().IsDepthTestEnabled || pip->GetParam().IsDepthWriteEnabled)
 		{
-			glEnable(GL_DEPTH_TEST);
+			stateCache_.SetEnabled(GL_DEPTH_TEST, true);
 		}
 		else
 		{
-			glDisable(GL_DEPTH_TEST);
+			stateCache_.SetEnabled(GL_DEPTH_TEST, false);
 		}
 
 		if (pip->GetParam().IsDepthTestEnabled)
@@ -1508,20 +2183,20 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 			depthFuncs[static_cast<int>(::Effekseer::Backend::DepthFuncType::Never)] = GL_NEVER;
 			depthFuncs[static_cast<int>(::Effekseer::Backend::DepthFuncType::Always)] = GL_ALWAYS;
 
-			glDepthFunc(depthFuncs[static_cast<int>(pip->GetParam().DepthFunc)]);
+			stateCache_.DepthFunc(depthFuncs[static_cast<int>(pip->GetParam().DepthFunc)]);
 		}
 		else
 		{
-			glDepthFunc(GL_ALWAYS);
+			stateCache_.DepthFunc(GL_ALWAYS);
 		}
 
-		glDepthMask(pip->GetParam().IsDepthWriteEnabled);
+		stateCache_.DepthMask(pip->GetParam().IsDepthWriteEnabled);
 	}
 
 	{
 		if (pip->GetParam().IsBlendEnabled)
 		{
-			glEnable(GL_BLEND);
+			stateCache_.SetEnabled(GL_BLEND, true);
 
 			std::array<GLenum, 5> blendEq;
 
@@ -1543,12 +2218,12 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 			blendFunc[static_cast<int>(::Effekseer::Backend::BlendFuncType::DstAlpha)] = GL_DST_ALPHA;
 			blendFunc[static_cast<int>(::Effekseer::Backend::BlendFuncType::OneMinusDstAlpha)] = GL_ONE_MINUS_DST_ALPHA;
 
-			GLExt::glBlendEquationSeparate(blendEq[static_cast<int>(pip->GetParam().BlendEquationRGB)], blendEq[static_cast<int>(pip->GetParam().BlendEquationAlpha)]);
-			GLExt::glBlendFuncSeparate(blendFunc[static_cast<int>(pip->GetParam().BlendSrcFunc)], blendFunc[static_cast<int>(pip->GetParam().BlendDstFunc)], blendFunc[static_cast<int>(pip->GetParam().BlendSrcFuncAlpha)], blendFunc[static_cast<int>(pip->GetParam().BlendDstFuncAlpha)]);
+			stateCache_.BlendEquationSeparate(blendEq[static_cast<int>(pip->GetParam().BlendEquationRGB)], blendEq[static_cast<int>(pip->GetParam().BlendEquationAlpha)]);
+			stateCache_.BlendFuncSeparate(blendFunc[static_cast<int>(pip->GetParam().BlendSrcFunc)], blendFunc[static_cast<int>(pip->GetParam().BlendDstFunc)], blendFunc[static_cast<int>(pip->GetParam().BlendSrcFuncAlpha)], blendFunc[static_cast<int>(pip->GetParam().BlendDstFuncAlpha)]);
 		}
 		else
 		{
-			glDisable(GL_BLEND);
+			stateCache_.SetEnabled(GL_BLEND, false);
 		}
 	}
 
@@ -1595,11 +2270,14 @@ void GraphicsDevice::Draw(const Effekseer::Backend::DrawParameter& drawParam)
 		glDrawElements(primitiveMode, indexPerPrimitive * drawParam.PrimitiveCount, indexStrideType, (void*)(drawParam.IndexOffset * indexStride));
 	}
 
-	DisableLayouts(pip->GetAttribLocations());
-
 	if (GLExt::IsSupportedVertexArray())
 	{
-		GLExt::glBindVertexArray(currentVAO);
+		stateCache_.BindVertexArray(currentVAO);
+	}
+	else
+	{
+		DisableLayouts(stateCache_, pip->GetAttribLocations());
+		stateCache_.FlushVertexAttribArrays();
 	}
 
 	GLCheckError();
@@ -1684,5 +2362,181 @@ Effekseer::Backend::TextureRef GraphicsDevice::CreateTexture(GLuint buffer, bool
 	return ret;
 }
 
+void GraphicsDevice::SetProgramBinaryCacheDirectory(const char16_t* directory, Effekseer::FileInterfaceRef fileInterface)
+{
+	programBinaryCacheDirectory_ = directory != nullptr ? directory : u"";
+	programBinaryFileInterface_ = fileInterface;
+
+	if (programBinaryFileInterface_ == nullptr)
+	{
+		programBinaryFileInterface_ = Effekseer::MakeRefPtr<Effekseer::DefaultFileInterface>();
+	}
+
+	auto getString = [](GLenum name) -> std::string
+	{
+		auto value = reinterpret_cast<const char*>(glGetString(name));
+		return value != nullptr ? value : "";
+	};
+
+	// binaries are valid only for the driver which creates them
+	driverRenderer_ = getString(GL_RENDERER);
+	driverVersion_ = getString(GL_VERSION);
+	driverIdentity_ = getString(GL_VENDOR) + '\n' + driverRenderer_ + '\n' + driverVersion_ + '\n';
+}
+
+bool GraphicsDevice::GetIsProgramBinaryCacheEnabled() const
+{
+	return !programBinaryCacheDirectory_.empty() && GLExt::IsSupportedProgramBinary();
+}
+
+uint64_t GraphicsDevice::CalculateProgramBinaryKey(const Effekseer::CustomVector<Effekseer::CustomString<char>>& vsCodes, const Effekseer::CustomVector<Effekseer::CustomString<char>>& psCodes) const
+{
+	Effekseer::HashBuilder hash;
+
+	auto combine = [&hash](const char* value, size_t size)
+	{
+		hash.AddBytes(value, size);
+
+		// a separator
+		hash.AddValue(0xFF);
+	};
+
+	combine(driverIdentity_.data(), driverIdentity_.size());
+
+	for (const auto& code : vsCodes)
+	{
+		combine(code.data(), code.size());
+	}
+
+	combine("", 0);
+
+	for (const auto& code : psCodes)
+	{
+		combine(code.data(), code.size());
+	}
+
+	return hash.Get();
+}
+
+namespace
+{
+struct ProgramBinaryHeader
+{
+	static const uint32_t FourCC = 0x42504745; // EGPB
+	static const uint32_t LatestVersion = 2;
+
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t Key;
+	uint64_t SourceLength;
+	uint32_t Format;
+	int32_t Length;
+
+	//! GL_RENDERER and GL_VERSION follow the header and the binary follows them
+	int32_t RendererLength;
+	int32_t VersionLength;
+};
+
+//! read a string which is written after the header and compare it with the expected one
+bool ReadAndCompareString(Effekseer::FileReaderRef& reader, int32_t length, const std::string& expected)
+{
+	if (length != static_cast<int32_t>(expected.size()))
+	{
+		return false;
+	}
+
+	std::string value(length, '\0');
+	if (length > 0 && reader->Read(&value[0], length) != static_cast<size_t>(length))
+	{
+		return false;
+	}
+
+	return value == expected;
+}
+
+} // namespace
+
+bool GraphicsDevice::LoadProgramBinary(uint64_t key, uint64_t sourceLength, GLuint program)
+{
+	auto reader = programBinaryFileInterface_->TryOpenRead(Effekseer::GetCacheFilePath(programBinaryCacheDirectory_, key, u".efkglpb").c_str());
+	if (reader == nullptr)
+	{
+		return false;
+	}
+
+	ProgramBinaryHeader header;
+	if (reader->Read(&header, sizeof(header)) != sizeof(header))
+	{
+		return false;
+	}
+
+	// the key is a hash, so the values which are hashed are also compared to reject a collision
+	if (header.Magic != ProgramBinaryHeader::FourCC || header.Version != ProgramBinaryHeader::LatestVersion || header.Key != key || header.SourceLength != sourceLength ||
+		header.Length <= 0 || header.RendererLength < 0 || header.VersionLength < 0 ||
+		reader->GetLength() != sizeof(header) + static_cast<size_t>(header.RendererLength) + static_cast<size_t>(header.VersionLength) + static_cast<size_t>(header.Length))
+	{
+		return false;
+	}
+
+	if (!ReadAndCompareString(reader, header.RendererLength, driverRenderer_) || !ReadAndCompareString(reader, header.VersionLength, driverVersion_))
+	{
+		return false;
+	}
+
+	Effekseer::CustomVector<uint8_t> binary(header.Length);
+	if (reader->Read(binary.data(), binary.size()) != binary.size())
+	{
+		return false;
+	}
+
+	GLExt::glProgramBinary(program, header.Format, binary.data(), header.Length);
+
+	// a driver rejects a binary after it is updated
+	GLint linked = GL_FALSE;
+	GLExt::glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	return linked != GL_FALSE;
+}
+
+void GraphicsDevice::SaveProgramBinary(uint64_t key, uint64_t sourceLength, GLuint program)
+{
+	GLint length = 0;
+	GLExt::glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+	{
+		return;
+	}
+
+	Effekseer::CustomVector<uint8_t> binary(length);
+	GLenum format = 0;
+	GLsizei written = 0;
+	GLExt::glGetProgramBinary(program, length, &written, &format, binary.data());
+	if (written <= 0)
+	{
+		return;
+	}
+
+	auto writer = programBinaryFileInterface_->OpenWrite(Effekseer::GetCacheFilePath(programBinaryCacheDirectory_, key, u".efkglpb").c_str());
+	if (writer == nullptr)
+	{
+		return;
+	}
+
+	ProgramBinaryHeader header;
+	header.Magic = ProgramBinaryHeader::FourCC;
+	header.Version = ProgramBinaryHeader::LatestVersion;
+	header.Key = key;
+	header.SourceLength = sourceLength;
+	header.Format = format;
+	header.Length = written;
+	header.RendererLength = static_cast<int32_t>(driverRenderer_.size());
+	header.VersionLength = static_cast<int32_t>(driverVersion_.size());
+
+	writer->Write(&header, sizeof(header));
+	writer->Write(driverRenderer_.data(), driverRenderer_.size());
+	writer->Write(driverVersion_.data(), driverVersion_.size());
+	writer->Write(binary.data(), written);
+	writer->Flush();
+}
+
 } // namespace Backend
 } // namespace EffekseerRendererGL
\ No newline at end of file
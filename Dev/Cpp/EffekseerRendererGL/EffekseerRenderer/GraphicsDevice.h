@@ -6,7 +6,9 @@
 #include <Effekseer.h>
 #include <assert.h>
 #include <functional>
+#include <limits>
 #include <set>
+#include <unordered_map>
 
 namespace EffekseerRendererGL
 {
@@ -24,6 +26,7 @@ class Texture;
 class RenderPass;
 class PipelineState;
 class UniformLayout;
+class StateCache;
 
 using GraphicsDeviceRef = Effekseer::RefPtr<GraphicsDevice>;
 using VertexBufferRef = Effekseer::RefPtr<VertexBuffer>;
@@ -39,12 +42,215 @@ using UniformLayoutRef = Effekseer::RefPtr<UniformLayout>;
 
 Effekseer::CustomVector<GLint> GetVertexAttribLocations(const VertexLayoutRef& vertexLayout, const ShaderRef& shader);
 
-void EnableLayouts(const VertexLayoutRef& vertexLayout, const Effekseer::CustomVector<GLint>& locations);
+/**
+	@param	baseOffset	an offset of the first vertex in bytes
+	@param	divisor	a divisor of attributes. Attributes advance once per instance if it is 1.
+*/
+void EnableLayouts(StateCache& stateCache, const VertexLayoutRef& vertexLayout, const Effekseer::CustomVector<GLint>& locations, int32_t baseOffset = 0, GLuint divisor = 0);
 
-void DisableLayouts(const Effekseer::CustomVector<GLint>& locations);
+/**
+	@note
+	Attributes are disabled when StateCache::FlushVertexAttribArrays is called so that attributes which are enabled again by a next draw are not toggled.
+*/
+void DisableLayouts(StateCache& stateCache, const Effekseer::CustomVector<GLint>& locations);
 
 void StoreUniforms(const ShaderRef& shader, const UniformBufferRef& vertexUniform, const UniformBufferRef& fragmentUniform, bool transpose);
 
+/**
+	@brief	A combination of objects which are recorded into a VAO
+*/
+struct VertexArrayKey
+{
+	GLuint Program = 0;
+	const VertexLayout* Layout = nullptr;
+	GLuint VertexBuffer = 0;
+	GLuint IndexBuffer = 0;
+
+	//! a layout and a buffer of attributes which advance per instance. They are empty without an instance buffer.
+	const VertexLayout* InstanceLayout = nullptr;
+	GLuint InstanceBuffer = 0;
+
+	bool operator==(const VertexArrayKey& rhs) const
+	{
+		return Program == rhs.Program && Layout == rhs.Layout && VertexBuffer == rhs.VertexBuffer && IndexBuffer == rhs.IndexBuffer &&
+			   InstanceLayout == rhs.InstanceLayout && InstanceBuffer == rhs.InstanceBuffer;
+	}
+
+	struct Hash
+	{
+		size_t operator()(const VertexArrayKey& key) const
+		{
+			size_t hash = std::hash<GLuint>()(key.Program);
+			const auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+			combine(std::hash<const VertexLayout*>()(key.Layout));
+			combine(std::hash<GLuint>()(key.VertexBuffer));
+			combine(std::hash<GLuint>()(key.IndexBuffer));
+			combine(std::hash<const VertexLayout*>()(key.InstanceLayout));
+			combine(std::hash<GLuint>()(key.InstanceBuffer));
+			return hash;
+		}
+	};
+};
+
+/**
+	@brief	A shadow of states of OpenGL to skip calls which don't change anything
+	@note
+	States are unknown after Invalidate is called and next calls are issued to the driver.
+	It must be invalidated when states are changed without it.
+*/
+class StateCache
+{
+public:
+	static const int32_t VertexAttribMax = 32;
+
+private:
+	static const GLuint UnknownValue = std::numeric_limits<GLuint>::max();
+
+	//! all cached VAOs are released when the count exceeds it
+	static const size_t VertexArrayMax = 1024;
+
+	struct TextureBinding
+	{
+		GLenum Target;
+		GLuint Texture;
+	};
+
+	struct SamplingParameter
+	{
+		GLint FilterMin;
+		GLint FilterMag;
+		GLint Wrap;
+
+		bool operator==(const SamplingParameter& rhs) const
+		{
+			return FilterMin == rhs.FilterMin && FilterMag == rhs.FilterMag && Wrap == rhs.Wrap;
+		}
+	};
+
+	GLuint program_ = UnknownValue;
+	GLuint vao_ = UnknownValue;
+	GLuint arrayBuffer_ = UnknownValue;
+	GLuint elementArrayBuffer_ = UnknownValue;
+	GLuint activeTextureUnit_ = UnknownValue;
+	std::array<TextureBinding, Effekseer::TextureSlotMax> textures_;
+	std::array<GLuint, Effekseer::TextureSlotMax> samplers_;
+	std::unordered_map<GLuint, SamplingParameter> samplerParameters_;
+	std::unordered_map<GLuint, SamplingParameter> textureParameters_;
+
+	//! 1 : enabled, 0 : disabled, -1 : unknown
+	int32_t blend_ = -1;
+	int32_t cullFace_ = -1;
+	int32_t depthTest_ = -1;
+	int32_t depthMask_ = -1;
+
+	GLuint depthFunc_ = UnknownValue;
+	GLuint cullFaceMode_ = UnknownValue;
+	std::array<GLuint, 2> blendEquation_;
+	std::array<GLuint, 4> blendFunc_;
+
+	//! attributes which are enabled with this cache
+	uint32_t enabledAttribs_ = 0;
+
+	//! attributes which are disabled by next FlushVertexAttribArrays
+	uint32_t pendingDisabledAttribs_ = 0;
+
+	//! attributes which were enabled before Invalidate. They are enabled or disabled again because they may be changed.
+	uint32_t staleAttribs_ = 0;
+
+	std::array<GLuint, VertexAttribMax> divisors_;
+
+	//! VAOs whose attributes are specified once when they are created
+	std::unordered_map<VertexArrayKey, GLuint, VertexArrayKey::Hash> vertexArrays_;
+
+	//! index buffers which are bound to cached VAOs
+	std::unordered_map<GLuint, GLuint> vertexArrayIndexBuffers_;
+
+	//! whether the current VAO is cached. Its attributes are not changed with this class.
+	bool isVertexArrayCached_ = false;
+
+	int32_t* GetCapability(GLenum cap);
+
+	template <typename PREDICATE>
+	void ReleaseVertexArrays(PREDICATE predicate);
+
+public:
+	StateCache();
+
+	~StateCache();
+
+	StateCache(const StateCache&) = delete;
+
+	StateCache& operator=(const StateCache&) = delete;
+
+	//! forget all states. It must be called when states of OpenGL are changed without this class.
+	void Invalidate();
+
+	void UseProgram(GLuint program);
+
+	//! attributes of the current VAO are disabled before another VAO is bound unless it is cached
+	void BindVertexArray(GLuint vao);
+
+	/**
+		@brief	bind a VAO which is cached per a key
+		@param	setAttributes	a function which enables attributes of the key. It is called only when the VAO is created.
+		@note
+		An index buffer of the key is recorded into the VAO. Another element array buffer must not be bound while the VAO is bound.
+	*/
+	void BindCachedVertexArray(const VertexArrayKey& key, const std::function<void()>& setAttributes);
+
+	//! release VAOs which are recorded with the program
+	void ReleaseVertexArrays(GLuint program);
+
+	//! release all cached VAOs
+	void ClearVertexArrays();
+
+	//! GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+	void BindBuffer(GLenum target, GLuint buffer);
+
+	void ActiveTexture(int32_t unit);
+
+	void BindTexture(int32_t unit, GLenum target, GLuint texture);
+
+	void BindSampler(int32_t unit, GLuint sampler);
+
+	void SetSamplerParameters(GLuint sampler, GLint filterMin, GLint filterMag, GLint wrap);
+
+	//! apply parameters to a texture with glTexParameteri. The texture is bound to the unit.
+	void SetTextureParameters(int32_t unit, GLenum target, GLuint texture, GLint filterMin, GLint filterMag, GLint wrap);
+
+	//! GL_BLEND, GL_CULL_FACE or GL_DEPTH_TEST
+	void SetEnabled(GLenum cap, bool enabled);
+
+	void DepthMask(bool enabled);
+
+	void DepthFunc(GLenum func);
+
+	void CullFace(GLenum mode);
+
+	void BlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
+
+	void BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+
+	void EnableVertexAttribArray(GLint location, GLuint divisor);
+
+	//! the attribute is disabled by next FlushVertexAttribArrays unless it is enabled again
+	void DisableVertexAttribArray(GLint location);
+
+	//! disable attributes which are not enabled again. It must be called before drawing.
+	void FlushVertexAttribArrays();
+
+	//! disable all attributes which are enabled with this cache
+	void ResetVertexAttribArrays();
+
+	void OnBufferDeleted(GLuint buffer);
+
+	void OnTextureDeleted(GLuint texture);
+
+	void OnSamplerDeleted(GLuint sampler);
+
+	void OnProgramDeleted(GLuint program);
+};
+
 class VertexArrayObject
 {
 private:
@@ -248,9 +454,15 @@ private:
 	Effekseer::CustomVector<GLint> textureLocations_;
 	Effekseer::CustomVector<GLint> uniformLocations_;
 
+	//! texture units which are assigned to samplers of the program
+	Effekseer::CustomVector<GLint> textureUnits_;
+
 	bool Compile();
 	void Reset();
 
+	//! get locations of uniforms after the program is linked or loaded
+	void UpdateLocations();
+
 public:
 	Shader(GraphicsDevice* graphicsDevice);
 	~Shader() override;
@@ -267,6 +479,9 @@ public:
 	const Effekseer::CustomVector<GLint>& GetTextureLocations() const;
 
 	const Effekseer::CustomVector<GLint>& GetUniformLocations() const;
+
+	//! assign a texture unit to a sampler unless it has been assigned. The program must be in use.
+	void SetTextureUnit(int32_t index, GLint unit);
 };
 
 class PipelineState
@@ -321,6 +536,24 @@ public:
 	}
 };
 
+class Fence
+	: public Effekseer::Backend::Fence
+{
+private:
+	void* sync_ = nullptr;
+	bool isCompleted_ = false;
+
+public:
+	Fence() = default;
+	~Fence() override;
+
+	bool Init();
+
+	bool IsCompleted() override;
+
+	bool Wait(uint64_t timeoutNanoseconds) override;
+};
+
 enum class DevicePropertyType
 {
 	MaxVaryingVectors,
@@ -340,11 +573,17 @@ private:
 	std::set<DeviceObject*> objects_;
 	OpenGLDeviceType deviceType_;
 	std::array<GLuint, Effekseer::TextureSlotMax> samplers_;
-	std::unique_ptr<VertexArrayObject> vao_;
+	StateCache stateCache_;
 	GLuint frameBufferTemp_ = 0;
 	std::map<DevicePropertyType, int> properties_;
 	bool isValid_ = true;
 
+	Effekseer::FileInterfaceRef programBinaryFileInterface_;
+	std::u16string programBinaryCacheDirectory_;
+	std::string driverIdentity_;
+	std::string driverRenderer_;
+	std::string driverVersion_;
+
 public:
 	GraphicsDevice(OpenGLDeviceType deviceType, bool isExtensionsEnabled = true);
 
@@ -360,6 +599,8 @@ public:
 
 	OpenGLDeviceType GetDeviceType() const;
 
+	StateCache& GetStateCache();
+
 	void Register(DeviceObject* deviceObject);
 
 	void Unregister(DeviceObject* deviceObject);
@@ -388,6 +629,8 @@ public:
 
 	Effekseer::Backend::PipelineStateRef CreatePipelineState(const Effekseer::Backend::PipelineStateParameter& param) override;
 
+	Effekseer::Backend::FenceRef CreateFence() override;
+
 	void Draw(const Effekseer::Backend::DrawParameter& drawParam) override;
 
 	void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height) override;
@@ -404,6 +647,26 @@ public:
 	}
 
 	Effekseer::Backend::TextureRef CreateTexture(GLuint buffer, bool hasMipmap, const std::function<void()>& onDisposed);
+
+	/**
+		@brief	Specify a directory to store linked programs. The cache is disabled if the directory is empty.
+	*/
+	void SetProgramBinaryCacheDirectory(const char16_t* directory, Effekseer::FileInterfaceRef fileInterface);
+
+	bool GetIsProgramBinaryCacheEnabled() const;
+
+	/**
+		@brief	Calculate a key of a program from codes and the driver. A material and its shader type are identified with their generated codes.
+	*/
+	uint64_t CalculateProgramBinaryKey(const Effekseer::CustomVector<Effekseer::CustomString<char>>& vsCodes, const Effekseer::CustomVector<Effekseer::CustomString<char>>& psCodes) const;
+
+	/**
+		@brief	Load a cached binary into the program and return true if the program is linked.
+		@note	A binary is rejected if the renderer, the version or the length of codes which are stored with it are different.
+	*/
+	bool LoadProgramBinary(uint64_t key, uint64_t sourceLength, GLuint program);
+
+	void SaveProgramBinary(uint64_t key, uint64_t sourceLength, GLuint program);
 };
 
 } // namespace Backend
@@ -0,0 +1,180 @@
+#if !defined(__EMSCRIPTEN__)
+static const char sprite_instanced_unlit_vs_gl3[] = R"(#version 330
+#ifdef GL_ARB_shading_language_420pack
+#extension GL_ARB_shading_language_420pack : require
+#endif
+
+struct VS_Input
+{
+    vec3 Pos;
+    vec4 Color;
+    vec2 Rotation;
+    vec4 UV;
+    vec4 Extent;
+    int VertexID;
+};
+
+struct VS_Output
+{
+    vec4 PosVS;
+    vec4 Color;
+    vec2 UV;
+    vec4 PosP;
+};
+
+struct VS_ConstantBuffer
+{
+    mat4 mCamera;
+    mat4 mCameraProj;
+    vec4 mUVInversed;
+    vec4 mBillboardRight;
+    vec4 mBillboardUp;
+};
+
+uniform VS_ConstantBuffer CBVS0;
+
+layout(location = 0) in vec3 Input_Pos;
+layout(location = 1) in vec4 Input_Color;
+layout(location = 2) in vec2 Input_Rotation;
+layout(location = 3) in vec4 Input_UV;
+layout(location = 4) in vec4 Input_Extent;
+centroid out vec4 _VSPS_Color;
+centroid out vec2 _VSPS_UV;
+out vec4 _VSPS_PosP;
+
+VS_Output _main(VS_Input Input)
+{
+    VS_Output Output = VS_Output(vec4(0.0), vec4(0.0), vec2(0.0), vec4(0.0));
+
+    // lower left, lower right, upper left, upper right
+    bool isRight = (Input.VertexID & 1) != 0;
+    bool isUpper = (Input.VertexID & 2) != 0;
+
+    vec3 axisX = CBVS0.mBillboardRight.xyz * Input.Rotation.x + CBVS0.mBillboardUp.xyz * Input.Rotation.y;
+    vec3 axisY = CBVS0.mBillboardUp.xyz * Input.Rotation.x - CBVS0.mBillboardRight.xyz * Input.Rotation.y;
+    float x = isRight ? Input.Extent.z : Input.Extent.x;
+    float y = isUpper ? Input.Extent.w : Input.Extent.y;
+
+    vec4 worldPos = vec4(Input.Pos + axisX * x + axisY * y, 1.0);
+    Output.PosVS = worldPos * CBVS0.mCameraProj;
+    Output.Color = Input.Color;
+    vec2 uv1 = vec2(isRight ? Input.UV.z : Input.UV.x, isUpper ? Input.UV.y : Input.UV.w);
+    uv1.y = CBVS0.mUVInversed.x + (CBVS0.mUVInversed.y * uv1.y);
+    Output.UV = uv1;
+    Output.PosP = Output.PosVS;
+    return Output;
+}
+
+void main()
+{
+    VS_Input Input;
+    Input.Pos = Input_Pos;
+    Input.Color = Input_Color;
+    Input.Rotation = Input_Rotation;
+    Input.UV = Input_UV;
+    Input.Extent = Input_Extent;
+    Input.VertexID = gl_VertexID;
+    VS_Output flattenTemp = _main(Input);
+    gl_Position = flattenTemp.PosVS;
+    _VSPS_Color = flattenTemp.Color;
+    _VSPS_UV = flattenTemp.UV;
+    _VSPS_PosP = flattenTemp.PosP;
+}
+
+)";
+
+#endif
+
+static const char sprite_instanced_unlit_vs_gles3[] = R"(#version 300 es
+
+struct VS_Input
+{
+    vec3 Pos;
+    vec4 Color;
+    vec2 Rotation;
+    vec4 UV;
+    vec4 Extent;
+    int VertexID;
+};
+
+struct VS_Output
+{
+    vec4 PosVS;
+    vec4 Color;
+    vec2 UV;
+    vec4 PosP;
+};
+
+struct VS_ConstantBuffer
+{
+    mat4 mCamera;
+    mat4 mCameraProj;
+    vec4 mUVInversed;
+    vec4 mBillboardRight;
+    vec4 mBillboardUp;
+};
+
+uniform VS_ConstantBuffer CBVS0;
+
+layout(location = 0) in vec3 Input_Pos;
+layout(location = 1) in vec4 Input_Color;
+layout(location = 2) in vec2 Input_Rotation;
+layout(location = 3) in vec4 Input_UV;
+layout(location = 4) in vec4 Input_Extent;
+centroid out vec4 _VSPS_Color;
+centroid out vec2 _VSPS_UV;
+out vec4 _VSPS_PosP;
+
+VS_Output _main(VS_Input Input)
+{
+    VS_Output Output = VS_Output(vec4(0.0), vec4(0.0), vec2(0.0), vec4(0.0));
+
+    // lower left, lower right, upper left, upper right
+    bool isRight = (Input.VertexID & 1) != 0;
+    bool isUpper = (Input.VertexID & 2) != 0;
+
+    vec3 axisX = CBVS0.mBillboardRight.xyz * Input.Rotation.x + CBVS0.mBillboardUp.xyz * Input.Rotation.y;
+    vec3 axisY = CBVS0.mBillboardUp.xyz * Input.Rotation.x - CBVS0.mBillboardRight.xyz * Input.Rotation.y;
+    float x = isRight ? Input.Extent.z : Input.Extent.x;
+    float y = isUpper ? Input.Extent.w : Input.Extent.y;
+
+    vec4 worldPos = vec4(Input.Pos + axisX * x + axisY * y, 1.0);
+    Output.PosVS = worldPos * CBVS0.mCameraProj;
+    Output.Color = Input.Color;
+    vec2 uv1 = vec2(isRight ? Input.UV.z : Input.UV.x, isUpper ? Input.UV.y : Input.UV.w);
+    uv1.y = CBVS0.mUVInversed.x + (CBVS0.mUVInversed.y * uv1.y);
+    Output.UV = uv1;
+    Output.PosP = Output.PosVS;
+    return Output;
+}
+
+void main()
+{
+    VS_Input Input;
+    Input.Pos = Input_Pos;
+    Input.Color = Input_Color;
+    Input.Rotation = Input_Rotation;
+    Input.UV = Input_UV;
+    Input.Extent = Input_Extent;
+    Input.VertexID = gl_VertexID;
+    VS_Output flattenTemp = _main(Input);
+    gl_Position = flattenTemp.PosVS;
+    _VSPS_Color = flattenTemp.Color;
+    _VSPS_UV = flattenTemp.UV;
+    _VSPS_PosP = flattenTemp.PosP;
+}
+
+)";
+
+
+    static const char* get_sprite_instanced_unlit_vs (EffekseerRendererGL::OpenGLDeviceType deviceType)
+    {
+    #if !defined(__EMSCRIPTEN__)
+        if (deviceType == EffekseerRendererGL::OpenGLDeviceType::OpenGL3)
+            return sprite_instanced_unlit_vs_gl3;
+    #endif
+        if (deviceType == EffekseerRendererGL::OpenGLDeviceType::OpenGLES3)
+            return sprite_instanced_unlit_vs_gles3;
+        return nullptr;
+    }
+    
\ No newline at end of file
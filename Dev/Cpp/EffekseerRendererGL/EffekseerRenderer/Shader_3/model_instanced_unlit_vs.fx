@@ -0,0 +1,90 @@
+#version 330
+#ifdef GL_ARB_shading_language_420pack
+#extension GL_ARB_shading_language_420pack : require
+#endif
+
+struct VS_Input
+{
+    vec3 Pos;
+    vec3 Normal;
+    vec3 Binormal;
+    vec3 Tangent;
+    vec2 UV;
+    vec4 Color;
+    vec4 Model0;
+    vec4 Model1;
+    vec4 Model2;
+    vec4 ModelUV;
+    vec4 ModelColor;
+};
+
+struct VS_Output
+{
+    vec4 PosVS;
+    vec4 Color;
+    vec2 UV;
+    vec4 PosP;
+};
+
+struct VS_ConstantBuffer
+{
+    mat4 mCameraProj;
+    vec4 mUVInversed;
+};
+
+uniform VS_ConstantBuffer CBVS0;
+
+layout(location = 0) in vec3 Input_Pos;
+layout(location = 1) in vec3 Input_Normal;
+layout(location = 2) in vec3 Input_Binormal;
+layout(location = 3) in vec3 Input_Tangent;
+layout(location = 4) in vec2 Input_UV;
+layout(location = 5) in vec4 Input_Color;
+layout(location = 6) in vec4 Input_Model0;
+layout(location = 7) in vec4 Input_Model1;
+layout(location = 8) in vec4 Input_Model2;
+layout(location = 9) in vec4 Input_ModelUV;
+layout(location = 10) in vec4 Input_ModelColor;
+centroid out vec4 _VSPS_Color;
+centroid out vec2 _VSPS_UV;
+out vec4 _VSPS_PosP;
+
+VS_Output _main(VS_Input Input)
+{
+    vec4 uv = Input.ModelUV;
+    vec4 modelColor = Input.ModelColor * Input.Color;
+    VS_Output Output = VS_Output(vec4(0.0), vec4(0.0), vec2(0.0), vec4(0.0));
+    vec4 localPos = vec4(Input.Pos.x, Input.Pos.y, Input.Pos.z, 1.0);
+    vec4 worldPos = vec4(dot(localPos, Input.Model0), dot(localPos, Input.Model1), dot(localPos, Input.Model2), 1.0);
+    Output.PosVS = worldPos * CBVS0.mCameraProj;
+    Output.Color = modelColor;
+    vec2 outputUV = Input.UV;
+    outputUV.x = (outputUV.x * uv.z) + uv.x;
+    outputUV.y = (outputUV.y * uv.w) + uv.y;
+    outputUV.y = CBVS0.mUVInversed.x + (CBVS0.mUVInversed.y * outputUV.y);
+    Output.UV = outputUV;
+    Output.PosP = Output.PosVS;
+    return Output;
+}
+
+void main()
+{
+    VS_Input Input;
+    Input.Pos = Input_Pos;
+    Input.Normal = Input_Normal;
+    Input.Binormal = Input_Binormal;
+    Input.Tangent = Input_Tangent;
+    Input.UV = Input_UV;
+    Input.Color = Input_Color;
+    Input.Model0 = Input_Model0;
+    Input.Model1 = Input_Model1;
+    Input.Model2 = Input_Model2;
+    Input.ModelUV = Input_ModelUV;
+    Input.ModelColor = Input_ModelColor;
+    VS_Output flattenTemp = _main(Input);
+    gl_Position = flattenTemp.PosVS;
+    _VSPS_Color = flattenTemp.Color;
+    _VSPS_UV = flattenTemp.UV;
+    _VSPS_PosP = flattenTemp.PosP;
+}
+
@@ -4,6 +4,9 @@ import sys
 verts = ['ad_sprite_unlit_vs', 'ad_sprite_lit_vs', 'ad_sprite_distortion_vs', 'ad_model_unlit_vs',  'ad_model_lit_vs', 'ad_model_distortion_vs',
          'sprite_unlit_vs', 'sprite_lit_vs', 'sprite_distortion_vs', 'model_unlit_vs',  'model_lit_vs', 'model_distortion_vs']
 
+# shaders which require OpenGL 3 or OpenGL ES 3
+verts_3 = ['sprite_instanced_unlit_vs', 'model_instanced_unlit_vs']
+
 frags = ['ad_model_unlit_ps',  'ad_model_lit_ps', 'ad_model_distortion_ps', 'model_unlit_ps',  'model_lit_ps', 'model_distortion_ps']
 
 
@@ -87,3 +90,36 @@ for fx in verts + frags:
 
     f = open(gl_dst_path + fx + '.h', 'w')
     f.write(code)
+
+for fx in verts_3:
+    f_gl_3 = open(gl_3_root_path + fx + '.fx', 'r')
+    gl_3 = replace_3(f_gl_3.read())
+
+    f_gl_es3 = open(gl_es3_root_path + fx + '.fx', 'r')
+    gl_es3 = f_gl_es3.read()
+
+    code = '#if !defined(__EMSCRIPTEN__)\n'
+    code += 'static const char {}_{}[] = R"('.format(fx, 'gl3')
+    code += gl_3
+    code += ')";\n\n'
+    code += '#endif\n\n'
+
+    code += 'static const char {}_{}[] = R"('.format(fx, 'gles3')
+    code += gl_es3
+    code += ')";\n\n'
+
+    code += r'''
+    static const char* get_{} (EffekseerRendererGL::OpenGLDeviceType deviceType)
+    {{
+    #if !defined(__EMSCRIPTEN__)
+        if (deviceType == EffekseerRendererGL::OpenGLDeviceType::OpenGL3)
+            return {}_{};
+    #endif
+        if (deviceType == EffekseerRendererGL::OpenGLDeviceType::OpenGLES3)
+            return {}_{};
+        return nullptr;
+    }}
+    '''.format(fx, fx, 'gl3', fx, 'gles3')
+
+    f = open(gl_dst_path + fx + '.h', 'w')
+    f.write(code)
@@ -531,6 +531,7 @@ bool RendererImplemented::EndRendering()
 
 	// reset renderer
 	m_standardRenderer->ResetAndRenderingIfRequired();
+	m_standardRenderer->ClearStates();
 
 	currentndexBuffer_ = nullptr;
 
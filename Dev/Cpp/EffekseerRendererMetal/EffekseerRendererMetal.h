@@ -352,6 +352,55 @@ public:
 	*/
 	virtual void ResetDrawVertexCount();
 
+	/**
+	@brief
+	\~english Get the size of vertices in bytes which are copied through a staging buffer before they are uploaded. It is 0 if vertices are written into a vertex buffer directly.
+	\~japanese アップロードされる前にステージングバッファを経由してコピーされた頂点のバイト数を取得する。頂点が直接頂点バッファに書き込まれる場合は0になる。
+	*/
+	virtual int32_t GetStagingVertexSize() const;
+
+	/**
+	@brief
+	\~english Reset the size of vertices which are copied through a staging buffer
+	\~japanese ステージングバッファを経由してコピーされた頂点のバイト数をリセットする
+	*/
+	virtual void ResetStagingVertexSize();
+
+	/**
+	@brief
+	\~english Get the size of vertices in bytes which are uploaded into vertex buffers. It can be used to decide squareMaxCount if it is reset every frame.
+	\~japanese 頂点バッファにアップロードされた頂点のバイト数を取得する。毎フレームリセットすると、squareMaxCountを決めるのに使用できる。
+	*/
+	virtual int32_t GetVertexBufferUsedSize() const;
+
+	/**
+	@brief
+	\~english Reset the size of vertices which are uploaded into vertex buffers
+	\~japanese 頂点バッファにアップロードされた頂点のバイト数をリセットする
+	*/
+	virtual void ResetVertexBufferUsedSize();
+
+	/**
+	@brief
+	\~english Get the number of squares which are not drawn because vertex buffers are not enough
+	\~japanese 頂点バッファが足りないために描画されなかった四角形の数を取得する
+	*/
+	virtual int32_t GetDroppedSquareCount() const;
+
+	/**
+	@brief
+	\~english Get the maximum number of squares which a node requires at once. If squareMaxCount is larger than it, no square is dropped.
+	\~japanese ノードが一度に必要とする四角形の最大数を取得する。squareMaxCountがこれより大きい場合、四角形は描画されなくなることはない。
+	*/
+	virtual int32_t GetRequiredSquareMaxCount() const;
+
+	/**
+	@brief
+	\~english Reset the number of dropped squares and the maximum number of required squares
+	\~japanese 描画されなかった四角形の数と必要な四角形の最大数をリセットする
+	*/
+	virtual void ResetDroppedSquareCount();
+
 	/**
 	@brief
 	\~english Get a render mode.
@@ -468,6 +517,96 @@ public:
 	*/
 	virtual void SetMaintainGammaColorInLinearColorSpace(bool value);
 
+	/**
+		@brief
+		\~English	Get whether sprites, ribbons, rings and tracks are sorted by states to reduce draw calls
+		\~Japanese	描画回数を減らすためにスプライト、リボン、リング、軌跡がステートでソートされるか、を取得する。
+	*/
+	virtual bool GetIsStateSortingEnabled() const;
+
+	/**
+		@brief
+		\~English	Specify whether sprites, ribbons, rings and tracks are sorted by states to reduce draw calls
+		\~Japanese	描画回数を減らすためにスプライト、リボン、リング、軌跡がステートでソートされるか、を設定する。
+		@note
+		\~English	Only batches whose order doesn't change a result are reordered. For example, additive batches without a depth write are reordered but alpha blended batches are not.
+		\~Japanese	順番が結果を変えない描画のみが並び替えられる。例えば、深度書き込みのない加算の描画は並び替えられるが、アルファブレンドの描画は並び替えられない。
+	*/
+	virtual void SetIsStateSortingEnabled(bool value);
+
+	/**
+		@brief
+		\~English	Get whether compact vertices are supported by this renderer
+		\~Japanese	この描画クラスでコンパクトな頂点がサポートされているか、を取得する。
+	*/
+	virtual bool GetIsCompactVertexSupported() const;
+
+	/**
+		@brief
+		\~English	Get whether compact vertices are used for sprites, ribbons, rings and tracks
+		\~Japanese	スプライト、リボン、リング、軌跡にコンパクトな頂点が使用されるか、を取得する。
+	*/
+	virtual bool GetIsCompactVertexEnabled() const;
+
+	/**
+		@brief
+		\~English	Specify whether compact vertices are used for sprites, ribbons, rings and tracks
+		\~Japanese	スプライト、リボン、リング、軌跡にコンパクトな頂点が使用されるか、を設定する。
+		@note
+		\~English	UVs are stored as half floats to reduce a bandwidth. UVs far from 0 lose precision. Materials are not affected. It is ignored if it is not supported.
+		\~Japanese	帯域を減らすためにUVが半精度浮動小数点数で保存される。0から離れたUVは精度が落ちる。マテリアルは影響を受けない。サポートされていない場合は無視される。
+	*/
+	virtual void SetIsCompactVertexEnabled(bool value);
+
+	/**
+		@brief
+		\~English	Get whether sprites can be expanded into quads on GPU by this renderer
+		\~Japanese	この描画クラスでスプライトをGPU上で四角形に展開できるか、を取得する。
+	*/
+	virtual bool GetIsInstancedSpriteSupported() const;
+
+	/**
+		@brief
+		\~English	Get whether sprites are expanded into quads on GPU
+		\~Japanese	スプライトがGPU上で四角形に展開されるか、を取得する。
+	*/
+	virtual bool GetIsInstancedSpriteEnabled() const;
+
+	/**
+		@brief
+		\~English	Specify whether sprites are expanded into quads on GPU
+		\~Japanese	スプライトがGPU上で四角形に展開されるか、を設定する。
+		@note
+		\~English
+		One record per sprite is uploaded instead of four vertices. It is applied to unlit sprites whose billboard type is Billboard or RotatedBillboard,
+		whose corners have the same color and form a rectangle. Other sprites are expanded on CPU. It is ignored if it is not supported.
+		\~Japanese
+		4頂点の代わりにスプライトごとに1つのデータが転送される。ビルボードの種類がBillboardかRotatedBillboardで、頂点の色が同じで、頂点が長方形を成す、ライティングなしのスプライトに適用される。
+		その他のスプライトはCPUで展開される。サポートされていない場合は無視される。
+	*/
+	virtual void SetIsInstancedSpriteEnabled(bool value);
+
+	/**
+		@brief
+		\~English	Get the number of worker threads which generate vertices
+		\~Japanese	頂点を生成するワーカースレッドの数を取得する。
+	*/
+	virtual int32_t GetVertexGenerationThreadCount() const;
+
+	/**
+		@brief
+		\~English	Specify the number of worker threads which generate vertices
+		\~Japanese	頂点を生成するワーカースレッドの数を設定する。
+		@note
+		\~English
+		Vertices of sprites and rings of a node are generated on worker threads and the rendering thread when the node has many instances.
+		Results are same as results without worker threads. If it is 0, vertices are generated only on the rendering thread.
+		\~Japanese
+		ノードのインスタンスが多い場合、スプライトとリングの頂点がワーカースレッドと描画スレッドで生成される。
+		結果はワーカースレッドがない場合と同じになる。0の場合、描画スレッドでのみ頂点が生成される。
+	*/
+	virtual void SetVertexGenerationThreadCount(int32_t count);
+
 	/**
 		@brief	
 		\~English	Get the graphics device
@@ -510,6 +649,72 @@ namespace EffekseerRenderer
 												  ::Effekseer::FileInterfaceRef fileInterface = nullptr,
 												  ::Effekseer::ColorSpaceType colorSpaceType = ::Effekseer::ColorSpaceType::Gamma);
 
+/**
+	@brief
+	\~English	A texture loader which reads and decodes textures on worker threads and creates them on GPU in Update
+	\~Japanese	ワーカースレッドでテクスチャを読み込んでデコードし、UpdateでGPU上に生成するテクスチャローダー
+	@note
+	\~English
+	Load returns a texture immediately. Its backend is null until it is created in Update, so it is drawn as no texture until then.
+	Update must be called on a thread which can use the graphics device, for example once per frame before rendering.
+	Files are opened and read with the FileInterface on worker threads, so the FileInterface must be thread safe.
+	If it is not, read files on the calling thread and load them with Load(data, size, ...).
+	\~Japanese
+	Loadはテクスチャを即座に返す。Updateで生成されるまでバックエンドはnullであり、それまではテクスチャ無しとして描画される。
+	Updateはグラフィックスデバイスを使用できるスレッドで、例えば毎フレーム描画前に呼ぶ必要がある。
+	ファイルはワーカースレッドでFileInterfaceにより開かれ読み込まれるため、FileInterfaceはスレッドセーフである必要がある。
+	そうでない場合、呼び出し元のスレッドでファイルを読み込み、Load(data, size, ...)で読み込むこと。
+*/
+class StreamingTextureLoader : public ::Effekseer::TextureLoader
+{
+public:
+	StreamingTextureLoader() = default;
+
+	virtual ~StreamingTextureLoader() override = default;
+
+	/**
+		@brief
+		\~English	Create decoded textures on GPU until the total size of created textures reaches byteBudget
+		\~Japanese	生成されたテクスチャの合計サイズがbyteBudgetに達するまで、デコードされたテクスチャをGPU上に生成する。
+		@param	byteBudget
+		\~English	the size of textures which are created in this call. At least one texture is created. If it is 0 or less, all decoded textures are created.
+		\~Japanese	この呼び出しで生成されるテクスチャのサイズ。少なくとも1つのテクスチャが生成される。0以下の場合、デコードされた全てのテクスチャが生成される。
+		@return
+		\~English	the number of created textures
+		\~Japanese	生成されたテクスチャの数
+	*/
+	virtual int32_t Update(int32_t byteBudget) = 0;
+
+	/**
+		@brief
+		\~English	Wait until all requested textures are decoded and create them on GPU
+		\~Japanese	要求された全てのテクスチャのデコードを待ち、GPU上に生成する。
+	*/
+	virtual void Flush() = 0;
+
+	/**
+		@brief
+		\~English	Get the number of requested textures which are not created yet
+		\~Japanese	要求されたテクスチャのうち、まだ生成されていないものの数を取得する。
+	*/
+	virtual int32_t GetPendingCount() const = 0;
+};
+
+using StreamingTextureLoaderRef = ::Effekseer::RefPtr<StreamingTextureLoader>;
+
+/**
+	@param	fileInterface
+	\~English	an interface to read files on worker threads. It must be thread safe. If it is null, the default one is used.
+	\~Japanese	ワーカースレッドでファイルを読み込むインターフェース。スレッドセーフである必要がある。nullの場合、デフォルトのものが使用される。
+	@param	threadCount
+	\~English	the number of worker threads. If it is 0 or less, the number is decided by the hardware.
+	\~Japanese	ワーカースレッドの数。0以下の場合、ハードウェアに応じて決定される。
+*/
+StreamingTextureLoaderRef CreateStreamingTextureLoader(::Effekseer::Backend::GraphicsDeviceRef graphicsDevice,
+													   ::Effekseer::FileInterfaceRef fileInterface = nullptr,
+													   ::Effekseer::ColorSpaceType colorSpaceType = ::Effekseer::ColorSpaceType::Gamma,
+													   int32_t threadCount = 0);
+
 } // namespace EffekseerRenderer
 
 #endif // __EFFEKSEERRENDERER_TEXTURELOADER_H__
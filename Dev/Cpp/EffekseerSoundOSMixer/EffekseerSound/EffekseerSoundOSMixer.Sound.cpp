@@ -10,10 +10,10 @@
 namespace EffekseerSound
 {
 
-SoundRef Sound::Create(osm::Manager* soundManager)
+SoundRef Sound::Create(osm::Manager* soundManager, int32_t voiceCount)
 {
 	auto sound = Effekseer::MakeRefPtr<SoundImplemented>();
-	if (sound->Initialize(soundManager))
+	if (sound->Initialize(soundManager, voiceCount))
 	{
 		return sound;
 	}
@@ -23,6 +23,7 @@ SoundRef Sound::Create(osm::Manager* soundManager)
 SoundImplemented::SoundImplemented()
 	: m_manager(nullptr)
 	, m_mute(false)
+	, m_bucketMask(0)
 {
 }
 
@@ -31,9 +32,32 @@ SoundImplemented::~SoundImplemented()
 	StopAll();
 }
 
-bool SoundImplemented::Initialize(osm::Manager* soundManager)
+bool SoundImplemented::Initialize(osm::Manager* soundManager, int32_t voiceCount)
 {
+	if (voiceCount <= 0)
+	{
+		return false;
+	}
+
 	m_manager = soundManager;
+	m_dataCache = std::unique_ptr<SoundDataCache>(new SoundDataCache(soundManager));
+
+	m_voices.resize(voiceCount);
+	m_freeVoices.reserve(voiceCount);
+	for (int32_t i = voiceCount - 1; i >= 0; i--)
+	{
+		m_freeVoices.push_back(i);
+	}
+
+	uint32_t bucketCount = 1;
+	while (bucketCount < static_cast<uint32_t>(voiceCount))
+	{
+		bucketCount *= 2;
+	}
+
+	m_tagBuckets.assign(bucketCount, -1);
+	m_dataBuckets.assign(bucketCount, -1);
+	m_bucketMask = bucketCount - 1;
 
 	return true;
 }
@@ -56,17 +80,7 @@ void SoundImplemented::Destroy()
 
 void SoundImplemented::Update()
 {
-	for (auto it = m_instances.begin(); it != m_instances.end();)
-	{
-		if (!m_manager->IsPlaying(it->id))
-		{
-			it = m_instances.erase(it);
-		}
-		else
-		{
-			it++;
-		}
-	}
+	ReleaseStoppedVoices();
 }
 
 ::Effekseer::SoundPlayerRef SoundImplemented::CreateSoundPlayer()
@@ -89,35 +103,178 @@ void SoundImplemented::SetMute(bool mute)
 	m_mute = mute;
 }
 
-void SoundImplemented::AddInstance(const Instance& instance)
+void SoundImplemented::SetCacheBudget(size_t bytes)
+{
+	m_dataCache->SetBudget(bytes);
+}
+
+void SoundImplemented::SetStreamingThreshold(size_t bytes)
+{
+	m_dataCache->SetStreamingThreshold(bytes);
+}
+
+uint32_t SoundImplemented::GetBucket(const void* key) const
+{
+	const auto value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+	return static_cast<uint32_t>(((value >> 4) * 0x9E3779B97F4A7C15ULL) >> 32) & m_bucketMask;
+}
+
+void SoundImplemented::LinkVoice(int32_t index)
+{
+	auto& voice = m_voices[index];
+
+	auto& tagHead = m_tagBuckets[GetBucket(voice.tag)];
+	voice.tagPrev = -1;
+	voice.tagNext = tagHead;
+	if (tagHead >= 0)
+	{
+		m_voices[tagHead].tagPrev = index;
+	}
+	tagHead = index;
+
+	auto& dataHead = m_dataBuckets[GetBucket(voice.data.Get())];
+	voice.dataPrev = -1;
+	voice.dataNext = dataHead;
+	if (dataHead >= 0)
+	{
+		m_voices[dataHead].dataPrev = index;
+	}
+	dataHead = index;
+}
+
+void SoundImplemented::UnlinkVoice(int32_t index)
+{
+	auto& voice = m_voices[index];
+
+	if (voice.tagPrev >= 0)
+	{
+		m_voices[voice.tagPrev].tagNext = voice.tagNext;
+	}
+	else
+	{
+		m_tagBuckets[GetBucket(voice.tag)] = voice.tagNext;
+	}
+
+	if (voice.tagNext >= 0)
+	{
+		m_voices[voice.tagNext].tagPrev = voice.tagPrev;
+	}
+
+	if (voice.dataPrev >= 0)
+	{
+		m_voices[voice.dataPrev].dataNext = voice.dataNext;
+	}
+	else
+	{
+		m_dataBuckets[GetBucket(voice.data.Get())] = voice.dataNext;
+	}
+
+	if (voice.dataNext >= 0)
+	{
+		m_voices[voice.dataNext].dataPrev = voice.dataPrev;
+	}
+
+	voice.tagPrev = voice.tagNext = -1;
+	voice.dataPrev = voice.dataNext = -1;
+}
+
+void SoundImplemented::ReleaseVoice(int32_t index)
+{
+	UnlinkVoice(index);
+
+	auto& voice = m_voices[index];
+	voice.id = -1;
+	voice.tag = nullptr;
+	voice.data.Reset();
+	voice.priority = 0.0f;
+
+	m_freeVoices.push_back(index);
+}
+
+void SoundImplemented::ReleaseStoppedVoices()
+{
+	for (int32_t i = 0; i < static_cast<int32_t>(m_voices.size()); i++)
+	{
+		if (m_voices[i].id >= 0 && !m_manager->IsPlaying(m_voices[i].id))
+		{
+			ReleaseVoice(i);
+		}
+	}
+}
+
+int32_t SoundImplemented::AcquireVoice(float priority)
+{
+	if (m_freeVoices.empty())
+	{
+		ReleaseStoppedVoices();
+	}
+
+	if (m_freeVoices.empty())
+	{
+		// steal the quietest voice
+		int32_t stolen = -1;
+		for (int32_t i = 0; i < static_cast<int32_t>(m_voices.size()); i++)
+		{
+			if (stolen < 0 || m_voices[i].priority < m_voices[stolen].priority)
+			{
+				stolen = i;
+			}
+		}
+
+		if (stolen < 0 || m_voices[stolen].priority >= priority)
+		{
+			return -1;
+		}
+
+		m_manager->Stop(m_voices[stolen].id);
+		ReleaseVoice(stolen);
+	}
+
+	const auto index = m_freeVoices.back();
+	m_freeVoices.pop_back();
+	m_voices[index].priority = priority;
+	return index;
+}
+
+void SoundImplemented::StartVoice(int32_t index, int32_t id, ::Effekseer::SoundTag tag, const ::Effekseer::SoundDataRef& data)
+{
+	auto& voice = m_voices[index];
+	voice.id = id;
+	voice.tag = tag;
+	voice.data = data;
+	LinkVoice(index);
+}
+
+void SoundImplemented::CancelVoice(int32_t index)
 {
-	m_instances.push_back(instance);
+	m_voices[index].priority = 0.0f;
+	m_freeVoices.push_back(index);
 }
 
 void SoundImplemented::StopTag(::Effekseer::SoundTag tag)
 {
-	for (auto it = m_instances.begin(); it != m_instances.end(); it++)
+	for (int32_t i = m_tagBuckets[GetBucket(tag)]; i >= 0; i = m_voices[i].tagNext)
 	{
-		if (it->tag == tag)
+		if (m_voices[i].tag == tag)
 		{
-			m_manager->Stop(it->id);
+			m_manager->Stop(m_voices[i].id);
 		}
 	}
 }
 
 void SoundImplemented::PauseTag(::Effekseer::SoundTag tag, bool pause)
 {
-	for (auto it = m_instances.begin(); it != m_instances.end(); it++)
+	for (int32_t i = m_tagBuckets[GetBucket(tag)]; i >= 0; i = m_voices[i].tagNext)
 	{
-		if (it->tag == tag)
+		if (m_voices[i].tag == tag)
 		{
 			if (pause)
 			{
-				m_manager->Pause(it->id);
+				m_manager->Pause(m_voices[i].id);
 			}
 			else
 			{
-				m_manager->Resume(it->id);
+				m_manager->Resume(m_voices[i].id);
 			}
 		}
 	}
@@ -125,24 +282,23 @@ void SoundImplemented::PauseTag(::Effekseer::SoundTag tag, bool pause)
 
 bool SoundImplemented::CheckPlayingTag(::Effekseer::SoundTag tag)
 {
-	bool isPlaying = false;
-	for (auto it = m_instances.begin(); it != m_instances.end(); it++)
+	for (int32_t i = m_tagBuckets[GetBucket(tag)]; i >= 0; i = m_voices[i].tagNext)
 	{
-		if (it->tag == tag)
+		if (m_voices[i].tag == tag && m_manager->IsPlaying(m_voices[i].id))
 		{
-			isPlaying |= m_manager->IsPlaying(it->id);
+			return true;
 		}
 	}
-	return isPlaying;
+	return false;
 }
 
 void SoundImplemented::StopData(const ::Effekseer::SoundDataRef& soundData)
 {
-	for (auto it = m_instances.begin(); it != m_instances.end(); it++)
+	for (int32_t i = m_dataBuckets[GetBucket(soundData.Get())]; i >= 0; i = m_voices[i].dataNext)
 	{
-		if (it->data == soundData)
+		if (m_voices[i].data == soundData)
 		{
-			m_manager->Stop(it->id);
+			m_manager->Stop(m_voices[i].id);
 		}
 	}
 }
@@ -0,0 +1,166 @@
+﻿#include "EffekseerSoundOSMixer.SoundDataCache.h"
+#include <Effekseer.h>
+#include <string.h>
+
+namespace EffekseerSound
+{
+
+SoundDataCache::Key SoundDataCache::CalculateKey(const void* data, int32_t size)
+{
+	Key key;
+	key.hash = Effekseer::CalculateHash(data, static_cast<size_t>(size));
+	key.size = size;
+	return key;
+}
+
+size_t SoundDataCache::EstimateDecodedSize(const void* data, int32_t size)
+{
+	// Only RIFF WAVE describes the size of samples in its header.
+	// The size of the file is used for other formats.
+	const auto bytes = static_cast<const uint8_t*>(data);
+	if (size < 12 || memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "WAVE", 4) != 0)
+	{
+		return static_cast<size_t>(size);
+	}
+
+	int32_t offset = 12;
+	while (offset + 8 <= size)
+	{
+		uint32_t chunkSize = 0;
+		memcpy(&chunkSize, bytes + offset + 4, sizeof(uint32_t));
+
+		if (memcmp(bytes + offset, "data", 4) == 0)
+		{
+			return static_cast<size_t>(chunkSize);
+		}
+
+		// chunks are aligned to 2 bytes
+		const int64_t next = static_cast<int64_t>(offset) + 8 + chunkSize + (chunkSize & 1);
+		if (next > size)
+		{
+			break;
+		}
+		offset = static_cast<int32_t>(next);
+	}
+
+	return static_cast<size_t>(size);
+}
+
+void SoundDataCache::Evict()
+{
+	while (cachedBytes_ > budget_ && !unusedKeys_.empty())
+	{
+		auto oldest = entries_.find(unusedKeys_.front());
+		unusedKeys_.pop_front();
+
+		cachedBytes_ -= oldest->second.bytes;
+		keys_.erase(oldest->second.sound);
+		oldest->second.sound->Release();
+		entries_.erase(oldest);
+	}
+}
+
+SoundDataCache::SoundDataCache(osm::Manager* manager)
+	: manager_(manager)
+{
+}
+
+SoundDataCache::~SoundDataCache()
+{
+	for (auto& entry : entries_)
+	{
+		entry.second.sound->Release();
+	}
+}
+
+osm::Sound* SoundDataCache::Acquire(const void* data, int32_t size)
+{
+	const auto key = CalculateKey(data, size);
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = entries_.find(key);
+	if (it != entries_.end())
+	{
+		if (it->second.useCount == 0)
+		{
+			unusedKeys_.erase(it->second.unusedIt);
+		}
+
+		it->second.useCount++;
+		return it->second.sound;
+	}
+
+	const auto decodedSize = EstimateDecodedSize(data, size);
+	const bool isDecompressed = decodedSize <= streamingThreshold_;
+
+	osm::Sound* sound = manager_->CreateSound(data, size, isDecompressed);
+	if (sound == nullptr)
+	{
+		return nullptr;
+	}
+
+	Entry entry;
+	entry.sound = sound;
+	entry.useCount = 1;
+	entry.bytes = isDecompressed ? decodedSize : static_cast<size_t>(size);
+
+	cachedBytes_ += entry.bytes;
+	entries_.emplace(key, std::move(entry));
+	keys_.emplace(sound, key);
+
+	Evict();
+
+	return sound;
+}
+
+void SoundDataCache::Release(osm::Sound* sound)
+{
+	if (sound == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto key = keys_.find(sound);
+	if (key == keys_.end())
+	{
+		return;
+	}
+
+	auto it = entries_.find(key->second);
+	if (it == entries_.end() || it->second.useCount <= 0)
+	{
+		return;
+	}
+
+	it->second.useCount--;
+	if (it->second.useCount == 0)
+	{
+		it->second.unusedIt = unusedKeys_.insert(unusedKeys_.end(), it->first);
+	}
+
+	Evict();
+}
+
+void SoundDataCache::SetBudget(size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	budget_ = bytes;
+	Evict();
+}
+
+void SoundDataCache::SetStreamingThreshold(size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	streamingThreshold_ = bytes;
+}
+
+size_t SoundDataCache::GetCachedBytes()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return cachedBytes_;
+}
+
+} // namespace EffekseerSound
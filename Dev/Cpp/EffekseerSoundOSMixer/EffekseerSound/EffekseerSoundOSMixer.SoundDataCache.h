@@ -0,0 +1,101 @@
+﻿
+#ifndef __EFFEKSEERSOUND_SOUND_DATA_CACHE_H__
+#define __EFFEKSEERSOUND_SOUND_DATA_CACHE_H__
+
+#include <OpenSoundMixer.h>
+#include <list>
+#include <mutex>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace EffekseerSound
+{
+
+/**
+	@brief	A cache which shares OpenSoundMixer buffers among sound data with the same content
+	@note
+	Short clips are decoded once when they are loaded and their samples are shared.
+	Long clips are created without decompression as before, so OpenSoundMixer decodes them while playing.
+	Buffers which are not used by any sound data are kept until the cache exceeds its budget, and the least recently used one is released first.
+	Data is identified with a 64bit hash and its size without keeping a copy of it.
+*/
+class SoundDataCache
+{
+	struct Key
+	{
+		uint64_t hash = 0;
+		int32_t size = 0;
+
+		bool operator==(const Key& rhs) const
+		{
+			return hash == rhs.hash && size == rhs.size;
+		}
+
+		struct Hash
+		{
+			size_t operator()(const Key& key) const
+			{
+				return static_cast<size_t>(key.hash);
+			}
+		};
+	};
+
+	struct Entry
+	{
+		osm::Sound* sound = nullptr;
+		int32_t useCount = 0;
+		size_t bytes = 0;
+
+		//! a position in unusedKeys_ which is valid while useCount is 0
+		std::list<Key>::iterator unusedIt;
+	};
+
+	osm::Manager* manager_ = nullptr;
+	std::mutex mtx_;
+	std::unordered_map<Key, Entry, Key::Hash> entries_;
+	std::unordered_map<osm::Sound*, Key> keys_;
+
+	//! keys of entries which are not used, from the least recently used one
+	std::list<Key> unusedKeys_;
+
+	size_t budget_ = 32 * 1024 * 1024;
+	size_t streamingThreshold_ = 1024 * 1024;
+	size_t cachedBytes_ = 0;
+
+	static Key CalculateKey(const void* data, int32_t size);
+
+	static size_t EstimateDecodedSize(const void* data, int32_t size);
+
+	void Evict();
+
+public:
+	SoundDataCache(osm::Manager* manager);
+
+	~SoundDataCache();
+
+	/**
+		@brief	Get a buffer whose content is data. A buffer is created if it is not cached.
+		@note
+		A buffer must be returned with Release.
+	*/
+	osm::Sound* Acquire(const void* data, int32_t size);
+
+	void Release(osm::Sound* sound);
+
+	/**
+		@brief	Specify the number of bytes which the cache can keep
+	*/
+	void SetBudget(size_t bytes);
+
+	/**
+		@brief	Specify the number of decoded bytes above which a clip is decoded while playing
+	*/
+	void SetStreamingThreshold(size_t bytes);
+
+	size_t GetCachedBytes();
+};
+
+} // namespace EffekseerSound
+
+#endif // __EFFEKSEERSOUND_SOUND_DATA_CACHE_H__
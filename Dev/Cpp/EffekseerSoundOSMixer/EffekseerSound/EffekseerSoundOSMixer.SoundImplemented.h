@@ -6,7 +6,9 @@
 // Include
 //----------------------------------------------------------------------------------
 #include "../EffekseerSoundOSMixer.h"
+#include "EffekseerSoundOSMixer.SoundDataCache.h"
 #include <OpenSoundMixer.h>
+#include <memory>
 #include <vector>
 
 //----------------------------------------------------------------------------------
@@ -22,11 +24,25 @@ namespace EffekseerSound
 class SoundImplemented : public Sound, public Effekseer::ReferenceObject
 {
 public:
-	struct Instance
+	/**
+		@brief	A slot of the fixed-capacity voice pool
+	*/
+	struct Voice
 	{
-		int32_t id;
-		Effekseer::SoundTag tag;
+		int32_t id = -1;
+		Effekseer::SoundTag tag = nullptr;
 		Effekseer::SoundDataRef data;
+
+		//! an audible volume which is used to select a voice to be stolen
+		float priority = 0.0f;
+
+		//! links in a chain of a tag bucket
+		int32_t tagPrev = -1;
+		int32_t tagNext = -1;
+
+		//! links in a chain of a data bucket
+		int32_t dataPrev = -1;
+		int32_t dataNext = -1;
 	};
 
 	struct Listener
@@ -41,16 +57,38 @@ private:
 	osm::Manager* m_manager;
 	bool m_mute;
 
-	std::vector<Instance> m_instances;
+	//! all voices. They are allocated in Initialize only.
+	std::vector<Voice> m_voices;
+
+	//! indexes of unused voices
+	std::vector<int32_t> m_freeVoices;
+
+	//! heads of voice chains which are indexed by hashes of tags and data
+	std::vector<int32_t> m_tagBuckets;
+	std::vector<int32_t> m_dataBuckets;
+	uint32_t m_bucketMask;
+
 	Listener m_listener;
 
+	std::unique_ptr<SoundDataCache> m_dataCache;
+
+	uint32_t GetBucket(const void* key) const;
+
+	void LinkVoice(int32_t index);
+
+	void UnlinkVoice(int32_t index);
+
+	void ReleaseVoice(int32_t index);
+
+	void ReleaseStoppedVoices();
+
 public:
 	SoundImplemented();
 	virtual ~SoundImplemented();
 
 	void Destroy();
 
-	bool Initialize(osm::Manager* soundManager);
+	bool Initialize(osm::Manager* soundManager, int32_t voiceCount);
 
 	void SetListener(const ::Effekseer::Vector3D& pos,
 					 const ::Effekseer::Vector3D& at,
@@ -76,7 +114,33 @@ public:
 		return m_manager;
 	}
 
-	void AddInstance(const Instance& instance);
+	SoundDataCache* GetDataCache()
+	{
+		return m_dataCache.get();
+	}
+
+	void SetCacheBudget(size_t bytes) override;
+
+	void SetStreamingThreshold(size_t bytes) override;
+
+	/**
+		@brief	Reserve a voice to play a sound.
+		@param	priority	an audible volume of the sound
+		@return	an index of the voice or -1 if all voices are used by sounds which are louder than it
+		@note
+		The quietest voice is stopped and reused if all voices are used.
+	*/
+	int32_t AcquireVoice(float priority);
+
+	/**
+		@brief	Register a playing sound to a voice which is acquired by AcquireVoice.
+	*/
+	void StartVoice(int32_t index, int32_t id, ::Effekseer::SoundTag tag, const ::Effekseer::SoundDataRef& data);
+
+	/**
+		@brief	Return a voice which is acquired by AcquireVoice but not used.
+	*/
+	void CancelVoice(int32_t index);
 
 	void StopTag(::Effekseer::SoundTag tag);
 
@@ -39,7 +39,7 @@ SoundLoader::~SoundLoader()
 
 ::Effekseer::SoundDataRef SoundLoader::Load(const void* data, int32_t size)
 {
-	osm::Sound* osmSound = m_sound->GetDevice()->CreateSound(data, (int32_t)size, false);
+	osm::Sound* osmSound = m_sound->GetDataCache()->Acquire(data, size);
 	if (osmSound == nullptr)
 	{
 		return nullptr;
@@ -56,7 +56,8 @@ void SoundLoader::Unload(::Effekseer::SoundDataRef soundData)
 	{
 		m_sound->StopData(soundData);
 		SoundData* soundDataImpl = (SoundData*)soundData.Get();
-		ES_SAFE_RELEASE(soundDataImpl->osmSound);
+		m_sound->GetDataCache()->Release(soundDataImpl->osmSound);
+		soundDataImpl->osmSound = nullptr;
 	}
 }
 
@@ -41,10 +41,38 @@ SoundPlayer::~SoundPlayer()
 		return nullptr;
 	}
 
+	float volume = parameter.Volume;
+	float pan = parameter.Pan;
+
+	if (parameter.Mode3D)
+	{
+		float rolloff;
+		m_sound->Calculate3DSound(parameter.Position, parameter.Distance, rolloff, pan);
+		volume *= rolloff;
+	}
+
+	// A sound which cannot be heard is culled before a voice is started.
+	// A volume cannot be changed after playing and a sound out of the distance is silent, so it would only steal a voice.
+	if (volume <= 0.0f)
+	{
+		return nullptr;
+	}
+
+	const int32_t voiceIndex = m_sound->AcquireVoice(volume);
+	if (voiceIndex < 0)
+	{
+		return nullptr;
+	}
+
 	auto soundDataImpl = (const SoundData*)parameter.Data.Get();
 
 	auto device = m_sound->GetDevice();
 	int32_t id = device->Play((osm::Sound*)soundDataImpl->GetOsmSound());
+	if (id < 0)
+	{
+		m_sound->CancelVoice(voiceIndex);
+		return nullptr;
+	}
 
 	if (parameter.Pitch != 0.0f)
 	{
@@ -57,24 +85,10 @@ SoundPlayer::~SoundPlayer()
 		device->SetPlaybackSpeed(id, 1.0f);
 	}
 
-	if (parameter.Mode3D)
-	{
-		float rolloff, pan;
-		m_sound->Calculate3DSound(parameter.Position, parameter.Distance, rolloff, pan);
-		device->SetVolume(id, rolloff * parameter.Volume);
-		device->SetPanningPosition(id, pan);
-	}
-	else
-	{
-		device->SetVolume(id, parameter.Volume);
-		device->SetPanningPosition(id, parameter.Pan);
-	}
+	device->SetVolume(id, volume);
+	device->SetPanningPosition(id, pan);
 
-	SoundImplemented::Instance instance;
-	instance.id = id;
-	instance.tag = tag;
-	instance.data = parameter.Data;
-	m_sound->AddInstance(instance);
+	m_sound->StartVoice(voiceIndex, id, tag, parameter.Data);
 
 	return reinterpret_cast<Effekseer::SoundHandle>(static_cast<int64_t>(id));
 }
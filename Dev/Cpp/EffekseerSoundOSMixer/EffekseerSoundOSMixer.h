@@ -96,12 +96,13 @@ protected:
 public:
 	/**
 		@brief	インスタンスを生成する。
-		@param	device	[in]	OSMixerのデバイス
-		@param	voiceCount1ch	[in]	モノラルボイス数
-		@param	voiceCount2ch	[in]	ステレオボイス数
+		@param	soundManager	[in]	OSMixerのデバイス
+		@param	voiceCount	[in]	同時に再生できるボイス数
 		@return	インスタンス
+		@note
+		ボイスは生成時に確保される。全てのボイスが使用中の場合、最も音量の小さいボイスが停止される。
 	*/
-	static SoundRef Create(osm::Manager* soundManager);
+	static SoundRef Create(osm::Manager* soundManager, int32_t voiceCount = 64);
 
 	/**
 		@brief	このインスタンスを破棄する。
@@ -134,6 +135,20 @@ public:
 		@brief	ミュート設定
 	*/
 	virtual void SetMute(bool mute) = 0;
+
+	/**
+		@brief	サウンドデータのキャッシュが保持できるバイト数を設定する。
+		@note
+		同じ内容のサウンドデータは共有される。使用されていないサウンドデータは超過した場合に古い順に破棄される。
+	*/
+	virtual void SetCacheBudget(size_t bytes) = 0;
+
+	/**
+		@brief	再生中にデコードするサウンドデータのデコード後のバイト数の閾値を設定する。
+		@note
+		閾値以下のサウンドデータは読み込み時にデコードされる。
+	*/
+	virtual void SetStreamingThreshold(size_t bytes) = 0;
 };
 
 //----------------------------------------------------------------------------------
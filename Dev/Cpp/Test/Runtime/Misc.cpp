@@ -1,4 +1,11 @@
+#include "Effekseer/Effekseer.Random.h"
 #include "Effekseer/Geometry/GeometryUtility.h"
+#include "Effekseer/Model/Model.h"
+#include "Effekseer/Utils/Effekseer.LockFreeQueue.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
 
 #include "../TestHelper.h"
 
@@ -259,3 +266,135 @@ void TestGeometryUtility()
 }
 
 TestRegister Misc_TestGeometryUtility("Misc.TestGeometryUtility", []() -> void { TestGeometryUtility(); });
+
+void TestLockFreeQueue()
+{
+	Effekseer::LockFreeQueue<int32_t> queue(8);
+
+	int32_t value = 0;
+	EXPECT_TRUE(queue.IsEmpty());
+	EXPECT_TRUE(!queue.TryPop(value));
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		EXPECT_TRUE(queue.TryPush(i));
+	}
+	EXPECT_TRUE(!queue.TryPush(8));
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		EXPECT_TRUE(queue.TryPop(value));
+		EXPECT_TRUE(value == i);
+	}
+	EXPECT_TRUE(queue.IsEmpty());
+
+	// push from multiple threads
+	const int32_t threadCount = 4;
+	const int32_t countPerThread = 1000;
+	Effekseer::LockFreeQueue<int32_t> sharedQueue(8192);
+
+	std::vector<std::thread> threads;
+	for (int32_t t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&sharedQueue, t]() {
+			for (int32_t i = 0; i < countPerThread; i++)
+			{
+				sharedQueue.TryPush(t * countPerThread + i);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::vector<bool> popped(threadCount * countPerThread, false);
+	while (sharedQueue.TryPop(value))
+	{
+		EXPECT_TRUE(!popped[value]);
+		popped[value] = true;
+	}
+
+	EXPECT_TRUE(std::all_of(popped.begin(), popped.end(), [](bool v) { return v; }));
+}
+
+TestRegister Misc_TestLockFreeQueue("Misc.TestLockFreeQueue", []() -> void { TestLockFreeQueue(); });
+
+void TestModelEmitterDistribution()
+{
+	// faces whose areas are 2, 0.125 and 0.875
+	Effekseer::CustomVector<Effekseer::Model::Vertex> vertexes(9);
+	vertexes[0].Position = {0.0f, 0.0f, 0.0f};
+	vertexes[1].Position = {2.0f, 0.0f, 0.0f};
+	vertexes[2].Position = {0.0f, 2.0f, 0.0f};
+	vertexes[3].Position = {10.0f, 0.0f, 0.0f};
+	vertexes[4].Position = {10.5f, 0.0f, 0.0f};
+	vertexes[5].Position = {10.0f, 0.5f, 0.0f};
+	vertexes[6].Position = {20.0f, 0.0f, 0.0f};
+	vertexes[7].Position = {21.75f, 0.0f, 0.0f};
+	vertexes[8].Position = {20.0f, 1.0f, 0.0f};
+
+	Effekseer::CustomVector<Effekseer::Model::Face> faces(3);
+	faces[0].Indexes = {0, 1, 2};
+	faces[1].Indexes = {3, 4, 5};
+	faces[2].Indexes = {6, 7, 8};
+
+	const std::array<float, 3> expected = {2.0f / 3.0f, 0.125f / 3.0f, 0.875f / 3.0f};
+	const auto getFaceIndex = [](const Effekseer::Model::Emitter& emitter) { return emitter.Position.X < 5.0f ? 0 : (emitter.Position.X < 15.0f ? 1 : 2); };
+
+	Effekseer::Model model(vertexes, faces);
+	Effekseer::RandObject rand;
+	rand.SetSeed(1);
+
+	const int32_t count = 100000;
+	std::vector<Effekseer::Model::Emitter> emitters(count);
+	model.GetEmitters(&rand, 0, Effekseer::CoordinateSystem::RH, 1.0f, emitters.data(), count);
+
+	std::array<int32_t, 3> counts = {};
+	for (const auto& emitter : emitters)
+	{
+		counts[getFaceIndex(emitter)]++;
+	}
+
+	for (size_t i = 0; i < counts.size(); i++)
+	{
+		EXPECT_TRUE(std::abs(static_cast<float>(counts[i]) / count - expected[i]) < 0.01f);
+	}
+
+	// samplers are generated when emitters are got from multiple threads first
+	Effekseer::Model sharedModel(vertexes, faces);
+	const int32_t threadCount = 4;
+	std::vector<std::array<int32_t, 3>> threadCounts(threadCount);
+
+	std::vector<std::thread> threads;
+	for (int32_t t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&, t]() {
+			Effekseer::RandObject threadRand;
+			threadRand.SetSeed(t + 1);
+			threadCounts[t] = {};
+			for (int32_t i = 0; i < count / threadCount; i++)
+			{
+				threadCounts[t][getFaceIndex(sharedModel.GetEmitter(&threadRand, 0, Effekseer::CoordinateSystem::RH, 1.0f))]++;
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		int32_t sum = 0;
+		for (const auto& c : threadCounts)
+		{
+			sum += c[i];
+		}
+		EXPECT_TRUE(std::abs(static_cast<float>(sum) / count - expected[i]) < 0.01f);
+	}
+}
+
+TestRegister Misc_TestModelEmitterDistribution("Misc.TestModelEmitterDistribution", []() -> void { TestModelEmitterDistribution(); });
@@ -223,6 +223,24 @@ void ResourceManager_Basic()
 		{
 			throw std::string("Failed.");
 		}
+
+		Effekseer::CustomUnorderedMap<Effekseer::ProceduralModelParameter, int, Effekseer::ProceduralModelParameter::Hash> um;
+
+		for (const auto& param : params)
+		{
+			um[param] = 0;
+		}
+
+		if (params.size() != um.size())
+		{
+			throw std::string("Failed.");
+		}
+
+		auto copied = params[0];
+		if (copied.CalculateHash() != params[0].CalculateHash() || !(copied == params[0]))
+		{
+			throw std::string("Failed.");
+		}
 	}
 }
 
@@ -18,9 +18,15 @@
 #endif
 
 #include "../Effekseer/Effekseer/Effekseer.Base.h"
+#include "../Effekseer/Effekseer/Effekseer.EffectBatchLoader.h"
+#include "../Effekseer/Effekseer/IO/Effekseer.EfkRuntimeFactory.h"
 #include "../Effekseer/Effekseer/Noise/CurlNoise.h"
 #include "../TestHelper.h"
+#include <atomic>
 #include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
 
 void BasicRuntimeDeviceLostTest()
 {
@@ -592,6 +598,178 @@ void DX11DefferedContextTest()
 #endif
 }
 
+void RuntimeFormatTest()
+{
+	auto manager = Effekseer::Manager::Create(1000);
+
+	auto effectData = LoadFile((GetDirectoryPathAsU16(__FILE__) + u"../../../../TestData/Effects/10/SimpleLaser.efk").c_str());
+
+	std::vector<uint8_t> cooked;
+	EXPECT_TRUE(Effekseer::EfkRuntimeFile::Cook(cooked, effectData.data(), static_cast<int32_t>(effectData.size()), 2.0f));
+
+	auto original = Effekseer::Effect::Create(manager, effectData.data(), static_cast<int32_t>(effectData.size()));
+	auto loaded = Effekseer::Effect::Create(manager, cooked.data(), static_cast<int32_t>(cooked.size()));
+	EXPECT_TRUE(original != nullptr);
+	EXPECT_TRUE(loaded != nullptr);
+	EXPECT_TRUE(original->GetVersion() == loaded->GetVersion());
+	EXPECT_TRUE(original->GetMaginification() * 2.0f == loaded->GetMaginification());
+
+	EXPECT_TRUE(Effekseer::EfkRuntimeFile(cooked.data(), static_cast<int32_t>(cooked.size())).VerifyBodyHash());
+
+	// a broken body is found by the hash which the cooker writes
+	cooked.back() ^= 1;
+	EXPECT_TRUE(!Effekseer::EfkRuntimeFile(cooked.data(), static_cast<int32_t>(cooked.size())).VerifyBodyHash());
+
+	// truncated data must be rejected
+	cooked.pop_back();
+	EXPECT_TRUE(Effekseer::Effect::Create(manager, cooked.data(), static_cast<int32_t>(cooked.size())) == nullptr);
+}
+
+void EffectBatchLoaderTest()
+{
+	class CountingTextureLoader : public Effekseer::TextureLoader
+	{
+		bool isThreadSafe_ = false;
+
+	public:
+		std::atomic<int32_t> PathLoadCount;
+		std::atomic<int32_t> DataLoadCount;
+		std::mutex ThreadIDMutex;
+		std::set<std::thread::id> ThreadIDs;
+
+		CountingTextureLoader(bool isThreadSafe)
+			: isThreadSafe_(isThreadSafe)
+			, PathLoadCount(0)
+			, DataLoadCount(0)
+		{
+		}
+
+		Effekseer::TextureRef Load(const char16_t* path, Effekseer::TextureType textureType) override
+		{
+			PathLoadCount++;
+			return Effekseer::MakeRefPtr<Effekseer::Texture>();
+		}
+
+		Effekseer::TextureRef Load(const void* data, int32_t size, Effekseer::TextureType textureType, bool isMipMapEnabled) override
+		{
+			DataLoadCount++;
+			std::lock_guard<std::mutex> lock(ThreadIDMutex);
+			ThreadIDs.insert(std::this_thread::get_id());
+			return Effekseer::MakeRefPtr<Effekseer::Texture>();
+		}
+
+		bool GetIsThreadSafe() const override
+		{
+			return isThreadSafe_;
+		}
+	};
+
+	const auto path = GetDirectoryPathAsU16(__FILE__) + u"../../../../TestData/Effects/10/SimpleLaser.efk";
+
+	for (const auto isThreadSafe : {false, true})
+	{
+		auto manager = Effekseer::Manager::Create(1000);
+		auto textureLoader = Effekseer::MakeRefPtr<CountingTextureLoader>(isThreadSafe);
+		manager->SetTextureLoader(textureLoader);
+
+		int32_t lastFinishedCount = 0;
+		Effekseer::EffectBatchLoader loader(manager, 4);
+		loader.SetProgressCallback([&](int32_t finishedCount, int32_t totalCount) {
+			EXPECT_TRUE(finishedCount >= lastFinishedCount);
+			EXPECT_TRUE(finishedCount <= totalCount);
+			lastFinishedCount = finishedCount;
+		});
+
+		const auto effects = loader.Load({path, path, u"NotFound.efk"});
+		EXPECT_TRUE(effects.size() == 3);
+		EXPECT_TRUE(effects[2] == nullptr);
+
+		// each effect is same as an effect which is loaded as usual
+		auto referenceManager = Effekseer::Manager::Create(1000);
+		referenceManager->SetTextureLoader(Effekseer::MakeRefPtr<CountingTextureLoader>(false));
+		auto reference = Effekseer::Effect::Create(referenceManager, path.c_str());
+		EXPECT_TRUE(reference != nullptr);
+
+		std::set<Effekseer::Texture*> textures;
+
+		for (size_t e = 0; e < 2; e++)
+		{
+			const auto& effect = effects[e];
+			EXPECT_TRUE(effect != nullptr);
+			EXPECT_TRUE(effect->GetVersion() == reference->GetVersion());
+			EXPECT_TRUE(effect->GetColorImageCount() == reference->GetColorImageCount());
+			EXPECT_TRUE(effect->GetNormalImageCount() == reference->GetNormalImageCount());
+			EXPECT_TRUE(effect->GetDistortionImageCount() == reference->GetDistortionImageCount());
+			EXPECT_TRUE(effect->GetModelCount() == reference->GetModelCount());
+			EXPECT_TRUE(effect->GetCurveCount() == reference->GetCurveCount());
+
+			for (int32_t i = 0; i < effect->GetColorImageCount(); i++)
+			{
+				EXPECT_TRUE(std::u16string(effect->GetColorImagePath(i)) == reference->GetColorImagePath(i));
+				EXPECT_TRUE((effect->GetColorImage(i) != nullptr) == (reference->GetColorImage(i) != nullptr));
+
+				// shared textures are shared between effects
+				EXPECT_TRUE(effect->GetColorImage(i) == effects[0]->GetColorImage(i));
+				textures.insert(effect->GetColorImage(i).Get());
+			}
+
+			for (int32_t i = 0; i < effect->GetNormalImageCount(); i++)
+			{
+				textures.insert(effect->GetNormalImage(i).Get());
+			}
+
+			for (int32_t i = 0; i < effect->GetDistortionImageCount(); i++)
+			{
+				textures.insert(effect->GetDistortionImage(i).Get());
+			}
+		}
+
+		// each shared texture is read and created once
+		textures.erase(nullptr);
+		EXPECT_TRUE(textureLoader->PathLoadCount == 0);
+		EXPECT_TRUE(textureLoader->DataLoadCount == static_cast<int32_t>(textures.size()));
+
+		// a loader which is not thread safe is called only on the calling thread
+		if (!isThreadSafe)
+		{
+			EXPECT_TRUE(textureLoader->ThreadIDs.size() <= 1);
+			EXPECT_TRUE(textureLoader->ThreadIDs.empty() || *textureLoader->ThreadIDs.begin() == std::this_thread::get_id());
+		}
+	}
+}
+
+void InstancedEffectTest()
+{
+	auto manager = Effekseer::Manager::Create(8000);
+	auto effect = Effekseer::Effect::Create(manager, (GetDirectoryPathAsU16(__FILE__) + u"../../../../TestData/Effects/10/SimpleLaser.efk").c_str());
+	EXPECT_TRUE(effect != nullptr);
+
+	for (int32_t i = 0; i < 100; i++)
+	{
+		Effekseer::Matrix43 transform;
+		transform.Translation(static_cast<float>(i), 0.0f, 0.0f);
+		manager->PlayInstanced(effect, transform);
+	}
+	EXPECT_TRUE(manager->GetInstancedEffectCount() == 100);
+
+	manager->Update();
+	EXPECT_TRUE(manager->GetTotalInstanceCount() > 0);
+
+	// instanced effects are removed automatically
+	for (int32_t i = 0; i < 1000 && manager->GetInstancedEffectCount() > 0; i++)
+	{
+		manager->Update();
+	}
+	EXPECT_TRUE(manager->GetInstancedEffectCount() == 0);
+	EXPECT_TRUE(manager->GetTotalInstanceCount() == 0);
+
+	manager->PlayInstanced(effect, Effekseer::Matrix43());
+	manager->Update();
+	manager->StopAllEffects();
+	manager->Update();
+	EXPECT_TRUE(manager->GetInstancedEffectCount() == 0);
+}
+
 void ProceduralModelCacheTest()
 {
 #ifdef _WIN32
@@ -947,6 +1125,12 @@ TestRegister Runtime_DX11DefferedContextTest("Runtime.DX11DefferedContextTest",
 
 TestRegister Runtime_BasicRuntimeDeviceLostTest("Runtime.BasicRuntimeDeviceLostTest", []() -> void { BasicRuntimeDeviceLostTest(); });
 
+TestRegister Runtime_RuntimeFormatTest("Runtime.RuntimeFormatTest", []() -> void { RuntimeFormatTest(); });
+
+TestRegister Runtime_EffectBatchLoaderTest("Runtime.EffectBatchLoaderTest", []() -> void { EffectBatchLoaderTest(); });
+
+TestRegister Runtime_InstancedEffectTest("Runtime.InstancedEffectTest", []() -> void { InstancedEffectTest(); });
+
 TestRegister Runtime_ProceduralModelCacheTest("Runtime.ProceduralModelCacheTest", []() -> void { ProceduralModelCacheTest(); });
 
 TestRegister Runtime_CullingTest("Runtime.CullingTest", []() -> void { CullingTest(); });
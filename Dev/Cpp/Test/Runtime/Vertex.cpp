@@ -1,6 +1,8 @@
 #include "../../EffekseerRendererCommon/EffekseerRenderer.CommonUtils.h"
 
 #include "../TestHelper.h"
+#include <cmath>
+#include <limits>
 
 namespace EffekseerRenderer
 {
@@ -69,3 +71,76 @@ void VertexTest()
 	VertexTest<EffekseerRenderer::DynamicVertex>(false);
 }
 TestRegister Runtime_VertexTest("Runtime.Vertex", []() -> void { VertexTest(); });
+
+void HalfFloatTest()
+{
+	const auto pack = [](float value) -> uint16_t { return EffekseerRenderer::PackHalfFloat(value); };
+	const auto unpack = [](uint16_t value) -> float { return EffekseerRenderer::UnpackHalfFloat(value); };
+
+	// all values except NaN are kept in a round trip
+	for (uint32_t i = 0; i <= 0xFFFF; i++)
+	{
+		const auto half = static_cast<uint16_t>(i);
+		const auto isNaN = (half & 0x7C00) == 0x7C00 && (half & 0x3FF) != 0;
+		if (isNaN)
+		{
+			EXPECT_TRUE(std::isnan(unpack(half)));
+			continue;
+		}
+
+		EXPECT_TRUE(pack(unpack(half)) == half);
+	}
+
+	EXPECT_TRUE(pack(0.0f) == 0x0000);
+	EXPECT_TRUE(pack(-0.0f) == 0x8000);
+	EXPECT_TRUE(pack(1.0f) == 0x3C00);
+	EXPECT_TRUE(pack(-2.0f) == 0xC000);
+	EXPECT_TRUE(pack(65504.0f) == 0x7BFF);
+
+	// denormals
+	EXPECT_TRUE(pack(ldexpf(1.0f, -24)) == 0x0001);
+	EXPECT_TRUE(pack(ldexpf(1.0f, -15)) == 0x0200);
+	EXPECT_TRUE(pack(ldexpf(1.0f, -14)) == 0x0400);
+	EXPECT_TRUE(pack(ldexpf(1.5f, -25)) == 0x0001);
+	EXPECT_TRUE(pack(ldexpf(1.0f, -26)) == 0x0000);
+	EXPECT_TRUE(pack(-ldexpf(1.0f, -24)) == 0x8001);
+	EXPECT_TRUE(unpack(0x0001) == ldexpf(1.0f, -24));
+	EXPECT_TRUE(unpack(0x03FF) == ldexpf(1023.0f, -24));
+
+	// infinity and overflow
+	EXPECT_TRUE(pack(std::numeric_limits<float>::infinity()) == 0x7C00);
+	EXPECT_TRUE(pack(-std::numeric_limits<float>::infinity()) == 0xFC00);
+	EXPECT_TRUE(pack(1.0e6f) == 0x7C00);
+	EXPECT_TRUE(pack(65520.0f) == 0x7C00);
+	EXPECT_TRUE(std::isnan(unpack(pack(std::numeric_limits<float>::quiet_NaN()))));
+	EXPECT_TRUE(unpack(0x7C00) == std::numeric_limits<float>::infinity());
+
+	// round to nearest
+	EXPECT_TRUE(pack(1.0f + ldexpf(1.0f, -12)) == 0x3C00);
+	EXPECT_TRUE(pack(1.0f + ldexpf(1.0f, -11) + ldexpf(1.0f, -13)) == 0x3C01);
+	EXPECT_TRUE(pack(2047.9f) == 0x6800);
+	EXPECT_TRUE(pack(65519.0f) == 0x7BFF);
+
+	// ties are rounded to even
+	EXPECT_TRUE(pack(1.0f + ldexpf(1.0f, -11)) == 0x3C00);
+	EXPECT_TRUE(pack(1.0f + ldexpf(3.0f, -11)) == 0x3C02);
+	EXPECT_TRUE(pack(-1.0f - ldexpf(1.0f, -11)) == 0xBC00);
+	EXPECT_TRUE(pack(ldexpf(1.0f, -25)) == 0x0000);
+	EXPECT_TRUE(pack(ldexpf(3.0f, -25)) == 0x0002);
+	EXPECT_TRUE(pack(ldexpf(1023.5f, -24)) == 0x0400);
+	EXPECT_TRUE(pack(ldexpf(1022.5f, -24)) == 0x03FE);
+
+	// padding is read by a shader with AlphaThreshold
+	EffekseerRenderer::CompactAdvancedSimpleVertex simpleVertex;
+	memset(&simpleVertex, 0xFF, sizeof(simpleVertex));
+	simpleVertex.SetAlphaThreshold(0.5f);
+	EXPECT_TRUE(simpleVertex.Padding == 0);
+	EXPECT_TRUE(simpleVertex.AlphaThreshold == 0.5f);
+
+	EffekseerRenderer::CompactAdvancedLightingVertex lightingVertex;
+	memset(&lightingVertex, 0xFF, sizeof(lightingVertex));
+	lightingVertex.SetAlphaThreshold(0.5f);
+	EXPECT_TRUE(lightingVertex.Padding == 0);
+	EXPECT_TRUE(lightingVertex.AlphaThreshold == 0.5f);
+}
+TestRegister Runtime_HalfFloatTest("Runtime.HalfFloat", []() -> void { HalfFloatTest(); });